@@ -0,0 +1,129 @@
+#include <pgp-packet/eddsa_batch_verifier.h>
+#include <pgp-packet/eddsa_signature.h>
+#include <pgp-packet/eddsa_signature_verifier.h>
+#include <sodium.h>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+    /**
+     *  A signature over a random digest
+     */
+    struct signed_digest
+    {
+        const pgp::eddsa_public_key    *key;        // the key that made the signature
+        pgp::eddsa_signature            signature;  // the signature itself
+        std::array<uint8_t, 32>         digest;     // the signed digest
+    };
+
+    /**
+     *  Create a public key and its secret key
+     *
+     *  @param  seckey  The buffer to store the secret key in
+     *  @return The generated public key
+     */
+    pgp::eddsa_public_key generate_key(std::array<uint8_t, crypto_sign_SECRETKEYBYTES> &seckey)
+    {
+        // generate the key pair, the public key is prefixed with a tag byte
+        std::array<uint8_t, crypto_sign_PUBLICKEYBYTES + 1> Q{ 0x40 };
+        crypto_sign_keypair(Q.data() + 1, seckey.data());
+
+        return pgp::eddsa_public_key{ pgp::curve_oid::ed25519(), pgp::multiprecision_integer{ Q } };
+    }
+
+    /**
+     *  Measure the verification throughput
+     *
+     *  @param  name        The name to report
+     *  @param  count       The number of signatures verified per round
+     *  @param  verify      Callable verifying the signatures once
+     */
+    template <class callable_t>
+    void measure(const char *name, size_t count, callable_t &&verify)
+    {
+        // the number of rounds to run
+        constexpr size_t rounds = 10;
+
+        // run the verification many times
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < rounds; ++i) {
+            verify();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        // report the throughput
+        std::printf("%-24s %10.0f signatures/s\n", name, static_cast<double>(count * rounds) / elapsed.count());
+    }
+
+}
+
+int main()
+{
+    // initialize libsodium
+    if (sodium_init() == -1) {
+        return 1;
+    }
+
+    // the number of signatures to verify
+    constexpr size_t count = 4096;
+
+    // a keyring with a few keys, and a keyring where every signature has its own key
+    for (size_t keys : { size_t{ 16 }, count }) {
+        // generate the keys
+        std::vector<pgp::eddsa_public_key>                              public_keys;
+        std::vector<std::array<uint8_t, crypto_sign_SECRETKEYBYTES>>    secret_keys(keys);
+        for (auto &seckey : secret_keys) {
+            public_keys.push_back(generate_key(seckey));
+        }
+
+        // create the signatures
+        std::vector<signed_digest> signatures;
+        for (size_t i = 0; i < count; ++i) {
+            // sign a random digest
+            std::array<uint8_t, 32> digest;
+            std::array<uint8_t, crypto_sign_BYTES> data;
+            randombytes_buf(digest.data(), digest.size());
+            crypto_sign_detached(data.data(), nullptr, digest.data(), digest.size(), secret_keys[i % keys].data());
+
+            // and store it
+            signatures.push_back(signed_digest{
+                &public_keys[i % keys],
+                pgp::eddsa_signature{
+                    pgp::multiprecision_integer{ pgp::span<const uint8_t>{ data.data(), 32 } },
+                    pgp::multiprecision_integer{ pgp::span<const uint8_t>{ data.data() + 32, 32 } }
+                },
+                digest
+            });
+        }
+
+        std::printf("%zu signatures by %zu keys\n", count, keys);
+
+        // verify them one by one
+        size_t valid = 0;
+        measure("single", count, [&signatures, &valid]() {
+            for (auto &current : signatures) {
+                pgp::eddsa_signature_verifier verifier{ *current.key };
+                valid += verifier.verify(current.signature, pgp::hash_algorithm::sha256, current.digest);
+            }
+        });
+
+        // and all at once
+        measure("batch", count, [&signatures, &valid]() {
+            pgp::eddsa_batch_verifier verifier;
+            for (auto &current : signatures) {
+                verifier.add(*current.key, current.signature, current.digest);
+            }
+            for (bool result : verifier.verify()) {
+                valid += result;
+            }
+        });
+
+        // prevent the work from being optimized out
+        std::printf("%zu valid\n\n", valid);
+    }
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include <pgp-packet/packet.h>
+#include <pgp-packet/range_encoder.h>
+#include <pgp-packet/hash_encoder.h>
+#include <cryptopp/sha.h>
+#include <sodium.h>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+    /**
+     *  Create a multiprecision integer holding random data
+     *
+     *  @param  size    The number of bytes in the integer
+     *  @return The generated integer
+     */
+    pgp::multiprecision_integer random_integer(size_t size)
+    {
+        // fill a buffer with random data
+        std::vector<uint8_t> data(size);
+        randombytes_buf(data.data(), data.size());
+
+        // make sure the leading byte is not zero
+        data[0] |= 0x80;
+        return pgp::multiprecision_integer{ std::move(data) };
+    }
+
+    /**
+     *  Measure the encoding throughput of an encoder
+     *
+     *  @param  name        The name to report
+     *  @param  size        The encoded size of the packets
+     *  @param  encode      Callable encoding the packets once
+     */
+    template <class callable_t>
+    void measure(const char *name, size_t size, callable_t &&encode)
+    {
+        // the number of rounds to run
+        constexpr size_t rounds = 20000;
+
+        // run the encoder many times
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < rounds; ++i) {
+            encode();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        // report the throughput
+        std::printf("%-16s %10.1f MB/s\n", name, static_cast<double>(size * rounds) / elapsed.count() / 1e6);
+    }
+
+}
+
+int main()
+{
+    // initialize libsodium
+    if (sodium_init() == -1) {
+        return 1;
+    }
+
+    // a key with a 4096-bit modulus, which is mostly mpi data
+    pgp::packet rsa_key{
+        pgp::in_place_type_t<pgp::public_key>{},
+        0,
+        pgp::key_algorithm::rsa_encrypt_or_sign,
+        pgp::in_place_type_t<pgp::public_key::rsa_key_t>{},
+        random_integer(512),
+        random_integer(3)
+    };
+
+    // an ecdh key, which holds a curve oid
+    pgp::packet ecdh_key{
+        pgp::in_place_type_t<pgp::public_key>{},
+        0,
+        pgp::key_algorithm::ecdh,
+        pgp::in_place_type_t<pgp::public_key::ecdh_key_t>{},
+        pgp::curve_oid::curve_25519(),
+        random_integer(33),
+        pgp::hash_algorithm::sha256,
+        pgp::symmetric_key_algorithm::aes128
+    };
+
+    // a signature with a large unknown subpacket, such as a notation
+    std::vector<uint8_t> notation(1024, 0x61);
+    pgp::packet signature{
+        pgp::in_place_type_t<pgp::signature>{},
+        pgp::signature_type::generic_user_id_and_public_key_certification,
+        pgp::key_algorithm::rsa_encrypt_or_sign,
+        pgp::hash_algorithm::sha256,
+        pgp::signature_subpacket_set{{
+            pgp::signature_subpacket::unknown{ pgp::signature_subpacket_type::notation_data, notation }
+        }},
+        pgp::signature_subpacket_set{},
+        0,
+        pgp::in_place_type_t<pgp::rsa_signature>{},
+        random_integer(512)
+    };
+
+    // determine the total encoded size
+    std::vector<pgp::packet> packets{ rsa_key, ecdh_key, signature };
+    size_t size = 0;
+    for (auto &packet : packets) {
+        size += packet.size();
+    }
+
+    // the hasher only processes the packet bodies
+    size_t body_size = 0;
+    for (auto &packet : packets) {
+        pgp::visit([&body_size](auto &body) { body_size += body.size(); }, packet.body());
+    }
+
+    // the buffer to encode into
+    std::vector<uint8_t> buffer(size);
+
+    measure("range_encoder", size, [&]() {
+        pgp::range_encoder encoder{ buffer };
+        for (auto &packet : packets) {
+            packet.encode(encoder);
+        }
+    });
+
+    measure("hash_encoder", body_size, [&]() {
+        pgp::hash_encoder<CryptoPP::SHA256> encoder;
+        for (auto &packet : packets) {
+            pgp::visit([&encoder](auto &body) { body.encode(encoder); }, packet.body());
+        }
+        encoder.digest();
+    });
+
+    return 0;
+}
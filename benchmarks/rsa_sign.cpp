@@ -0,0 +1,96 @@
+#include <pgp-packet/rsa_signature.h>
+#include <pgp-packet/secret_key.h>
+#include <cryptopp/osrng.h>
+#include <cryptopp/rsa.h>
+#include <sodium.h>
+#include <array>
+#include <chrono>
+#include <cstdio>
+
+namespace {
+
+    /**
+     *  Create a secret key from a Crypto++ key
+     *
+     *  @param  key     The Crypto++ key to convert
+     *  @param  crt     Whether the primes are stored so that the CRT can be used
+     *  @return The converted key
+     */
+    pgp::secret_key convert_key(const CryptoPP::RSA::PrivateKey &key, bool crt)
+    {
+        // Crypto++ stores the inverse of its second prime, while OpenPGP stores
+        // the inverse of p, so storing them in the Crypto++ order breaks the CRT
+        auto &p = crt ? key.GetPrime2() : key.GetPrime1();
+        auto &q = crt ? key.GetPrime1() : key.GetPrime2();
+
+        return pgp::secret_key{
+            1554106568,
+            pgp::key_algorithm::rsa_encrypt_or_sign,
+            pgp::in_place_type_t<pgp::secret_key::rsa_key_t>{},
+            std::make_tuple(
+                pgp::multiprecision_integer{ key.GetModulus() },
+                pgp::multiprecision_integer{ key.GetPublicExponent() }
+            ),
+            std::make_tuple(
+                pgp::secret_multiprecision_integer{ key.GetPrivateExponent() },
+                pgp::secret_multiprecision_integer{ p },
+                pgp::secret_multiprecision_integer{ q },
+                pgp::secret_multiprecision_integer{ key.GetMultiplicativeInverseOfPrime2ModPrime1() }
+            )
+        };
+    }
+
+    /**
+     *  Measure the signing throughput for a key
+     *
+     *  @param  name    The name to report
+     *  @param  key     The key to sign with
+     */
+    void measure(const char *name, const pgp::secret_key &key)
+    {
+        // the number of signatures to make
+        constexpr size_t rounds = 100;
+
+        // the data to sign
+        std::array<uint8_t, 64> message;
+        randombytes_buf(message.data(), message.size());
+
+        // make the signatures
+        size_t size = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < rounds; ++i) {
+            // sign the message
+            pgp::rsa_signature::encoder_t encoder{ key };
+            encoder.insert_blob(pgp::span<const uint8_t>{ message });
+            size += std::get<0>(encoder.finalize()).size();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        // report the throughput
+        std::printf("%-24s %10.1f signatures/s (%zu bytes)\n", name, rounds / elapsed.count(), size);
+    }
+
+}
+
+int main()
+{
+    // initialize libsodium
+    if (sodium_init() == -1) {
+        return 1;
+    }
+
+    CryptoPP::AutoSeededRandomPool prng;
+
+    // compare both ways of signing for common key sizes
+    for (unsigned int bits : { 2048u, 4096u }) {
+        // generate the key
+        CryptoPP::RSA::PrivateKey key;
+        key.GenerateRandomWithKeySize(prng, bits);
+
+        std::printf("RSA-%u\n", bits);
+        measure("full exponent", convert_key(key, false));
+        measure("crt", convert_key(key, true));
+    }
+
+    return 0;
+}
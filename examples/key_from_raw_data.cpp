@@ -1,4 +1,5 @@
 #include <pgp-packet/packet.h>
+#include <pgp-packet/sink_encoder.h>
 #include <ctime>
 #include <iostream>
 #include <fstream>
@@ -52,10 +53,10 @@ int main()
         pgp::in_place_type_t<pgp::secret_key::eddsa_key_t>{},           // create a key of the eddsa type
         std::forward_as_tuple(                                          // arguments for the public key
             pgp::curve_oid::ed25519(),                                  // which curve to use
-            pgp::multiprecision_integer{ std::move(public_key_data) }   // move in the public key point
+            pgp::multiprecision_integer{ public_key_data }              // copy in the public key point
         ),
         std::forward_as_tuple(                                          // secret arguments
-            pgp::multiprecision_integer{ std::move(secret_key_data) }   // copy in the secret key point
+            pgp::secret_multiprecision_integer{ std::move(secret_key_data) }    // move in the secret key point
         )
     };
 
@@ -94,24 +95,16 @@ int main()
 
     // we now have a set of packets, which, when encoded to a file, can
     // be imported into a compatible pgp implementation (such as gnupg)
-    pgp::vector<uint8_t> data;
-    data.resize(
-        secret_key_packet   .size() +
-        user_id_packet      .size() +
-        signature_packet    .size()
-    );
+    std::ofstream       output{ "keyfile" };
+    pgp::sink_encoder   encoder{ output };
 
-    // create an encoder writing in the vectors range
-    pgp::range_encoder encoder{ data };
-
-    // encode all the packets into the encoder
+    // encode all the packets straight into the file
     secret_key_packet   .encode(encoder);
     user_id_packet      .encode(encoder);
     signature_packet    .encode(encoder);
 
-    // the encoder has now filled the vector with data, which can be written
-    std::ofstream   output{ "keyfile" };
-    output.write(reinterpret_cast<const char*>(data.data()), data.size());
+    // write out whatever is still buffered in the encoder
+    encoder.flush();
 
     return 0;
 }
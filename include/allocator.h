@@ -1,8 +1,11 @@
 #pragma once
 
 #include <sodium/utils.h>
+#include <cstdint>
+#include <limits>
 #include <type_traits>
 #include <new>
+#include "secure_arena.h"
 
 
 namespace pgp {
@@ -10,8 +13,13 @@ namespace pgp {
     /**
      *  Class for securely allocating and deallocating
      *  memory. Memory is prevented from being paged out
-     *  and guard pages are placed right before and after
-     *  the allocated memory to detect invalid access.
+     *  and is wiped before it is released.
+     *
+     *  Small allocations are served from the shared secure
+     *  arena, which locks memory in large regions. Larger
+     *  allocations, or those exceeding the arena budget,
+     *  get guard pages placed right before and after the
+     *  allocated memory to detect invalid access.
      */
     template <typename T>
     class allocator
@@ -29,11 +37,21 @@ namespace pgp {
              */
             allocator() = default;
 
+            /**
+             *  Constructor
+             *
+             *  Containers may rebind the allocator to another type,
+             *  all instances share the same secure memory, so there
+             *  is nothing to copy.
+             */
+            template <typename U>
+            constexpr allocator(const allocator<U> &) noexcept {}
+
             /**
              *  Allocate memory for zero or more instances
              *  of `value_type`. The instances will not be
-             *  initialized, the memory is initialized with
-             *  0xdb for security reasons.
+             *  initialized, the memory is either zero-filled
+             *  or initialized with 0xdb for security reasons.
              *
              *  @param  count   Number of elements to allocate memory for
              *  @return Pointer to the allocated memory
@@ -41,7 +59,19 @@ namespace pgp {
              */
             pointer allocate(size_t count)
             {
-                // allocate secure memory
+                // an aligned buffer capable of holding one instance of value_type
+                using aligned_t = std::aligned_storage_t<sizeof(value_type), alignof(value_type)>;
+
+                // can the arena provide memory with the right alignment?
+                if (alignof(aligned_t) <= secure_arena::alignment && count <= std::numeric_limits<size_t>::max() / sizeof(aligned_t)) {
+                    // try to allocate from the arena
+                    if (auto *result = secure_arena::instance().allocate(count * sizeof(aligned_t))) {
+                        // cast to the requested type
+                        return static_cast<pointer>(result);
+                    }
+                }
+
+                // allocate secure memory with guard pages
                 auto *result = sodium_allocarray(count, sizeof(aligned_t));
 
                 // check whether we got a valid pointer
@@ -58,14 +88,25 @@ namespace pgp {
              *  Free memory previously allocated using
              *  this allocator. Does not destroy instances.
              *
-             *  Guard pages are checked, and memory is cleared
-             *  before release. Upon failure, no exceptions are
+             *  Memory is cleared before it is used again. For
+             *  memory with guard pages, the guard pages are
+             *  checked as well. Upon failure, no exceptions are
              *  thrown, the program simply terminates.
              *
              *  @param  address The address to free
+             *  @param  count   Number of elements the memory was allocated for
              */
-            void deallocate(pointer address, size_t) noexcept
+            void deallocate(pointer address, size_t count) noexcept
             {
+                // an aligned buffer capable of holding one instance of value_type
+                using aligned_t = std::aligned_storage_t<sizeof(value_type), alignof(value_type)>;
+
+                // return the memory to the arena, if it came from there
+                if (alignof(aligned_t) <= secure_arena::alignment && secure_arena::instance().deallocate(address, count * sizeof(aligned_t))) {
+                    // the arena will wipe the memory
+                    return;
+                }
+
                 // free the memory
                 sodium_free(address);
             }
@@ -78,9 +119,6 @@ namespace pgp {
              */
             constexpr bool operator==(const allocator<T> &) noexcept { return true;  }
             constexpr bool operator!=(const allocator<T> &) noexcept { return false; }
-        private:
-            // alias for an aligned buffer capable of holding one instance of value_type
-            using aligned_t = std::aligned_storage_t<sizeof(value_type), alignof(value_type)>;
     };
 
 }
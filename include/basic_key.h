@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stdexcept>
+#include <type_traits>
 #include "packet_tag.h"
 #include "unknown_key.h"
 #include "fixed_number.h"
@@ -78,6 +80,10 @@ namespace pgp {
                     case key_algorithm::ecdsa:
                         _key.template emplace<typename key_traits::ecdsa_key_t>(parser);
                         break;
+                    default:
+                        // keep the raw data of the unknown key
+                        _key.template emplace<unknown_key>(parser);
+                        break;
                 }
             }
 
@@ -153,10 +159,15 @@ namespace pgp {
             /**
              *  Hash the key into a given hash context
              *
+             *  Only the public part of the key is hashed. For a secret
+             *  key with an unknown algorithm, we cannot tell the public
+             *  part apart from the secret material, so it is not hashed.
+             *
              *  @param  writer  The hasher to write to
+             *  @throws std::runtime_error for secret keys with an unknown algorithm
              */
             template <class encoder_t>
-            void hash(encoder_t &writer) const noexcept
+            void hash(encoder_t &writer) const
             {
                 // the magic constant to use for key fingerprints
                 static constexpr const expected_number<uint8_t, 0x99> fingerprint_magic;
@@ -183,6 +194,12 @@ namespace pgp {
 #pragma GCC diagnostic pop
 #endif
 
+                    // unknown key material may include the secret parts
+                    if constexpr (std::is_same_v<key_type_t, unknown_key> && is_secret()) {
+                        // so we cannot hash it without leaking them
+                        throw std::runtime_error{ "Cannot hash a secret key with an unknown algorithm" };
+                    }
+
                     // the size of the key data we hash
                     // note that we cast to the public key
                     uint16 size{
@@ -210,8 +227,9 @@ namespace pgp {
              *  Retrieve the fingerprint for this key
              *
              *  @return The 20-byte fingerprint
+             *  @throws std::runtime_error for secret keys with an unknown algorithm
              */
-            std::array<uint8_t, 20> fingerprint() const noexcept
+            std::array<uint8_t, 20> fingerprint() const
             {
                 // the hashing context to create the fingerprint
                 sha1_encoder    encoder;
@@ -227,8 +245,9 @@ namespace pgp {
              *  Retrieve the key ID for this key
              *
              *  @return The 8-byte key ID
+             *  @throws std::runtime_error for secret keys with an unknown algorithm
              */
-            std::array<uint8_t, 8> key_id() const noexcept
+            std::array<uint8_t, 8> key_id() const
             {
                 // obtain the fingerprint
                 std::array<uint8_t, 20> print{fingerprint()};
@@ -303,6 +322,17 @@ namespace pgp {
                 }, _key);
             }
         private:
+            /**
+             *  Check whether this is a secret key
+             *
+             *  @return Whether the key holds secret material
+             */
+            static constexpr bool is_secret() noexcept
+            {
+                // check the tag from the key traits
+                return key_traits::tag() == packet_tag::secret_key || key_traits::tag() == packet_tag::secret_subkey;
+            }
+
             expected_number<uint8_t, 4>         _version;               // the expected key version format
             uint32                              _creation_time;         // the UNIX timestamp the key was created at
             key_algorithm                       _algorithm      { 0 };  // the algorithm for creating the key
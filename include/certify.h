@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+#include "basic_key.h"
+#include "packet_tag.h"
+#include "secret_key.h"
+#include "signature.h"
+#include "signature_subpacket_set.h"
+#include "signing_context.h"
+#include "user_id.h"
+
+
+namespace pgp {
+
+    /**
+     *  Certify a number of user ids and bind a number
+     *  of subkeys with the same primary key
+     *
+     *  The key is prepared and hashed only once, every
+     *  signature starts from a copy of the hashed key.
+     *
+     *  Subkeys that can make signatures need a primary key binding
+     *  embedded in their hashed subpackets, which differs for every
+     *  subkey; these should be bound one at a time instead.
+     *
+     *  @param  key                 The primary key to sign with
+     *  @param  user_ids            The user ids to certify
+     *  @param  subkeys             The subkeys to bind
+     *  @param  user_id_subpackets  The hashed subpackets for the certifications
+     *  @param  subkey_subpackets   The hashed subpackets for the subkey bindings
+     *  @return The certifications, in the order of the user ids, followed
+     *          by the subkey bindings, in the order of the subkeys
+     *  @throws std::runtime_error for unsupported key types
+     */
+    template <class subkey_traits = secret_key_traits<packet_tag::secret_subkey>>
+    std::vector<signature> certify_all(
+        const secret_key &key,
+        const std::vector<user_id> &user_ids,
+        const std::vector<basic_key<subkey_traits>> &subkeys,
+        const signature_subpacket_set &user_id_subpackets,
+        const signature_subpacket_set &subkey_subpackets)
+    {
+        // prepare and hash the key once
+        signing_context context{ key };
+
+        // the signatures to return
+        std::vector<signature> result;
+        result.reserve(user_ids.size() + subkeys.size());
+
+        // certify all the user ids
+        for (const auto &user : user_ids) {
+            // create the certification
+            result.emplace_back(context, user, user_id_subpackets, signature_subpacket_set{});
+        }
+
+        // and bind all the subkeys
+        for (const auto &subkey : subkeys) {
+            // create the binding
+            result.emplace_back(context, subkey, subkey_subpackets, signature_subpacket_set{});
+        }
+
+        // return all the signatures
+        return result;
+    }
+
+}
@@ -1,26 +1,57 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <cstddef>
 #include <initializer_list>
 #include <type_traits>
-#include "decoder_traits.h"
 #include <vector>
+#include "decoder_traits.h"
 #include "util/span.h"
 
 
 namespace pgp {
 
+    /**
+     *  The curves with a known object identifier
+     */
+    enum class curve_id : uint8_t
+    {
+        unknown             = 0,
+        nist_p256           = 1,
+        nist_p384           = 2,
+        nist_p521           = 3,
+        brainpool_p256r1    = 4,
+        brainpool_p384r1    = 5,
+        brainpool_p512r1    = 6,
+        ed25519             = 7,
+        curve_25519         = 8
+    };
+
     /**
      *  Class representing a curve object identifier
+     *
+     *  The identifier is stored inline, padded with zeroes, so
+     *  that it does not allocate and can be compared in one go.
+     *  Identifiers of known curves are recognized when they are
+     *  created, so the curve can be retrieved without comparing.
+     *
+     *  Identifiers too long to store inline cannot belong to a
+     *  curve we know, these are kept on the heap instead.
      */
     class curve_oid
     {
         public:
+            /**
+             *  The maximum number of bytes in an identifier stored
+             *  inline, enough for all curves defined for OpenPGP
+             */
+            static constexpr size_t inline_size = 16;
+
             /**
              *  Constructor
              */
-            curve_oid() = default;
+            curve_oid() noexcept = default;
 
             /**
              *  Constructor
@@ -31,41 +62,46 @@ namespace pgp {
             template <class decoder, class = std::enable_if_t<is_decoder_v<decoder>>>
             explicit curve_oid(decoder &parser)
             {
-                // first read the number of elements
+                // first read the number of elements, and the elements themselves
                 auto count = parser.template extract_number<uint8_t>();
+                auto data = parser.template extract_blob<uint8_t>(count);
 
-                // allocate memory for the number
-                _data.reserve(count);
-
-                // and now read all the elements
-                while (_data.size() < count) {
-                    // add an element
-                    _data.push_back(parser.template extract_number<uint8_t>());
-                }
+                // and now copy all the elements at once
+                assign(data);
             }
 
             /**
              *  Constructor
              *
              *  @param  data    The range of numbers
+             *  @throws std::range_error
              */
-            explicit curve_oid(span<const uint8_t> data) noexcept;
+            explicit curve_oid(span<const uint8_t> data);
 
             /**
              *  Constructor
              *
              *  @param  data    The range of numbers
+             *  @throws std::range_error
+             */
+            curve_oid(std::initializer_list<const uint8_t> data);
+
+            /**
+             *  Constructor
+             *
+             *  @param  curve   The known curve to create the identifier for
              */
-            curve_oid(std::initializer_list<const uint8_t> data) noexcept;
+            explicit curve_oid(curve_id curve) noexcept;
 
             /**
              *  Some commonly used curves
              *
              *  @return The curve oid
              */
-            static curve_oid ed25519()      { return {{ 0x2b, 0x06, 0x01, 0x04, 0x01, 0xda, 0x47, 0x0f, 0x01         }};    }
-            static curve_oid curve_25519()  { return {{ 0x2B, 0x06, 0x01, 0x04, 0x01, 0x97, 0x55, 0x01, 0x05, 0x01   }};    }
-            static curve_oid ecdsa()        { return {{ 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x03, 0x01, 0x07               }};    }
+            static curve_oid ed25519()      noexcept { return curve_oid{ curve_id::ed25519     };  }
+            static curve_oid curve_25519()  noexcept { return curve_oid{ curve_id::curve_25519 };  }
+            static curve_oid ecdsa()        noexcept { return curve_oid{ curve_id::nist_p256   };  }
+
             /**
              *  Comparison operators
              *
@@ -74,6 +110,12 @@ namespace pgp {
             bool operator==(const curve_oid &other) const noexcept;
             bool operator!=(const curve_oid &other) const noexcept;
 
+            /**
+             *  Retrieve the curve identified
+             *  @return The curve, or curve_id::unknown
+             */
+            curve_id id() const noexcept { return _id; }
+
             /**
              *  Determine the size used in encoded format
              *  @return The number of bytes used for encoded storage
@@ -84,7 +126,7 @@ namespace pgp {
              *  Retrieve the data
              *  @return A span containing all the integer numbers
              */
-            span<const uint8_t> data() const;
+            span<const uint8_t> data() const noexcept;
 
             /**
              *  Write the data to an encoder
@@ -96,16 +138,48 @@ namespace pgp {
             void encode(encoder_t&& writer) const
             {
                 // write out the number of elements first
-                writer.push(static_cast<uint8_t>(_data.size()));
+                writer.push(_size);
 
-                // now add all the elements
-                for (auto number : _data) {
-                    // add the number
-                    writer.push(number);
-                }
+                // then add all the elements
+                writer.insert_blob(data());
             }
         private:
-            std::vector<uint8_t>    _data;
+            /**
+             *  Store the identifier and look up the curve
+             *
+             *  @param  data    The range of numbers
+             *  @throws std::range_error
+             */
+            void assign(span<const uint8_t> data);
+
+            uint8_t                             _size   { 0 };                  // the number of bytes used
+            curve_id                            _id     { curve_id::unknown };  // the curve, if it is known
+            std::array<uint8_t, inline_size>    _data   {};                     // the identifier, padded with zeroes
+            std::vector<uint8_t>                _long;                          // the identifier, if it is too long to store inline
     };
 
+    /**
+     *  A curve with a known object identifier
+     */
+    struct known_curve
+    {
+        curve_id                                    id;     // the curve
+        uint8_t                                     size;   // the number of bytes in the identifier
+        std::array<uint8_t, curve_oid::inline_size> data;   // the identifier, padded with zeroes
+    };
+
+    /**
+     *  The registry of known curves
+     */
+    constexpr std::array<known_curve, 8> known_curves{{
+        { curve_id::nist_p256,          8,  { 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07             } },
+        { curve_id::nist_p384,          5,  { 0x2b, 0x81, 0x04, 0x00, 0x22                               } },
+        { curve_id::nist_p521,          5,  { 0x2b, 0x81, 0x04, 0x00, 0x23                               } },
+        { curve_id::brainpool_p256r1,   9,  { 0x2b, 0x24, 0x03, 0x03, 0x02, 0x08, 0x01, 0x01, 0x07       } },
+        { curve_id::brainpool_p384r1,   9,  { 0x2b, 0x24, 0x03, 0x03, 0x02, 0x08, 0x01, 0x01, 0x0b       } },
+        { curve_id::brainpool_p512r1,   9,  { 0x2b, 0x24, 0x03, 0x03, 0x02, 0x08, 0x01, 0x01, 0x0d       } },
+        { curve_id::ed25519,            9,  { 0x2b, 0x06, 0x01, 0x04, 0x01, 0xda, 0x47, 0x0f, 0x01       } },
+        { curve_id::curve_25519,        10, { 0x2b, 0x06, 0x01, 0x04, 0x01, 0x97, 0x55, 0x01, 0x05, 0x01 } }
+    }};
+
 }
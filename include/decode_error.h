@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <boost/utility/string_view.hpp>
+
+
+namespace pgp {
+
+    /**
+     *  The kinds of errors encountered when decoding malformed data
+     */
+    enum class decode_error_kind : uint8_t
+    {
+        none                = 0,
+        truncated           = 1,
+        invalid_header      = 2,
+        unexpected_value    = 3,
+        invalid_subpacket   = 4,
+        unsupported         = 5
+    };
+
+    /**
+     *  Get a description of the decode error kind
+     *
+     *  @param  kind    The error kind to get a description for
+     *  @return The description of the error kind
+     */
+    constexpr boost::string_view decode_error_kind_description(decode_error_kind kind) noexcept
+    {
+        // check the provided kind
+        switch (kind) {
+            case decode_error_kind::none:               return "no error";
+            case decode_error_kind::truncated:          return "not enough data available";
+            case decode_error_kind::invalid_header:     return "invalid packet header";
+            case decode_error_kind::unexpected_value:   return "a fixed number is outside of expected range";
+            case decode_error_kind::invalid_subpacket:  return "invalid signature subpacket";
+            case decode_error_kind::unsupported:        return "unsupported encoding";
+        }
+
+        // unknown kind found
+        return "unknown decode error";
+    }
+
+    /**
+     *  Class describing an error encountered while decoding,
+     *  holding the kind of error and the offset in the input
+     *  at which it was detected.
+     *
+     *  A default-constructed error indicates that no error occurred.
+     */
+    class decode_error
+    {
+        public:
+            /**
+             *  Constructor
+             *
+             *  @note   Creates an error indicating success
+             */
+            decode_error() = default;
+
+            /**
+             *  Constructor
+             *
+             *  @param  kind    The kind of error
+             *  @param  offset  The byte offset at which the error was detected
+             */
+            decode_error(decode_error_kind kind, size_t offset) noexcept;
+
+            /**
+             *  Comparison operators
+             *
+             *  @param  other   The object to compare with
+             */
+            bool operator==(const decode_error &other) const noexcept;
+            bool operator!=(const decode_error &other) const noexcept;
+
+            /**
+             *  Check whether an error occurred
+             *
+             *  @return Whether the kind is anything other than none
+             */
+            explicit operator bool() const noexcept;
+
+            /**
+             *  Retrieve the kind of error
+             *
+             *  @return The error kind
+             */
+            decode_error_kind kind() const noexcept;
+
+            /**
+             *  Retrieve the offset of the error
+             *
+             *  @note   For packets using partial body lengths, errors inside
+             *          the body are counted from the start of the first chunk,
+             *          as if the chunks were stored without length octets
+             *  @return The number of bytes from the start of the input
+             */
+            size_t offset() const noexcept;
+        private:
+            decode_error_kind   _kind   { decode_error_kind::none };    // the kind of error
+            size_t              _offset { 0 };                          // the offset of the error
+    };
+
+}
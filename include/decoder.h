@@ -5,6 +5,8 @@
 #include <cstring>
 #include <limits>
 #include <stdexcept>
+#include "decode_error.h"
+#include "memory_resource.h"
 #include "util/span.h"
 
 
@@ -13,6 +15,14 @@ namespace pgp {
     /**
      *  Class to handle the encoded wire format used
      *  in RFC 4880
+     *
+     *  Malformed data normally raises an exception. When the
+     *  decoder is given a decode_error, it instead records the
+     *  first error there and behaves as if the data is exhausted,
+     *  so decoding continues without raising any exceptions.
+     *
+     *  When the decoder is given a memory resource, the data held
+     *  by the decoded objects is allocated from that resource.
      */
     class decoder
     {
@@ -31,6 +41,42 @@ namespace pgp {
              */
             explicit decoder(span<const uint8_t> data) noexcept;
 
+            /**
+             *  Constructor
+             *
+             *  @param  data    The range to decode from
+             *  @param  error   The error to report malformed data to
+             */
+            decoder(span<const uint8_t> data, decode_error &error) noexcept;
+
+            /**
+             *  Constructor
+             *
+             *  @param  data        The range to decode from
+             *  @param  resource    The resource to allocate decoded data from
+             */
+            decoder(span<const uint8_t> data, memory_resource &resource) noexcept;
+
+            /**
+             *  Constructor
+             *
+             *  @param  data        The range to decode from
+             *  @param  resource    The resource to allocate decoded data from
+             *  @param  error       The error to report malformed data to
+             */
+            decoder(span<const uint8_t> data, memory_resource &resource, decode_error &error) noexcept;
+
+            /**
+             *  Constructor
+             *
+             *  Continue decoding where another decoder currently is,
+             *  reporting malformed data to the given error instead.
+             *
+             *  @param  parser  The decoder to continue from
+             *  @param  error   The error to report malformed data to
+             */
+            decoder(const decoder &parser, decode_error &error) noexcept;
+
             /**
              *  The decoder is a move-only class
              *
@@ -76,6 +122,37 @@ namespace pgp {
              */
             size_t size() const noexcept;
 
+            /**
+             *  The offset of the current position in the data
+             *
+             *  @return The number of bytes consumed since the start of the input
+             */
+            size_t offset() const noexcept;
+
+            /**
+             *  The resource to allocate decoded data from
+             *
+             *  Secret key material ignores the resource, it
+             *  is always allocated in secure memory.
+             *
+             *  @return The resource, or a nullptr to use new and delete
+             */
+            memory_resource *resource() const noexcept;
+
+            /**
+             *  Report that the data is malformed
+             *
+             *  Unless the decoder reports to a decode_error, this raises
+             *  an exception matching the kind of error. Otherwise the error
+             *  is recorded - unless an earlier error already was - and
+             *  all remaining data is discarded.
+             *
+             *  @param  kind    The kind of error encountered
+             *  @param  message The message for the exception to raise
+             *  @throws std::out_of_range, std::range_error, std::runtime_error
+             */
+            void fail(decode_error_kind kind, const char *message);
+
             /**
              *  Peek at bits at the current position, but
              *  do not consume them
@@ -108,7 +185,8 @@ namespace pgp {
                 // make sure we have enough data for decoding the number
                 if (_data.size() < sizeof(T)) {
                     // trying to read out-of-bounds
-                    throw std::out_of_range{ "Not enough data available to read number" };
+                    report(decode_error_kind::truncated, "Not enough data available to read number");
+                    return 0;
                 }
 
                 // the result to copy to
@@ -133,11 +211,19 @@ namespace pgp {
             template <typename T>
             T extract_number()
             {
+                // make sure we have enough data for decoding the number
+                if (_data.size() < sizeof(T)) {
+                    // trying to read out-of-bounds
+                    fail(decode_error_kind::truncated, "Not enough data available to read number");
+                    return 0;
+                }
+
                 // first extract the number
                 auto result = peek_number<T>();
 
                 // and then advance the extracted number of bytes
                 _data = _data.subspan<sizeof(T)>();
+                _offset += sizeof(T);
                 _skip_bits = 0;
 
                 // return the result
@@ -158,18 +244,42 @@ namespace pgp {
                 // otherwise we might get alignment issues
                 static_assert(sizeof(T) == 1, "extract_blob can only be used with single-octet types");
 
-                // create the result variable containing the data - we do not
-                // check the bounds here, but the subspan below will fail in
-                // case the read is out-of-bounds
+                // make sure we have enough data for the blob
+                if (static_cast<size_t>(_data.size()) < size) {
+                    // trying to read out-of-bounds
+                    fail(decode_error_kind::truncated, "Not enough data available to read blob");
+                    return {};
+                }
+
+                // create the result variable containing the data
                 span<const T> result{ reinterpret_cast<const T*>(_data.data()), static_cast<typename span<uint8_t>::size_type>(size) };
 
                 // remove the bytes from the local data
                 _data = _data.subspan(size);
+                _offset += size;
 
                 // return the requested result
                 return result;
             }
+        protected:
+            /**
+             *  Replace the data to decode, keeping the offset
+             *  and the error reporting of the decoder intact
+             *
+             *  @param  data    The range to decode from
+             */
+            void replace(span<const uint8_t> data) noexcept;
         private:
+            /**
+             *  Report that the data is malformed, without
+             *  discarding the remaining data
+             *
+             *  @param  kind    The kind of error encountered
+             *  @param  message The message for the exception to raise
+             *  @throws std::out_of_range, std::range_error, std::runtime_error
+             */
+            void report(decode_error_kind kind, const char *message) const;
+
             /**
              *  Mask the number, removing already-ready bits
              *
@@ -185,8 +295,11 @@ namespace pgp {
                 return number & mask;
             }
 
-            span<const uint8_t>   _data;                    // the raw data to work with
-            uint8_t                     _skip_bits  { 0 };  // number of bits to skip from data
+            span<const uint8_t>     _data;                      // the raw data to work with
+            size_t                  _offset     { 0 };          // offset of the data in the input
+            decode_error           *_error      { nullptr };    // the error to report to, if any
+            memory_resource        *_resource   { nullptr };    // the resource to allocate from, if any
+            uint8_t                 _skip_bits  { 0 };          // number of bits to skip from data
     };
 
 }
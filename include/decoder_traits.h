@@ -1,6 +1,7 @@
 #pragma once
 
 #include "util/span.h"
+#include "decode_error.h"
 #include <type_traits>
 #include <cstddef>
 #include <cstdint>
@@ -27,7 +28,8 @@ namespace pgp {
         std::enable_if_t<std::is_same_v<uint8_t,                decltype(std::declval<T>().extract_bits(0))                     >>,
         std::enable_if_t<std::is_same_v<uint8_t,                decltype(std::declval<T>().template peek_number<uint8_t>())     >>,
         std::enable_if_t<std::is_same_v<uint8_t,                decltype(std::declval<T>().template extract_number<uint8_t>())  >>,
-        std::enable_if_t<std::is_same_v<span<const uint8_t>,    decltype(std::declval<T>().template extract_blob<uint8_t>(0))   >>
+        std::enable_if_t<std::is_same_v<span<const uint8_t>,    decltype(std::declval<T>().template extract_blob<uint8_t>(0))   >>,
+        std::enable_if_t<std::is_same_v<void,                   decltype(std::declval<T>().fail(decode_error_kind::none, ""))   >>
     >> : std::true_type {};
 
     /**
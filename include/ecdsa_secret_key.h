@@ -29,7 +29,7 @@ namespace pgp {
              *
              *  @param  k           The secret scalar for the public point
              */
-            explicit ecdsa_secret_key(multiprecision_integer k) noexcept;
+            explicit ecdsa_secret_key(secret_multiprecision_integer k) noexcept;
 
             /**
              *  Comparison operators
@@ -50,7 +50,7 @@ namespace pgp {
              *
              *  @return The secret scalar for the public point
              */
-            const multiprecision_integer &k() const noexcept;
+            const secret_multiprecision_integer &k() const noexcept;
 
             /**
              *  Write the data to an encoder
@@ -65,7 +65,7 @@ namespace pgp {
                 _k.encode(writer);
             }
         private:
-            multiprecision_integer  _k;     // the secret scalar for the public point
+            secret_multiprecision_integer  _k;     // the secret scalar for the public point
     };
 
 }
@@ -3,8 +3,12 @@
 #include <cstddef>
 #include <type_traits>
 #include "decoder_traits.h"
+#include "hash_algorithm.h"
 #include "ecdsa_signature_encoder.h"
+#include "ecdsa_signature_signer.h"
+#include "ecdsa_signature_verifier.h"
 #include "multiprecision_integer.h"
+#include "util/span.h"
 
 
 namespace pgp {
@@ -16,6 +20,8 @@ namespace pgp {
     {
         public:
             using encoder_t = ecdsa_signature_encoder;
+            using signer_t = ecdsa_signature_signer;
+            using verifier_t = ecdsa_signature_verifier;
 
             /**
              *  Constructor
@@ -64,6 +70,20 @@ namespace pgp {
              */
             const multiprecision_integer &s() const noexcept;
 
+            /**
+             *  Verify the signature over a digest
+             *
+             *  Digests longer than the curve order are truncated,
+             *  like they are when signing.
+             *
+             *  @param  key         The public key of the signer
+             *  @param  algorithm   The hash algorithm used for the digest
+             *  @param  digest      The digest that was signed
+             *  @return Whether the signature is valid
+             *  @throws std::runtime_error for unsupported curves
+             */
+            bool verify(const ecdsa_public_key &key, hash_algorithm algorithm, span<const uint8_t> digest) const;
+
             /**
              *  Write the data to an encoder
              *
@@ -5,6 +5,7 @@
 #include "basic_secret_key.h"
 #include "ecdsa_public_key.h"
 #include "ecdsa_secret_key.h"
+#include "ecdsa_signature_signer.h"
 #include "hash_encoder.h"
 #include "multiprecision_integer.h"
 #include "packet_tag.h"
@@ -25,8 +26,17 @@ namespace pgp {
              *  @param key        The secret key with which to make the signature
              */
             template <packet_tag key_tag>
-            explicit ecdsa_signature_encoder(const basic_key<secret_key_traits<key_tag>> &key) noexcept :
-                ecdsa_key{get<basic_secret_key<ecdsa_public_key, ecdsa_secret_key>>(key.key())}
+            explicit ecdsa_signature_encoder(const basic_key<secret_key_traits<key_tag>> &key) :
+                _signer{get<basic_secret_key<ecdsa_public_key, ecdsa_secret_key>>(key.key())}
+            {}
+
+            /**
+             *  Create the encoder
+             *
+             *  @param signer     The prepared signer with which to make the signature
+             */
+            explicit ecdsa_signature_encoder(const ecdsa_signature_signer &signer) noexcept :
+                _signer{signer}
             {}
 
             /**
@@ -38,9 +48,9 @@ namespace pgp {
 
         private:
             /**
-             *  The key with which to make the signature
+             *  The signer with which to make the signature
              */
-            basic_secret_key<ecdsa_public_key, ecdsa_secret_key> ecdsa_key;
+            ecdsa_signature_signer _signer;
     };
 
 }
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cryptopp/eccrypto.h>
+#include <cryptopp/ecp.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include "basic_secret_key.h"
+#include "ecdsa_public_key.h"
+#include "ecdsa_secret_key.h"
+#include "multiprecision_integer.h"
+#include "null_hash.h"
+#include "util/span.h"
+
+
+namespace pgp {
+
+    // Forward declaration to prevent header dependency cycles
+    class ecdsa_signature;
+
+    /**
+     *  Class for making ECDSA signatures with a single key
+     *
+     *  The secret scalar is decoded once, into a Crypto++ signer.
+     *  Copies of the signer share the same Crypto++ signer, and the
+     *  signer is not modified when used, so it may make signatures
+     *  from several threads at once.
+     *
+     *  Only the Crypto++ signer object itself is allocated in secure
+     *  memory. Crypto++ stores the secret scalar in a buffer of its
+     *  own, which is wiped when released, but is not locked in
+     *  memory, so it may end up in swap.
+     */
+    class ecdsa_signature_signer
+    {
+        public:
+            /**
+             *  The signature type we make
+             */
+            using signature_t = ecdsa_signature;
+
+            /**
+             *  Constructor
+             *
+             *  @param  key     The secret key to sign with
+             */
+            explicit ecdsa_signature_signer(const basic_secret_key<ecdsa_public_key, ecdsa_secret_key> &key);
+
+            /**
+             *  Sign a digest
+             *
+             *  @param  digest  The digest to sign
+             *  @return Tuple of the r and s parameters for the ECDSA signature
+             *  @throws std::logic_error when Crypto++ makes an unexpected signature
+             */
+            std::tuple<multiprecision_integer, multiprecision_integer> sign(span<const uint8_t> digest) const;
+        private:
+            // the size of the digest and the signature values
+            static constexpr size_t integer_size = 32;
+
+            // the Crypto++ signer type
+            using signer_t = CryptoPP::ECDSA<CryptoPP::ECP, NullHash<integer_size>>::Signer;
+
+            std::shared_ptr<const signer_t> _signer;    // the prepared signer
+    };
+
+}
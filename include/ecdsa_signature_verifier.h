@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cryptopp/eccrypto.h>
+#include <cryptopp/ecp.h>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include "ecdsa_public_key.h"
+#include "hash_algorithm.h"
+#include "null_hash.h"
+#include "util/span.h"
+
+
+namespace pgp {
+
+    // Forward declaration to prevent header dependency cycles
+    class ecdsa_signature;
+
+    /**
+     *  Class for verifying ECDSA signatures made by a single key
+     *
+     *  The point is decoded once, so that it can be used to
+     *  verify many signatures. The verifier is not modified
+     *  when used, so it may verify signatures from several
+     *  threads at once.
+     */
+    class ecdsa_signature_verifier
+    {
+        public:
+            /**
+             *  The signature type we verify
+             */
+            using signature_t = ecdsa_signature;
+
+            /**
+             *  Constructor
+             *
+             *  @param  key     The public key of the signer
+             */
+            explicit ecdsa_signature_verifier(const ecdsa_public_key &key);
+
+            /**
+             *  Verify a signature over a digest
+             *
+             *  Digests longer than the curve order are truncated,
+             *  like they are when signing.
+             *
+             *  @param  signature   The signature to verify
+             *  @param  algorithm   The hash algorithm used for the digest
+             *  @param  digest      The digest that was signed
+             *  @return Whether the signature is valid
+             *  @throws pgp::unsupported_algorithm for unsupported curves
+             */
+            bool verify(const ecdsa_signature &signature, hash_algorithm algorithm, span<const uint8_t> digest) const;
+        private:
+            // the size of the coordinates and the signature values
+            static constexpr size_t integer_size = 32;
+
+            // the Crypto++ verifier type
+            using verifier_t = CryptoPP::ECDSA<CryptoPP::ECP, NullHash<integer_size>>::Verifier;
+
+            bool                        _supported  { false };  // whether the key is on a supported curve
+            std::optional<verifier_t>   _verifier;              // the verifier, if the key is well-formed
+    };
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <vector>
+#include "eddsa_public_key.h"
+#include "util/span.h"
+
+
+namespace pgp {
+
+    // Forward declaration to prevent header dependency cycles
+    class eddsa_signature;
+
+    /**
+     *  Class for verifying many EdDSA signatures at once
+     *
+     *  Signatures made by the same key share a table with multiples
+     *  of that key, and of the base point. With these, verifying a
+     *  signature needs additions only, instead of a full scalar
+     *  multiplication, which costs about half as much. Building the
+     *  table costs a little more than verifying a signature, so keys
+     *  that made only a few of the signatures are checked without.
+     *
+     *  Every signature is checked on its own - there is no batch
+     *  equation that could be fooled by points of small order - so
+     *  the results are exactly those of the eddsa_signature_verifier.
+     *
+     *  The arithmetic needs 128-bit integers. On compilers without
+     *  them, every signature is checked by libsodium instead.
+     */
+    class eddsa_batch_verifier
+    {
+        public:
+            /**
+             *  Add a signature to verify
+             *
+             *  @param  key         The public key of the signer
+             *  @param  signature   The signature to verify
+             *  @param  digest      The digest that was signed
+             *  @throws pgp::unsupported_algorithm for unsupported curves
+             */
+            void add(const eddsa_public_key &key, const eddsa_signature &signature, span<const uint8_t> digest);
+
+            /**
+             *  Retrieve the number of signatures added
+             *
+             *  @return The number of signatures to verify
+             */
+            size_t size() const noexcept;
+
+            /**
+             *  Verify all the signatures added
+             *
+             *  The results are exactly those of the eddsa_signature_verifier.
+             *
+             *  @return Whether each signature is valid, in the order they were added
+             */
+            std::vector<bool> verify() const;
+        private:
+            /**
+             *  A single signature to verify
+             */
+            struct entry
+            {
+                std::array<uint8_t, 32> key;        // the public key, without its prefix
+                std::array<uint8_t, 64> signature;  // the r and s values
+                std::array<uint8_t, 64> digest;     // the signed digest
+                uint8_t                 size;       // the number of bytes in the digest
+                bool                    valid;      // whether the key and signature are well-formed
+            };
+
+            std::vector<entry>  _entries;   // the signatures to verify
+    };
+
+}
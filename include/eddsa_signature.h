@@ -3,8 +3,12 @@
 #include <cstddef>
 #include <type_traits>
 #include "decoder_traits.h"
+#include "hash_algorithm.h"
 #include "eddsa_signature_encoder.h"
+#include "eddsa_signature_signer.h"
+#include "eddsa_signature_verifier.h"
 #include "multiprecision_integer.h"
+#include "util/span.h"
 
 
 namespace pgp {
@@ -16,6 +20,8 @@ namespace pgp {
     {
         public:
             using encoder_t = eddsa_signature_encoder;
+            using signer_t = eddsa_signature_signer;
+            using verifier_t = eddsa_signature_verifier;
 
             /**
              *  Constructor
@@ -64,6 +70,20 @@ namespace pgp {
              */
             const multiprecision_integer &s() const noexcept;
 
+            /**
+             *  Verify the signature over a digest
+             *
+             *  EdDSA signs the digest itself, so it is checked as
+             *  the message, like it was signed.
+             *
+             *  @param  key         The public key of the signer
+             *  @param  algorithm   The hash algorithm used for the digest
+             *  @param  digest      The digest that was signed
+             *  @return Whether the signature is valid
+             *  @throws std::runtime_error for unsupported curves
+             */
+            bool verify(const eddsa_public_key &key, hash_algorithm algorithm, span<const uint8_t> digest) const;
+
             /**
              *  Write the data to an encoder
              *
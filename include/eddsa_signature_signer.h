@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <array>
+#include <memory>
+#include <tuple>
+#include "basic_secret_key.h"
+#include "eddsa_public_key.h"
+#include "eddsa_secret_key.h"
+#include "multiprecision_integer.h"
+#include "util/span.h"
+
+
+namespace pgp {
+
+    // Forward declaration to prevent header dependency cycles
+    class eddsa_signature;
+
+    /**
+     *  Class for making EdDSA signatures with a single key
+     *
+     *  The key is unpacked once, into the buffer libsodium signs
+     *  with, which is kept in secure memory. Copies of the signer
+     *  share the same buffer, and the signer is not modified when
+     *  used, so it may make signatures from several threads at once.
+     */
+    class eddsa_signature_signer
+    {
+        public:
+            /**
+             *  The signature type we make
+             */
+            using signature_t = eddsa_signature;
+
+            /**
+             *  Constructor
+             *
+             *  @param  key     The secret key to sign with
+             */
+            explicit eddsa_signature_signer(const basic_secret_key<eddsa_public_key, eddsa_secret_key> &key);
+
+            /**
+             *  Sign a digest
+             *
+             *  @param  digest  The digest to sign
+             *  @return Tuple of the r and s parameters for the EdDSA signature
+             */
+            std::tuple<multiprecision_integer, multiprecision_integer> sign(span<const uint8_t> digest) const noexcept;
+        private:
+            // the secret key followed by the public key, like libsodium uses it
+            using key_data_t = std::array<uint8_t, 64>;
+
+            std::shared_ptr<const key_data_t>   _key;   // the unpacked key, in secure memory
+    };
+
+}
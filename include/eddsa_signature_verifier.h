@@ -0,0 +1,58 @@
+#pragma once
+
+#include <sodium/crypto_sign.h>
+#include <cstdint>
+#include <array>
+#include "eddsa_public_key.h"
+#include "hash_algorithm.h"
+#include "util/span.h"
+
+
+namespace pgp {
+
+    // Forward declaration to prevent header dependency cycles
+    class eddsa_signature;
+
+    /**
+     *  Class for verifying EdDSA signatures made by a single key
+     *
+     *  The key is checked and unpacked once, so that it can be
+     *  used to verify many signatures. The verifier is not
+     *  modified when used, so it may verify signatures from
+     *  several threads at once.
+     */
+    class eddsa_signature_verifier
+    {
+        public:
+            /**
+             *  The signature type we verify
+             */
+            using signature_t = eddsa_signature;
+
+            /**
+             *  Constructor
+             *
+             *  @param  key     The public key of the signer
+             */
+            explicit eddsa_signature_verifier(const eddsa_public_key &key) noexcept;
+
+            /**
+             *  Verify a signature over a digest
+             *
+             *  EdDSA signs the digest itself, so it is checked as
+             *  the message, like it was signed.
+             *
+             *  @param  signature   The signature to verify
+             *  @param  algorithm   The hash algorithm used for the digest
+             *  @param  digest      The digest that was signed
+             *  @return Whether the signature is valid
+             *  @throws pgp::unsupported_algorithm for unsupported curves
+             */
+            bool verify(const eddsa_signature &signature, hash_algorithm algorithm, span<const uint8_t> digest) const;
+        private:
+            bool                                            _supported  { false };  // whether the key is on a supported curve
+            bool                                            _valid      { false };  // whether the key is well-formed
+            std::array<uint8_t, crypto_sign_PUBLICKEYBYTES> _key        {};         // the key without its prefix
+    };
+
+}
@@ -29,7 +29,7 @@ namespace pgp {
              *
              *  @param  x       The secret exponent x
              */
-            explicit elgamal_secret_key(multiprecision_integer x) noexcept;
+            explicit elgamal_secret_key(secret_multiprecision_integer x) noexcept;
 
             /**
              *  Comparison operators
@@ -50,7 +50,7 @@ namespace pgp {
              *
              *  @return The secret exponent x
              */
-            const multiprecision_integer &x() const noexcept;
+            const secret_multiprecision_integer &x() const noexcept;
 
             /**
              *  Write the data to an encoder
@@ -65,7 +65,7 @@ namespace pgp {
                 _x.encode(writer);
             }
                 private:
-            multiprecision_integer  _x;     // the secret exponent x
+            secret_multiprecision_integer  _x;     // the secret exponent x
     };
 
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "decoder_traits.h"
+#include "decode_error.h"
 
 
 namespace pgp {
@@ -28,10 +29,13 @@ namespace pgp {
             explicit expected_number(decoder &parser)
             {
                 // check whether the value is as expected
-                if (parser.template extract_number<T>() != number) {
+                if (parser.template peek_number<T>() != number) {
                     // invalid number was read
-                    throw std::range_error{ "A fixed number is outside of expected range" };
+                    parser.fail(decode_error_kind::unexpected_value, "A fixed number is outside of expected range");
                 }
+
+                // consume the number
+                parser.template extract_number<T>();
             }
 
             /**
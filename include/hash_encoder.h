@@ -2,6 +2,7 @@
 
 #include <boost/endian/conversion.hpp>
 #include <cryptopp/sha.h>
+#include "util/contiguous.h"
 #include "util/span.h"
 
 
@@ -74,20 +75,19 @@ namespace pgp {
             template <typename iterator_t>
             hash_encoder &push(iterator_t begin, iterator_t end)
             {
-                // note: possible c++20 optimization
-                // // do we have a contiguous range of memory?
-                // if constexpr(std::is_same_v<std::iterator_traits<iterator_t>::iterator_category, std::contiguous_iterator_tag>) {
-                //     // push the whole range at once
-                //     _hasher.Update(&(*begin), std::distance(begin, end));
-                // }
-
-                // iterate over the range
-                while (begin != end) {
-                    // push the data
-                    push(*begin);
-
-                    // move to next element
-                    ++begin;
+                // do we have a contiguous range of bytes?
+                if constexpr (util::is_contiguous_byte_iterator_v<iterator_t>) {
+                    // push the whole range at once
+                    return insert_blob(util::make_span(begin, end));
+                } else {
+                    // iterate over the range
+                    while (begin != end) {
+                        // push the data
+                        push(*begin);
+
+                        // move to next element
+                        ++begin;
+                    }
                 }
 
                 // allow chaining
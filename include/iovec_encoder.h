@@ -0,0 +1,260 @@
+#pragma once
+
+#include <boost/endian/conversion.hpp>
+#include <sys/uio.h>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "util/vector.h"
+#include "util/contiguous.h"
+#include "util/span.h"
+
+
+namespace pgp {
+
+    /**
+     *  Class for encoding packet data as a list of buffers,
+     *  for scatter-gather output using writev() or sendmsg().
+     *
+     *  Headers and other small fields are copied to a staging
+     *  buffer, while larger blobs - such as user ids and other
+     *  payloads - are only referenced. The encoded objects must
+     *  therefore be kept alive, and unchanged, for as long as
+     *  the buffers are in use.
+     */
+    class iovec_encoder
+    {
+        public:
+            /**
+             *  The default size from which blobs are referenced
+             */
+            static constexpr size_t default_reference_threshold = 128;
+
+            /**
+             *  Constructor
+             *
+             *  @param  reference_threshold     Blobs at least this size are referenced instead of copied
+             */
+            explicit iovec_encoder(size_t reference_threshold = default_reference_threshold) noexcept;
+
+            /**
+             *  Flush the encoder, so any partial-written bytes
+             *  are written out. Note that after this operation,
+             *  bitwise operations start at the beginning again.
+             */
+            void flush();
+
+            /**
+             *  Retrieve the number of encoded bytes
+             *  @return The number of bytes in all the buffers
+             */
+            size_t size() const noexcept;
+
+            /**
+             *  Retrieve the buffers holding the encoded data
+             *
+             *  The buffers are valid until more data is encoded. Note
+             *  that the number of buffers may exceed IOV_MAX, in which
+             *  case they must be written using multiple calls.
+             *
+             *  @return The buffers, in order
+             */
+            std::vector<iovec> buffers() const;
+
+            /**
+             *  Insert one or more bits
+             *
+             *  @param  count   The number of bits to insert
+             *  @param  value   The value to store in the bits
+             *  @return self, for chaining
+             *  @throws std::out_of_range, std::range_error
+             */
+            iovec_encoder &insert_bits(size_t count, uint8_t value);
+
+            /**
+             *  Push a number to the encoder
+             *
+             *  @param  value   The number to push
+             *  @return self, for chaining
+             *  @throws std::range_error
+             */
+            template <typename T>
+            typename std::enable_if_t<std::numeric_limits<T>::is_integer, iovec_encoder&>
+            push(T value)
+            {
+                // ensure that masking the number doesn't change it
+                if ((value & (std::numeric_limits<T>::max() >> _skip_bits)) != value) {
+                    // the number is out of range because it has bits set which should be masked
+                    throw std::range_error{ "Cannot insert number, masked bits are set" };
+                }
+
+                // retrieve the currently-set bits and shift them to the left of the number
+                T result = static_cast<T>(static_cast<T>(_current) << ((sizeof(T) - 1) * 8));
+
+                // add the new value to it and convert it to big-endian, see
+                // range_encoder for why we go through the unsigned type
+                result |= value;
+                result = static_cast<T>(
+                    boost::endian::native_to_big(static_cast<std::make_unsigned_t<T>>(result))
+                );
+
+                // the partial byte is now written
+                _current = 0;
+                _skip_bits = 0;
+
+                // numbers are always copied
+                stage(span<const uint8_t>{ reinterpret_cast<const uint8_t*>(&result), sizeof result });
+
+                // allow chaining
+                return *this;
+            }
+
+            /**
+             *  Insert an enum
+             *
+             *  @param  value   The enum to insert
+             *  @return self, for chaining
+             *  @throws std::range_error
+             */
+            template <typename T>
+            typename std::enable_if_t<std::is_enum<T>::value, iovec_encoder&>
+            push(T value)
+            {
+                // cast it to a number and insert it
+                return push(static_cast<typename std::underlying_type_t<T>>(value));
+            }
+
+            /**
+             *  Push a range of data
+             *
+             *  @param  begin   The iterator to the beginning of the data
+             *  @param  end     The iterator to the end of the data
+             *  @return self, for chaining
+             *  @throws std::range_error
+             */
+            template <typename iterator_t>
+            iovec_encoder &push(iterator_t begin, iterator_t end)
+            {
+                // do we have a contiguous range of bytes?
+                if constexpr (util::is_contiguous_byte_iterator_v<iterator_t>) {
+                    // push the whole range at once
+                    return insert_blob(util::make_span(begin, end));
+                } else {
+                    // iterate over the range
+                    while (begin != end) {
+                        // push the data
+                        push(*begin);
+
+                        // move to next element
+                        ++begin;
+                    }
+                }
+
+                // allow chaining
+                return *this;
+            }
+
+            /**
+             *  Insert a blob of data
+             *
+             *  @param  value   The data to insert
+             *  @return self, for chaining
+             *  @throws std::range_error
+             */
+            template <typename T>
+            iovec_encoder &insert_blob(span<const T> value)
+            {
+                // large blobs may be referenced
+                return insert(value, _reference_threshold);
+            }
+
+            /**
+             *  Insert a blob of data, always copying it
+             *
+             *  This is used for data that does not outlive the call,
+             *  such as the scratch buffer of another encoder that is
+             *  overwritten once the data is inserted.
+             *
+             *  @param  value   The data to insert
+             *  @return self, for chaining
+             *  @throws std::range_error
+             */
+            template <typename T>
+            iovec_encoder &copy_blob(span<const T> value)
+            {
+                // no blob is large enough to be referenced
+                return insert(value, std::numeric_limits<size_t>::max());
+            }
+        private:
+            /**
+             *  Insert a blob of data
+             *
+             *  @param  value       The data to insert
+             *  @param  threshold   Blobs at least this size are referenced instead of copied
+             *  @return self, for chaining
+             *  @throws std::range_error
+             */
+            template <typename T>
+            iovec_encoder &insert(span<const T> value, size_t threshold)
+            {
+                if (value.empty()) {
+                    // nothing to do if the input is empty
+                    return *this;
+                }
+
+                // add the first value using push() to merge in the possible queued bits
+                push(value[0]);
+
+                // the rest of the data can be referenced or copied
+                span<const uint8_t> data{ reinterpret_cast<const uint8_t*>(value.data() + 1), (static_cast<size_t>(value.size()) - 1) * sizeof(T) };
+
+                // is the blob large enough to be worth referencing?
+                if (static_cast<size_t>(data.size()) >= threshold) {
+                    // refer to the blob directly
+                    reference(data);
+                } else {
+                    // copy it to the staging buffer
+                    stage(data);
+                }
+
+                // allow chaining
+                return *this;
+            }
+
+            /**
+             *  A single buffer, either referring to external
+             *  data or to a range in the staging buffer
+             */
+            struct segment
+            {
+                const uint8_t  *data;   // the referenced data, or nullptr when staged
+                size_t          offset; // the offset in the staging buffer
+                size_t          size;   // the number of bytes in the buffer
+            };
+
+            /**
+             *  Copy data to the staging buffer
+             *
+             *  @param  data    The data to copy
+             */
+            void stage(span<const uint8_t> data);
+
+            /**
+             *  Add a reference to external data
+             *
+             *  @param  data    The data to refer to
+             */
+            void reference(span<const uint8_t> data);
+
+            vector<uint8_t>         _staging;                   // the staging buffer for small fields
+            std::vector<segment>    _segments;                  // the buffers, in order
+            size_t                  _reference_threshold;       // the size from which to reference blobs
+            size_t                  _size           { 0 };      // number of bytes encoded
+            uint8_t                 _current        { 0 };      // the current byte we are working on
+            uint8_t                 _skip_bits      { 0 };      // number of bits to skip from data
+    };
+
+}
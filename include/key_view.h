@@ -0,0 +1,220 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include "basic_key.h"
+#include "decoder.h"
+#include "decoder_traits.h"
+#include "expected_number.h"
+#include "fixed_number.h"
+#include "hash_encoder.h"
+#include "key_algorithm.h"
+#include "mpi_view.h"
+#include "packet_tag.h"
+#include "util/narrow_cast.h"
+#include "util/span.h"
+
+
+namespace pgp {
+
+    /**
+     *  A view on a public or secret (sub)key, referring to
+     *  the encoded data instead of holding a copy of it.
+     *
+     *  The public key material is split up into its fields,
+     *  any secret key material is available as a raw range.
+     *  The view is only valid as long as the data it was
+     *  decoded from is kept alive.
+     */
+    class key_view
+    {
+        public:
+            /**
+             *  Constructor
+             *
+             *  @param  tag     The tag of the packet holding the key
+             *  @param  parser  The decoder to parse the data
+             *  @throws std::out_of_range, std::range_error
+             */
+            template <class decoder, class = std::enable_if_t<is_decoder_v<decoder>>>
+            key_view(packet_tag tag, decoder &parser) :
+                key_view{ tag, parser.template extract_blob<uint8_t>(parser.size()) }
+            {}
+
+            /**
+             *  Constructor
+             *
+             *  @param  tag     The tag of the packet holding the key
+             *  @param  data    The encoded key data to refer to
+             *  @throws std::out_of_range, std::range_error
+             */
+            key_view(packet_tag tag, span<const uint8_t> data);
+
+            /**
+             *  Comparison operators
+             *
+             *  @param  other   The object to compare with
+             */
+            bool operator==(const key_view &other) const noexcept;
+            bool operator!=(const key_view &other) const noexcept;
+
+            /**
+             *  Retrieve the packet tag used for this
+             *  packet type
+             *  @return The packet type to use
+             */
+            packet_tag tag() const noexcept;
+
+            /**
+             *  Determine the size used in encoded format
+             *  @return The number of bytes used for encoded storage
+             */
+            size_t size() const noexcept;
+
+            /**
+             *  Get the key version
+             *  @return The key version format
+             */
+            constexpr uint8_t version() const noexcept
+            {
+                // we only support version 4 keys
+                return 4;
+            }
+
+            /**
+             *  Get the creation time
+             *  @return UNIX timestamp with key creation time
+             */
+            uint32_t creation_time() const noexcept;
+
+            /**
+             *  Retrieve the key algorithm
+             *  @return The algorithm used in the key
+             */
+            key_algorithm algorithm() const noexcept;
+
+            /**
+             *  Retrieve the curve object identifier, this is
+             *  empty for algorithms not using elliptic curves
+             *
+             *  @return The curve object identifier
+             */
+            span<const uint8_t> curve() const noexcept;
+
+            /**
+             *  Retrieve the integers making up the public key,
+             *  e.g. n and e for RSA or Q for curve-based keys
+             *
+             *  @return The public key integers
+             */
+            span<const mpi_view> integers() const noexcept;
+
+            /**
+             *  Retrieve the algorithm-specific public key material
+             *
+             *  @return The encoded public key fields
+             */
+            span<const uint8_t> public_data() const noexcept;
+
+            /**
+             *  Retrieve the secret key material, which is empty
+             *  for public keys and may be encrypted for secret keys
+             *
+             *  @return The encoded secret key fields
+             */
+            span<const uint8_t> secret_data() const noexcept;
+
+            /**
+             *  Hash the key into a given hash context
+             *
+             *  @param  writer  The hasher to write to
+             *  @throws std::runtime_error for secret keys with an unknown algorithm
+             */
+            template <class encoder_t>
+            void hash(encoder_t &writer) const
+            {
+                // the magic constant to use for key fingerprints
+                static constexpr const expected_number<uint8_t, 0x99> fingerprint_magic;
+
+                // an unknown secret key may hold secret material in its public data
+                if (_unknown && (_tag == packet_tag::secret_key || _tag == packet_tag::secret_subkey)) {
+                    // so we cannot hash it without leaking the secret
+                    throw std::runtime_error{ "Cannot hash a secret key with an unknown algorithm" };
+                }
+
+                // the size of the public key data we hash
+                uint16 size{ util::narrow_cast<uint16_t>(sizeof(version()) + sizeof(_creation_time) + sizeof(_algorithm) + _public_data.size()) };
+
+                // add magic constant and base fields
+                fingerprint_magic.encode(writer);
+                size.encode(writer);
+                writer.push(version());
+                writer.push(_creation_time);
+                writer.push(_algorithm);
+
+                // also hash the key data
+                writer.insert_blob(_public_data);
+            }
+
+            /**
+             *  Retrieve the fingerprint for this key
+             *
+             *  @return The 20-byte fingerprint
+             *  @throws std::runtime_error for secret keys with an unknown algorithm
+             */
+            std::array<uint8_t, 20> fingerprint() const;
+
+            /**
+             *  Retrieve the key ID for this key
+             *
+             *  @return The 8-byte key ID
+             *  @throws std::runtime_error for secret keys with an unknown algorithm
+             */
+            std::array<uint8_t, 8> key_id() const;
+
+            /**
+             *  Convert to an owning key, copying the data
+             *
+             *  Converting a secret key to a public key type
+             *  yields only the public part of the key.
+             *
+             *  @return The key holding a copy of the data
+             *  @throws std::out_of_range, std::range_error
+             */
+            template <typename key_traits>
+            explicit operator basic_key<key_traits>() const
+            {
+                // decode the key from the referenced data
+                decoder parser{ _data };
+                return basic_key<key_traits>{ parser };
+            }
+
+            /**
+             *  Write the data to an encoder
+             *
+             *  @param  writer  The encoder to write to
+             *  @throws std::out_of_range, std::range_error
+             */
+            template <class encoder_t>
+            void encode(encoder_t&& writer) const
+            {
+                // write out the referenced data
+                writer.insert_blob(_data);
+            }
+        private:
+            packet_tag              _tag;                   // the tag of the packet holding the key
+            span<const uint8_t>     _data;                  // the complete encoded key
+            uint32_t                _creation_time;         // the UNIX timestamp the key was created at
+            key_algorithm           _algorithm;             // the algorithm for creating the key
+            span<const uint8_t>     _curve;                 // the curve identifier, for elliptic curve keys
+            std::array<mpi_view, 4> _integers;              // the integers in the public key
+            size_t                  _integer_count{ 0 };    // the number of integers used
+            span<const uint8_t>     _public_data;           // the algorithm-specific public key material
+            span<const uint8_t>     _secret_data;           // the secret key material
+            bool                    _unknown{ false };      // whether the key algorithm is unknown
+    };
+
+}
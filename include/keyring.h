@@ -0,0 +1,214 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <vector>
+#include "packet.h"
+#include "packet_scanner.h"
+#include "decoder.h"
+#include "decode_error.h"
+#include "memory_resource.h"
+#include "util/expected.h"
+#include "util/span.h"
+
+
+namespace pgp {
+
+    /**
+     *  Decode all the packets in a keyring
+     *
+     *  @param  data    The encoded keyring data
+     *  @return The decoded packets, in order
+     *  @throws std::runtime_error, std::out_of_range, std::range_error
+     */
+    std::vector<packet> decode_keyring(span<const uint8_t> data);
+
+    /**
+     *  Decode all the packets in a keyring, without raising
+     *  an exception when the data turns out to be malformed
+     *
+     *  @param  data    The encoded keyring data
+     *  @return The decoded packets, in order, or the first error encountered
+     */
+    expected<std::vector<packet>, decode_error> try_decode_keyring(span<const uint8_t> data);
+
+#ifdef PGP_HAS_MEMORY_RESOURCE
+
+    /**
+     *  Decode all the packets in a keyring, allocating the
+     *  packets and all data they hold from the given resource
+     *
+     *  Combined with a monotonic resource, the keyring is freed
+     *  in one go by releasing the resource, instead of freeing
+     *  all the data in every packet separately.
+     *
+     *  The resource must outlive the decoded packets. This also
+     *  holds for packets moved out of the result, since a moved
+     *  packet keeps its memory. Packets that must outlive the
+     *  resource have to be copied, copies use new and delete.
+     *
+     *  Only available when the standard library provides
+     *  memory resources, see PGP_HAS_MEMORY_RESOURCE.
+     *
+     *  @param  data        The encoded keyring data
+     *  @param  resource    The resource to allocate from
+     *  @return The decoded packets, in order
+     *  @throws std::runtime_error, std::out_of_range, std::range_error
+     */
+    resource_vector<packet> decode_keyring(span<const uint8_t> data, std::pmr::memory_resource &resource);
+
+    /**
+     *  Decode all the packets in a keyring, allocating from the
+     *  given resource, without raising an exception when the data
+     *  turns out to be malformed
+     *
+     *  @param  data        The encoded keyring data
+     *  @param  resource    The resource to allocate from
+     *  @return The decoded packets, in order, or the first error encountered
+     */
+    expected<resource_vector<packet>, decode_error> try_decode_keyring(span<const uint8_t> data, std::pmr::memory_resource &resource);
+
+#endif
+
+    /**
+     *  Decode all the packets in a keyring, spreading the
+     *  work over the threads of the given executor
+     *
+     *  The packet boundaries are located first, after which
+     *  batches of consecutive packets are decoded in parallel.
+     *  The result is identical to that of decode_keyring, and
+     *  when the data is invalid, the same error is raised.
+     *
+     *  The executor must provide an execute() method taking a
+     *  std::function<void()>, like the thread_pool class does.
+     *  The call blocks until all batches are decoded, so it
+     *  must not be made from a task running on the executor.
+     *  When the executor fails to accept a batch, the call waits
+     *  for the batches it did accept before raising the error.
+     *
+     *  @param  data        The encoded keyring data
+     *  @param  executor    The executor to run the batches on
+     *  @param  batch_size  The minimum number of bytes decoded by a single task
+     *  @return The decoded packets, in order
+     *  @throws std::runtime_error, std::out_of_range, std::range_error
+     *  @throws Any error raised by the executor
+     */
+    template <class executor_t>
+    std::vector<packet> decode_keyring_parallel(span<const uint8_t> data, executor_t &executor, size_t batch_size = 262144)
+    {
+        // a batch of consecutive packets to decode in a single task
+        struct batch
+        {
+            span<const packet_location> locations;  // the packets in the batch
+            std::vector<packet>         packets;    // the decoded packets
+            std::exception_ptr          error;      // the error raised while decoding
+        };
+
+        // the location of every packet in the data
+        std::vector<packet_location> locations;
+
+        // try to locate all the packets
+        try {
+            // scan over all the packet headers
+            locations = scan_packets(data);
+        } catch (const std::exception&) {
+            // the data is invalid, decoding it serially
+            // will raise exactly the right error
+            return decode_keyring(data);
+        }
+
+        // split the packets up in batches
+        std::vector<batch>  batches;
+        size_t              begin   = 0;
+        uint64_t            size    = 0;
+
+        // add packets to the batch until it is big enough
+        for (size_t i = 0; i < locations.size(); ++i) {
+            // add the size of this packet
+            size += locations[i].size();
+
+            // is the batch complete, or is this the last packet?
+            if (size >= batch_size || i + 1 == locations.size()) {
+                // create the batch with the packets so far
+                batches.push_back(batch{ span<const packet_location>{ locations.data() + begin, i + 1 - begin }, {}, {} });
+                begin   = i + 1;
+                size    = 0;
+            }
+        }
+
+        // the synchronization for waiting on the batches
+        std::mutex              mutex;
+        std::condition_variable condition;
+        size_t                  remaining = batches.size();
+
+        // start decoding all the batches
+        for (size_t i = 0; i < batches.size(); ++i) {
+            // the batch to decode
+            auto &current = batches[i];
+
+            // the executor may fail to accept the batch
+            try {
+                // decode the batch on the executor
+                executor.execute([&data, &current, &mutex, &condition, &remaining]() {
+                    // decoding may fail
+                    try {
+                        // decode every packet in the batch
+                        current.packets.reserve(current.locations.size());
+                        for (auto &location : current.locations) {
+                            // decode the packet from just its own data
+                            decoder parser{ data.subspan(location.offset, location.size()) };
+                            current.packets.emplace_back(parser);
+                        }
+                    } catch (...) {
+                        // store the error, so we can raise it later
+                        current.error = std::current_exception();
+                    }
+
+                    // register that the batch is done
+                    std::lock_guard<std::mutex> lock{ mutex };
+                    --remaining;
+                    condition.notify_all();
+                });
+            } catch (...) {
+                // this batch and the ones after it will never run
+                std::unique_lock<std::mutex> lock{ mutex };
+                remaining -= batches.size() - i;
+
+                // but the queued batches still refer to our data
+                condition.wait(lock, [&remaining]() { return remaining == 0; });
+                throw;
+            }
+        }
+
+        // wait for all batches to complete
+        {
+            std::unique_lock<std::mutex> lock{ mutex };
+            condition.wait(lock, [&remaining]() { return remaining == 0; });
+        }
+
+        // the packets from all the batches combined
+        std::vector<packet> result;
+        result.reserve(locations.size());
+
+        // process the batches in order
+        for (auto &current : batches) {
+            // an error in an earlier batch is what the serial decoder raises
+            if (current.error) {
+                // raise the error for the batch
+                std::rethrow_exception(current.error);
+            }
+
+            // add all the decoded packets
+            std::move(current.packets.begin(), current.packets.end(), std::back_inserter(result));
+        }
+
+        // return the decoded packets
+        return result;
+    }
+
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "decoder.h"
+#include "util/span.h"
+
+
+namespace pgp {
+
+    /**
+     *  Class providing read-only access to a keyring file,
+     *  by mapping it into memory instead of reading it.
+     *
+     *  Decoding from the mapping is backed directly by the
+     *  page cache, so packet views can borrow from it for as
+     *  long as the mapped keyring is kept alive.
+     */
+    class mapped_keyring
+    {
+        public:
+            /**
+             *  The expected pattern for accessing the data,
+             *  which is passed on to the kernel as a hint
+             */
+            enum class access_pattern
+            {
+                sequential,     // the data is read from start to end
+                random          // the data is read at random offsets
+            };
+
+            /**
+             *  Constructor
+             *
+             *  @param  path    The path of the keyring file to map
+             *  @param  pattern The expected access pattern
+             *  @throws std::system_error
+             */
+            explicit mapped_keyring(const std::string &path, access_pattern pattern = access_pattern::sequential);
+
+            /**
+             *  Constructor
+             *
+             *  @param  fd      The file descriptor of the keyring to map,
+             *                  which may be closed after construction
+             *  @param  pattern The expected access pattern
+             *  @throws std::system_error
+             */
+            explicit mapped_keyring(int fd, access_pattern pattern = access_pattern::sequential);
+
+            /**
+             *  The mapping is a move-only class
+             *
+             *  @param  that    The mapping to move
+             */
+            mapped_keyring(const mapped_keyring &that) = delete;
+            mapped_keyring(mapped_keyring &&that) noexcept;
+
+            /**
+             *  Destructor
+             */
+            ~mapped_keyring();
+
+            /**
+             *  Assignment operator, only using move
+             *
+             *  @param  that    The mapping to assign
+             */
+            mapped_keyring &operator=(const mapped_keyring &that) = delete;
+            mapped_keyring &operator=(mapped_keyring &&that) noexcept;
+
+            /**
+             *  Change the expected access pattern
+             *
+             *  @param  pattern The expected access pattern
+             */
+            void advise(access_pattern pattern) const noexcept;
+
+            /**
+             *  Retrieve the size of the mapped data
+             *
+             *  @return The number of bytes in the keyring
+             */
+            size_t size() const noexcept;
+
+            /**
+             *  Retrieve the mapped data
+             *
+             *  @return The range of mapped keyring data
+             */
+            span<const uint8_t> data() const noexcept;
+
+            /**
+             *  Create a decoder over the mapped data
+             *
+             *  @return The decoder to parse the keyring with
+             */
+            decoder parser() const noexcept;
+        private:
+            const uint8_t  *_data   { nullptr };    // the start of the mapping
+            size_t          _size   { 0 };          // the size of the mapping
+    };
+
+}
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// the standard library announces its memory resources in <version>,
+// which older libraries - like libstdc++ 8 - do not even provide
+#if __has_include(<version>)
+#include <version>
+#endif
+
+#if defined(__cpp_lib_memory_resource)
+#define PGP_HAS_MEMORY_RESOURCE
+#include <memory_resource>
+#endif
+
+
+namespace pgp {
+
+#ifdef PGP_HAS_MEMORY_RESOURCE
+
+    /**
+     *  The resource packet data may be allocated from
+     */
+    using memory_resource = std::pmr::memory_resource;
+
+#else
+
+    /**
+     *  The standard library provides no memory resources,
+     *  all packet data is allocated using new and delete
+     */
+    class memory_resource;
+
+#endif
+
+    /**
+     *  Class for allocating packet data from a memory resource
+     *
+     *  The resource is given explicitly, by the decoder that
+     *  creates the container. Without a resource - the default
+     *  - memory is allocated using new and delete. A copy of a
+     *  container always uses new and delete again, so that data
+     *  copied out of a keyring outlives the resource it was
+     *  decoded with. Moved containers keep their resource.
+     */
+    template <typename T>
+    class resource_allocator
+    {
+        public:
+            /**
+             *  Type aliases
+             */
+            using pointer       = T*;
+            using const_pointer = const T*;
+            using value_type    = T;
+
+            /**
+             *  Constructor
+             *
+             *  @note   Allocates memory using new and delete
+             */
+            resource_allocator() noexcept = default;
+
+            /**
+             *  Constructor
+             *
+             *  @param  resource    The resource to allocate from, if any
+             */
+            explicit resource_allocator(memory_resource *resource) noexcept :
+                _resource{ resource }
+            {}
+
+            /**
+             *  Constructor
+             *
+             *  Containers may rebind the allocator to another
+             *  type, which allocates from the same resource.
+             *
+             *  @param  that    The allocator to rebind
+             */
+            template <typename U>
+            resource_allocator(const resource_allocator<U> &that) noexcept :
+                _resource{ that.resource() }
+            {}
+
+            /**
+             *  Allocate memory for zero or more instances
+             *  of `value_type`. The instances will not be
+             *  initialized.
+             *
+             *  @param  count   Number of elements to allocate memory for
+             *  @return Pointer to the allocated memory
+             *  @throws std::bad_alloc
+             */
+            pointer allocate(size_t count)
+            {
+                // the number of bytes may not overflow
+                if (count > std::numeric_limits<size_t>::max() / sizeof(value_type)) {
+                    // we cannot allocate this much
+                    throw std::bad_alloc{};
+                }
+
+#ifdef PGP_HAS_MEMORY_RESOURCE
+                // allocate from the resource, if we were given one
+                if (_resource != nullptr) {
+                    // the resource provides the memory
+                    return static_cast<pointer>(_resource->allocate(count * sizeof(value_type), alignof(value_type)));
+                }
+#endif
+
+                // allocate using new
+                return std::allocator<value_type>{}.allocate(count);
+            }
+
+            /**
+             *  Free memory previously allocated using
+             *  this allocator. Does not destroy instances.
+             *
+             *  @param  address The address to free
+             *  @param  count   Number of elements the memory was allocated for
+             */
+            void deallocate(pointer address, size_t count) noexcept
+            {
+#ifdef PGP_HAS_MEMORY_RESOURCE
+                // was the memory allocated from a resource?
+                if (_resource != nullptr) {
+                    // give the memory back to the resource
+                    _resource->deallocate(address, count * sizeof(value_type), alignof(value_type));
+                    return;
+                }
+#endif
+
+                // free using delete
+                std::allocator<value_type>{}.deallocate(address, count);
+            }
+
+            /**
+             *  Retrieve the allocator for a copy of a container
+             *
+             *  @return An allocator using new and delete
+             */
+            resource_allocator select_on_container_copy_construction() const noexcept
+            {
+                // copies do not use the resource
+                return resource_allocator{};
+            }
+
+            /**
+             *  Retrieve the resource to allocate from
+             *
+             *  @return The memory resource, or a nullptr when using new and delete
+             */
+            memory_resource *resource() const noexcept
+            {
+                // return the resource
+                return _resource;
+            }
+
+            /**
+             *  Are we logically the same as the other
+             *  given allocator?
+             *
+             *  @return The result of the comparison
+             */
+            template <typename U>
+            bool operator==(const resource_allocator<U> &other) const noexcept
+            {
+                // allocators using the same resource are the same
+                if (_resource == other.resource()) {
+                    // memory can be freed by either one
+                    return true;
+                }
+
+#ifdef PGP_HAS_MEMORY_RESOURCE
+                // otherwise the resources have to agree
+                return _resource != nullptr && other.resource() != nullptr && _resource->is_equal(*other.resource());
+#else
+                // there is only new and delete
+                return false;
+#endif
+            }
+
+            template <typename U>
+            bool operator!=(const resource_allocator<U> &other) const noexcept { return !operator==(other); }
+        private:
+            memory_resource    *_resource   { nullptr };    // the resource to allocate from, if any
+    };
+
+    /**
+     *  Alias for a vector allocating from a resource
+     */
+    template <typename T>
+    using resource_vector = std::vector<T, resource_allocator<T>>;
+
+    /**
+     *  Create an empty container allocating from the given resource
+     *
+     *  Containers that use a different allocator - like secure
+     *  memory for secret key material - ignore the resource.
+     *
+     *  @param  resource    The resource to allocate from, if any
+     *  @return The empty container
+     */
+    template <class container_t>
+    container_t make_resource_container(memory_resource *resource) noexcept
+    {
+        // does the container allocate from a resource?
+        if constexpr (std::is_same_v<typename container_t::allocator_type, resource_allocator<typename container_t::value_type>>) {
+            // create it with the given resource
+            return container_t( resource_allocator<typename container_t::value_type>{ resource } );
+        } else {
+            // the container decides where to allocate
+            return container_t{};
+        }
+    }
+
+}
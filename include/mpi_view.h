@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "decoder_traits.h"
+#include "fixed_number.h"
+#include "multiprecision_integer.h"
+#include "util/span.h"
+
+
+namespace pgp {
+
+    /**
+     *  A view on an arbitrary-precision integer, referring
+     *  to the encoded data instead of holding a copy of it.
+     *
+     *  The view is only valid as long as the data it was
+     *  decoded from is kept alive.
+     */
+    class mpi_view
+    {
+        public:
+            /**
+             *  Constructor
+             */
+            mpi_view() = default;
+
+            /**
+             *  Constructor
+             *
+             *  @param  parser  The decoder to parse the data
+             *  @throws std::out_of_range
+             */
+            template <class decoder, class = std::enable_if_t<is_decoder_v<decoder>>>
+            explicit mpi_view(decoder &parser) :
+                _bits{ parser }
+            {
+                // the number is stored in bits, round up to the
+                // nearest byte and refer to the encoded data
+                _data = parser.template extract_blob<uint8_t>((_bits + 7) / 8);
+            }
+
+            /**
+             *  Comparison operators
+             *
+             *  @param  other   The object to compare with
+             */
+            bool operator==(const mpi_view &other) const noexcept;
+            bool operator!=(const mpi_view &other) const noexcept;
+
+            /**
+             *  Determine the size used in encoded format
+             *  @return The number of bytes used for encoded storage
+             */
+            size_t size() const noexcept;
+
+            /**
+             *  Retrieve the data
+             *  @return A span containing all the integer numbers
+             */
+            span<const uint8_t> data() const noexcept;
+
+            /**
+             *  Convert to an owning integer, copying the data
+             *  @return The integer holding a copy of the data
+             */
+            explicit operator multiprecision_integer() const;
+
+            /**
+             *  Write the data to an encoder
+             *
+             *  @param  writer  The encoder to write to
+             *  @throws std::out_of_range, std::range_error
+             */
+            template <class encoder_t>
+            void encode(encoder_t&& writer) const
+            {
+                // write out the number of bits and the data
+                _bits.encode(writer);
+                writer.insert_blob(_data);
+            }
+        private:
+            uint16              _bits;  // the number of bits in the integer
+            span<const uint8_t> _data;  // the encoded integer data
+    };
+
+}
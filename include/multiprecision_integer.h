@@ -1,27 +1,40 @@
 #pragma once
 
+#include <boost/container/small_vector.hpp>
 #include <cryptopp/integer.h>
 #include <cstddef>
 #include <cstdint>
 #include <type_traits>
 #include "decoder_traits.h"
 #include "fixed_number.h"
-#include "util/vector.h"
+#include "memory_resource.h"
+#include "secure_object.h"
 #include "util/span.h"
+#include "util/vector.h"
 
 
 namespace pgp {
 
     /**
      *  A class for working with arbitrary-precision integer numbers
+     *
+     *  The storage determines where the data is kept. Public values,
+     *  such as the public parameters of a key or a signature, use
+     *  ordinary memory, while secret values use secure memory.
+     *
+     *  Public integers keep small values - like curve points - inside
+     *  the object itself, only larger integers, as used by RSA, DSA
+     *  and ElGamal, are allocated separately. Secret integers always
+     *  keep their data in secure memory, never inside the object.
      */
-    class multiprecision_integer
+    template <class storage_t>
+    class basic_multiprecision_integer
     {
         public:
             /**
              *  Constructor
              */
-            multiprecision_integer() = default;
+            basic_multiprecision_integer() = default;
 
             /**
              *  Constructor
@@ -30,21 +43,17 @@ namespace pgp {
              *  @throws std::out_of_range
              */
             template <class decoder, class = std::enable_if_t<is_decoder_v<decoder>>>
-            explicit multiprecision_integer(decoder &parser) :
-                _bits{ parser }
+            explicit basic_multiprecision_integer(decoder &parser) :
+                _bits{ parser },
+                _data{ make_resource_container<storage_t>(parser.resource()) }
             {
                 // first read the number of elements, since it is in bits,
                 // we have to round it up to the nearest byte and read it
                 size_t count = (_bits + 7) / 8;
-        
-                // allocate memory for the number
-                _data.reserve(count);
-        
-                // and now read all the elements
-                while (_data.size() < count) {
-                    // add an element
-                    _data.push_back(parser.template extract_number<uint8_t>());
-                }
+
+                // and now copy all the elements at once
+                auto data = parser.template extract_blob<uint8_t>(count);
+                _data.assign(data.begin(), data.end());
             }
 
             /**
@@ -52,34 +61,58 @@ namespace pgp {
              *
              *  @param  that    The integer to copy or move
              */
-            multiprecision_integer(const multiprecision_integer &that) = default;
-            multiprecision_integer(multiprecision_integer &&that) = default;
+            basic_multiprecision_integer(const basic_multiprecision_integer &that);
+            basic_multiprecision_integer(basic_multiprecision_integer &&that);
+
+            /**
+             *  Constructor
+             *
+             *  Converting to ordinary storage must be done explicitly,
+             *  so that secret data cannot silently end up in memory
+             *  that is not secure. Copying into secure storage is
+             *  always safe, and may therefore be done implicitly.
+             *
+             *  @param  that    The integer with a different storage to copy
+             */
+            template <class other_t, std::enable_if_t<!std::is_same_v<other_t, storage_t> && is_secure_object<storage_t>::value, int> = 0>
+            basic_multiprecision_integer(const basic_multiprecision_integer<other_t> &that) :
+                _bits{ that._bits }
+            {
+                // copy the data into secure memory
+                _data.assign(that._data.begin(), that._data.end());
+            }
+
+            template <class other_t, std::enable_if_t<!std::is_same_v<other_t, storage_t> && !is_secure_object<storage_t>::value, int> = 0>
+            explicit basic_multiprecision_integer(const basic_multiprecision_integer<other_t> &that) :
+                _bits{ that._bits },
+                _data(that._data.begin(), that._data.end())
+            {}
 
             /**
              *  Constructor
              *
              *  @param  data    The range of numbers
              */
-            explicit multiprecision_integer(span<const uint8_t> data) noexcept;
+            explicit basic_multiprecision_integer(span<const uint8_t> data) noexcept;
 
             /**
              *  Constructor
              *
              *  @param  data    The range of numbers
              */
-            explicit multiprecision_integer(vector<uint8_t> data) noexcept;
+            explicit basic_multiprecision_integer(storage_t data) noexcept;
 
             /**
              *  Constructor
              *
              *  @param  integer The Crypto++ integer to convert
              */
-            explicit multiprecision_integer(const CryptoPP::Integer &integer) noexcept;
+            explicit basic_multiprecision_integer(const CryptoPP::Integer &integer) noexcept;
 
             /**
              *  Destructor
              */
-            ~multiprecision_integer() = default;
+            ~basic_multiprecision_integer() = default;
 
             /**
              *  Assignment
@@ -87,19 +120,19 @@ namespace pgp {
              *  @param  that    The integer to assign
              *  @return Same object for chaining
              */
-            multiprecision_integer &operator=(const multiprecision_integer &that) = default;
-            multiprecision_integer &operator=(multiprecision_integer &&that) = default;
-            multiprecision_integer &operator=(span<const uint8_t> data) noexcept;
-            multiprecision_integer &operator=(vector<uint8_t> data) noexcept;
-            multiprecision_integer &operator=(const CryptoPP::Integer &integer) noexcept;
+            basic_multiprecision_integer &operator=(const basic_multiprecision_integer &that) = default;
+            basic_multiprecision_integer &operator=(basic_multiprecision_integer &&that) = default;
+            basic_multiprecision_integer &operator=(span<const uint8_t> data) noexcept;
+            basic_multiprecision_integer &operator=(storage_t data) noexcept;
+            basic_multiprecision_integer &operator=(const CryptoPP::Integer &integer) noexcept;
 
             /**
              *  Comparison operators
              *
              *  @param  other   The object to compare with
              */
-            bool operator==(const multiprecision_integer &other) const noexcept;
-            bool operator!=(const multiprecision_integer &other) const noexcept;
+            bool operator==(const basic_multiprecision_integer &other) const noexcept;
+            bool operator!=(const basic_multiprecision_integer &other) const noexcept;
 
             /**
              *  Determine the size used in encoded format
@@ -131,15 +164,42 @@ namespace pgp {
                 // write out the number of elements first
                 _bits.encode(writer);
 
-                // now write out all the elements
-                for (auto number : _data) {
-                    // add the number
-                    writer.push(number);
-                }
+                // now write out all the elements at once
+                writer.insert_blob(span<const uint8_t>{ _data });
             }
         private:
-            uint16          _bits;
-            vector<uint8_t> _data;
+            // other storage types need access for conversion
+            template <class>
+            friend class basic_multiprecision_integer;
+
+            uint16      _bits;  // the number of bits in the integer
+            storage_t   _data;  // the big-endian data of the integer
     };
 
+    /**
+     *  The number of bytes stored without allocating, enough
+     *  for any point or scalar on the supported 256-bit curves
+     */
+    constexpr size_t multiprecision_inline_size = 72;
+
+    /**
+     *  Integers holding public values, in ordinary memory,
+     *  allocated from the resource of the decoder when decoded
+     */
+    using multiprecision_integer = basic_multiprecision_integer<
+        boost::container::small_vector<uint8_t, multiprecision_inline_size, resource_allocator<uint8_t>>
+    >;
+
+    /**
+     *  Integers holding secret values, in secure memory
+     *
+     *  The data is always allocated from the secure arena, so the
+     *  object itself holds no secret bytes and is not locked again.
+     */
+    using secret_multiprecision_integer = basic_multiprecision_integer<vector<uint8_t>>;
+
+    // the implementation is provided for these storage types
+    extern template class basic_multiprecision_integer<boost::container::small_vector<uint8_t, multiprecision_inline_size, resource_allocator<uint8_t>>>;
+    extern template class basic_multiprecision_integer<vector<uint8_t>>;
+
 }
@@ -1,3 +1,5 @@
+#pragma once
+
 #include <cryptopp/cryptlib.h>
 
 #if (CRYPTOPP_VERSION <= 600)
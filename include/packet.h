@@ -8,6 +8,10 @@
 
 #include "util/variant.h"
 #include "variable_number.h"
+#include "packet_header.h"
+#include "decode_error.h"
+#include "partial_body_decoder.h"
+#include "partial_body_encoder.h"
 #include "unknown_packet.h"
 #include "public_key.h"
 #include "secret_key.h"
@@ -50,63 +54,74 @@ namespace pgp {
             template <class decoder, class = std::enable_if_t<is_decoder_v<decoder>>>
             explicit packet(decoder &parser)
             {
-                // check whether we have the required true bit
-                if (!parser.extract_bits(1)) {
-                    // a bit that is required to be set is not set
-                    throw std::runtime_error{ "Invalid packet: Required header tag bit not set"};
-                }
-
-                // the packet tag we are processing and the size of it
-                packet_tag                  tag;
-                boost::optional<uint32_t>   size;
+                // decode the header to find the tag and size of the body
+                packet_header   header{ parser };
+                packet_tag      tag{ header.tag() };
+                auto           &size = header.size();
 
-                // is this a packet using the new formatting?
-                if (parser.extract_bits(1)) {
-                    // extract packet type and size
-                    tag  = packet_tag{ parser.extract_bits(6) };
-                    size = variable_number{ parser };
-                } else {
-                    // extract packet type
-                    tag = packet_tag{ parser.extract_bits(4) };
-
-                    // what length type do we have
-                    switch (parser.extract_bits(2)) {
-                        case 0: size = parser.template extract_number<uint8_t>();   break;
-                        case 1: size = parser.template extract_number<uint16_t>();  break;
-                        case 2: size = parser.template extract_number<uint32_t>();  break;
-                        case 3:  /* no size is known */                             break;
+                // decode the body using the given parser
+                auto decode_body = [this, tag](auto &body_parser) {
+                    // keys and signatures are only supported in version 4,
+                    // other versions are kept as raw data, just like packets
+                    // of a type we do not know
+                    switch (tag) {
+                        case packet_tag::signature:
+                        case packet_tag::secret_key:
+                        case packet_tag::public_key:
+                        case packet_tag::secret_subkey:
+                        case packet_tag::public_subkey:
+                            // check the version of the body
+                            if (body_parser.template peek_number<uint8_t>() != 4) {
+                                // store the raw data instead
+                                _body.emplace<unknown_packet>(tag, body_parser);
+                                return;
+                            }
+                            break;
+                        default:
+                            // other packets are not versioned
+                            break;
                     }
-                }
 
-                // create a parser to hold only the body data
-                // and a pointer to the parser we will use
-                decoder body_parser;
-                decoder *parser_ptr;
+                    // can we decode the packet?
+                    switch (tag) {
+                        case packet_tag::signature:     _body.emplace<signature>(body_parser);      break;
+                        case packet_tag::secret_key:    _body.emplace<secret_key>(body_parser);     break;
+                        case packet_tag::public_key:    _body.emplace<public_key>(body_parser);     break;
+                        case packet_tag::secret_subkey: _body.emplace<secret_subkey>(body_parser);  break;
+                        case packet_tag::user_id:       _body.emplace<user_id>(body_parser);        break;
+                        case packet_tag::public_subkey: _body.emplace<public_subkey>(body_parser);  break;
+                        default:
+                            // keep the raw data of the unknown packet
+                            _body.emplace<unknown_packet>(tag, body_parser);
+                            break;
+                    }
+                };
 
-                // if we have a known size, we splice off the data,
-                // otherwise we keep using the existing decoder
-                if (size) {
+                // if the body is split up in chunks, we first reassemble them,
+                // if we have a known size, we splice off the data, otherwise
+                // we keep using the existing decoder
+                if (size && size->is_partial()) {
+                    // only data packets may be split up in chunks
+                    if (!packet_tag_allows_partial_length(tag)) {
+                        // other packets - like keys - must have a definite length
+                        parser.fail(decode_error_kind::invalid_header, "Partial body lengths are only allowed for data packets");
+                    } else {
+                        // read all the chunks and decode the combined data
+                        partial_body_decoder body_parser{ parser, *size };
+                        decode_body(body_parser);
+                    }
+                } else if (size) {
                     // splice off the data and use the body parser
-                    body_parser = parser.splice(*size);
-                    parser_ptr  = &body_parser;
+                    auto body_parser = parser.splice(*size);
+                    decode_body(body_parser);
                 } else {
                     // we don't know the size, so we will use
                     // the entire, unrestrained parser instead
-                    parser_ptr  = &parser;
+                    decode_body(parser);
                 }
 
-                // can we decode the packet?
-                switch (tag) {
-                    case packet_tag::signature:     _body.emplace<signature>(*parser_ptr);      break;
-                    case packet_tag::secret_key:    _body.emplace<secret_key>(*parser_ptr);     break;
-                    case packet_tag::public_key:    _body.emplace<public_key>(*parser_ptr);     break;
-                    case packet_tag::secret_subkey: _body.emplace<secret_subkey>(*parser_ptr);  break;
-                    case packet_tag::user_id:       _body.emplace<user_id>(*parser_ptr);        break;
-                    case packet_tag::public_subkey: _body.emplace<public_subkey>(*parser_ptr);  break;
-                    default:
-                        // TODO
-                        break;
-                }
+                // the body is complete, so its size is known
+                _body_size = determine_body_size();
             }
 
             /**
@@ -117,7 +132,8 @@ namespace pgp {
              */
             template <class T, typename... Arguments>
             explicit packet(in_place_type_t<T>, Arguments&& ...parameters) :
-                _body{ in_place_type_t<T>{}, std::forward<Arguments>(parameters)... }
+                _body{ in_place_type_t<T>{}, std::forward<Arguments>(parameters)... },
+                _body_size{ determine_body_size() }
             {}
 
             /**
@@ -161,14 +177,8 @@ namespace pgp {
                 // write the required bit
                 writer.insert_bits(1, 1);
 
-                // retrieve the size of the body - we need to encode this in the header
-                uint32_t size;
-
-                // retrieve the body
-                visit([&size](auto &body) {
-                    // retrieve the size from the body
-                    size = util::narrow_cast<uint32_t>(body.size());
-                }, _body);
+                // the size of the body - we need to encode this in the header
+                uint32_t size = _body_size;
 
                 // can we encode the packet in the old format?
                 if (packet_tag_compatible_with_old_format(tag())) {
@@ -205,8 +215,42 @@ namespace pgp {
                     body.encode(writer);
                 }, body());
             }
+
+            /**
+             *  Write the data to an encoder, splitting up the
+             *  body in chunks using partial body lengths
+             *
+             *  Only data packets may be split up in chunks.
+             *
+             *  @param  writer      The encoder to write to
+             *  @param  chunk_size  The size of each chunk, a power of two of at least 512
+             *  @throws std::out_of_range, std::range_error
+             *  @throws std::invalid_argument if the packet is not a data packet
+             */
+            template <class encoder_t>
+            void encode(encoder_t&& writer, size_t chunk_size) const
+            {
+                // create the encoder, which writes a new-format header
+                partial_body_encoder<std::remove_reference_t<encoder_t>> body_writer{ writer, tag(), chunk_size };
+
+                // now retrieve the body
+                visit([&body_writer](auto &body) {
+                    // and encode it into the chunks
+                    body.encode(body_writer);
+                }, body());
+
+                // write out the final chunk
+                body_writer.flush();
+            }
         private:
-            packet_variant  _body;  // the decoded packet
+            /**
+             *  Determine the size of the body in encoded format
+             *  @return The number of bytes used for the body
+             */
+            uint32_t determine_body_size() const;
+
+            packet_variant  _body;                  // the decoded packet
+            uint32_t        _body_size  { 0 };      // the encoded size of the body
     };
 
 }
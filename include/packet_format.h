@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <boost/utility/string_view.hpp>
+
+
+namespace pgp {
+
+    /**
+     *  The formats used for encoding a packet header
+     *  @see https://tools.ietf.org/html/rfc4880#section-4.2
+     */
+    enum class packet_format : uint8_t
+    {
+        old_format  = 0,
+        new_format  = 1
+    };
+
+    /**
+     *  Get a description of the packet format
+     *
+     *  @param  format  The packet format to get a description for
+     *  @return The description of the packet format
+     */
+    constexpr boost::string_view packet_format_description(packet_format format) noexcept
+    {
+        // check the provided format
+        switch (format) {
+            case packet_format::old_format: return "old packet format";
+            case packet_format::new_format: return "new packet format";
+        }
+
+        // unknown format found
+        return "unknown packet format";
+    }
+
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <boost/optional.hpp>
+#include "decoder_traits.h"
+#include "decode_error.h"
+#include "packet_format.h"
+#include "packet_tag.h"
+#include "variable_number.h"
+
+
+namespace pgp {
+
+    /**
+     *  Class for decoding the header in front of every
+     *  packet, holding the packet tag and the body length
+     *  @see https://tools.ietf.org/html/rfc4880#section-4.2
+     */
+    class packet_header
+    {
+        public:
+            /**
+             *  Constructor
+             *
+             *  @param  parser  The decoder to parse the data
+             *  @throws std::runtime_error, std::out_of_range
+             */
+            template <class decoder, class = std::enable_if_t<is_decoder_v<decoder>>>
+            explicit packet_header(decoder &parser)
+            {
+                // check whether we have the required true bit
+                if (!parser.extract_bits(1)) {
+                    // a bit that is required to be set is not set
+                    parser.fail(decode_error_kind::invalid_header, "Invalid packet: Required header tag bit not set");
+                }
+
+                // is this a packet using the new formatting?
+                if (parser.extract_bits(1)) {
+                    // extract packet type and size
+                    _format = packet_format::new_format;
+                    _tag    = packet_tag{ parser.extract_bits(6) };
+                    _size   = variable_number{ parser };
+                } else {
+                    // extract packet type
+                    _format = packet_format::old_format;
+                    _tag    = packet_tag{ parser.extract_bits(4) };
+
+                    // what length type do we have
+                    switch (parser.extract_bits(2)) {
+                        case 0: _size = variable_number{ parser.template extract_number<uint8_t>() };   break;
+                        case 1: _size = variable_number{ parser.template extract_number<uint16_t>() };  break;
+                        case 2: _size = variable_number{ parser.template extract_number<uint32_t>() };  break;
+                        case 3:  /* no size is known */                                                 break;
+                    }
+                }
+            }
+
+            /**
+             *  Retrieve the format the header was encoded in
+             *
+             *  @return The packet format
+             */
+            packet_format format() const noexcept;
+
+            /**
+             *  Retrieve the packet tag
+             *  @return The packet tag, as described in https://tools.ietf.org/html/rfc4880#section-4.3
+             */
+            packet_tag tag() const noexcept;
+
+            /**
+             *  Retrieve the length of the body, or of the first chunk
+             *  of the body when the length is partial. Old-format
+             *  packets may have an indeterminate length, extending
+             *  to the end of the input, in which case nothing is set.
+             *
+             *  @return The body length, if known
+             */
+            const boost::optional<variable_number> &size() const noexcept;
+        private:
+            packet_format                       _format;    // the format of the header
+            packet_tag                          _tag;       // the tag of the packet
+            boost::optional<variable_number>    _size;      // the size of the (first chunk of the) body
+    };
+
+}
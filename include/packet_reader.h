@@ -0,0 +1,129 @@
+#pragma once
+
+#include <boost/optional.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include "util/vector.h"
+#include "util/span.h"
+#include "packet.h"
+
+
+namespace pgp {
+
+    /**
+     *  Class for reading packets one at a time from a source
+     *  of bytes, without requiring all input to be in memory.
+     *
+     *  Data is read into a refill buffer, which only grows in
+     *  case a single packet does not fit within it.
+     */
+    class packet_reader
+    {
+        public:
+            /**
+             *  The source to read data from, it should fill (part of)
+             *  the given range and return the number of bytes written,
+             *  returning zero once the input is exhausted.
+             */
+            using source_t = std::function<size_t(span<uint8_t>)>;
+
+            /**
+             *  The default size for the refill buffer
+             */
+            static constexpr size_t default_buffer_size = 65536;
+
+            /**
+             *  Constructor
+             *
+             *  @param  source          The source to read data from
+             *  @param  buffer_size     The initial size of the refill buffer
+             */
+            explicit packet_reader(source_t source, size_t buffer_size = default_buffer_size);
+
+            /**
+             *  Constructor
+             *
+             *  @param  fd              The file descriptor to read data from
+             *  @param  buffer_size     The initial size of the refill buffer
+             */
+            explicit packet_reader(int fd, size_t buffer_size = default_buffer_size);
+
+            /**
+             *  Constructor
+             *
+             *  @param  stream          The stream to read data from
+             *  @param  buffer_size     The initial size of the refill buffer
+             */
+            explicit packet_reader(std::istream &stream, size_t buffer_size = default_buffer_size);
+
+            /**
+             *  The reader is a move-only class
+             *
+             *  @param  that    The reader to move
+             */
+            packet_reader(const packet_reader &that) = delete;
+            packet_reader(packet_reader &&that) = default;
+
+            /**
+             *  Destructor
+             */
+            ~packet_reader() = default;
+
+            /**
+             *  Assignment operator, only using move
+             *
+             *  @param  that    The reader to assign
+             */
+            packet_reader &operator=(const packet_reader &that) = delete;
+            packet_reader &operator=(packet_reader &&that) = default;
+
+            /**
+             *  Read the next packet from the source
+             *
+             *  @return The decoded packet, or nothing when the input is exhausted
+             *  @throws std::out_of_range for truncated input, std::runtime_error
+             *          for malformed packets and std::system_error on read errors
+             */
+            boost::optional<packet> next();
+
+            /**
+             *  Retrieve the current size of the refill buffer
+             *
+             *  @return The number of bytes allocated for buffering
+             */
+            size_t buffer_size() const noexcept;
+        private:
+            /**
+             *  Retrieve the data currently buffered
+             *
+             *  @return The range of buffered, unconsumed data
+             */
+            span<const uint8_t> buffered() const noexcept;
+
+            /**
+             *  Ensure a number of bytes is buffered
+             *
+             *  @param  size    The number of bytes we require
+             *  @return Whether the requested number of bytes is available,
+             *          this is only false when the input is exhausted
+             *  @throws std::system_error
+             */
+            bool fill(size_t size);
+
+            /**
+             *  Buffer all remaining data from the input
+             *
+             *  @throws std::system_error
+             */
+            void fill_all();
+
+            source_t        _source;                // the source to read from
+            vector<uint8_t> _buffer;                // the refill buffer
+            size_t          _begin      { 0 };      // start of unconsumed data in the buffer
+            size_t          _end        { 0 };      // end of the valid data in the buffer
+            bool            _exhausted  { false };  // whether the source ran dry
+    };
+
+}
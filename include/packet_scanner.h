@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "packet_format.h"
+#include "packet_tag.h"
+#include "util/span.h"
+
+
+namespace pgp {
+
+    /**
+     *  The location of a single packet within encoded data
+     */
+    struct packet_location
+    {
+        uint64_t        offset;         // the offset of the packet header
+        uint64_t        body_size;      // the number of bytes following the header
+        uint8_t         header_size;    // the number of bytes in the header
+        packet_tag      tag;            // the tag of the packet
+        packet_format   format;         // the format used for the header
+
+        /**
+         *  Determine the total size of the encoded packet
+         *  @return The number of bytes used by the header and body
+         */
+        constexpr uint64_t size() const noexcept
+        {
+            // the body follows the header
+            return header_size + body_size;
+        }
+    };
+
+    /**
+     *  Find the location of all the packets in the given data
+     *
+     *  This only decodes the packet headers, the bodies are skipped
+     *  over without being parsed. For bodies using partial lengths,
+     *  the body size includes the lengths of all following chunks.
+     *
+     *  @param  data    The encoded packets to scan
+     *  @return The location of every packet, in order
+     *  @throws std::runtime_error for invalid headers
+     *          and std::out_of_range for truncated data
+     */
+    std::vector<packet_location> scan_packets(span<const uint8_t> data);
+
+}
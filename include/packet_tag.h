@@ -76,4 +76,31 @@ namespace pgp {
         return (0b11110000U & static_cast<typename std::underlying_type_t<packet_tag>>(tag)) == 0;
     }
 
+    /**
+     *  Check whether a packet tag may use partial body lengths
+     *
+     *  Only data packets - literal, compressed and encrypted
+     *  data - may be split up in chunks, all other packets
+     *  must be encoded with a definite length.
+     *
+     *  @param  tag     The packet tag to check
+     *  @return Can the body be encoded using partial lengths
+     *  @see https://tools.ietf.org/html/rfc4880#section-4.2.2.4
+     */
+    constexpr bool packet_tag_allows_partial_length(packet_tag tag) noexcept
+    {
+        // check the provided tag
+        switch (tag) {
+            case packet_tag::compressed_data:
+            case packet_tag::symmetrically_encrypted_data:
+            case packet_tag::literal_data:
+            case packet_tag::symmetrically_encrypted_and_integrity_protected_data:
+                // these are the data packets
+                return true;
+            default:
+                // everything else needs a definite length
+                return false;
+        }
+    }
+
 }
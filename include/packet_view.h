@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include "decoder_traits.h"
+#include "decode_error.h"
+#include "key_view.h"
+#include "packet.h"
+#include "packet_header.h"
+#include "packet_tag.h"
+#include "signature_view.h"
+#include "unknown_packet.h"
+#include "user_id_view.h"
+#include "util/span.h"
+#include "util/variant.h"
+
+
+namespace pgp {
+
+    /**
+     *  A view on a single packet, referring to the encoded
+     *  data instead of copying it into an owning packet.
+     *
+     *  Decoding a packet view allocates no memory. The view
+     *  is only valid as long as the data it was decoded from
+     *  is kept alive. Since the body data must be contiguous,
+     *  packets using partial body lengths cannot be viewed.
+     *
+     *  Packets that cannot be decoded hold an empty unknown
+     *  packet, their raw body is available from data().
+     */
+    class packet_view
+    {
+        public:
+            /**
+             *  The views on the packets we can decode
+             */
+            using view_variant = variant<
+                unknown_packet,
+                signature_view,
+                key_view,
+                user_id_view
+            >;
+
+            /**
+             *  Constructor
+             *
+             *  @param  parser  The decoder to parse the data
+             *  @throws std::runtime_error, std::out_of_range
+             */
+            template <class decoder, class = std::enable_if_t<is_decoder_v<decoder>>>
+            explicit packet_view(decoder &parser)
+            {
+                // decode the header to find the tag and size of the body
+                packet_header   header{ parser };
+                auto           &size = header.size();
+
+                // store the tag of the packet
+                _tag = header.tag();
+
+                // a body split up in chunks cannot be referred to as a whole
+                if (size && size->is_partial()) {
+                    // we would need to copy the data to reassemble it
+                    parser.fail(decode_error_kind::unsupported, "Packets using partial body lengths cannot be viewed");
+                }
+
+                // refer to the body data, which is either of known size or
+                // runs until the end of the data when there is no size
+                _data = parser.template extract_blob<uint8_t>(size ? *size : parser.size());
+
+                // keys and signatures are only supported in version 4,
+                // other versions are left as unknown packets
+                switch (_tag) {
+                    case packet_tag::signature:
+                    case packet_tag::secret_key:
+                    case packet_tag::public_key:
+                    case packet_tag::secret_subkey:
+                    case packet_tag::public_subkey:
+                        // check the version of the body
+                        if (!_data.empty() && _data[0] != 4) {
+                            // the raw data is available from data()
+                            return;
+                        }
+                        break;
+                    default:
+                        // other packets are not versioned
+                        break;
+                }
+
+                // can we decode the packet?
+                switch (_tag) {
+                    case packet_tag::signature:     _body.emplace<signature_view>(_data);   break;
+                    case packet_tag::secret_key:
+                    case packet_tag::public_key:
+                    case packet_tag::secret_subkey:
+                    case packet_tag::public_subkey: _body.emplace<key_view>(_tag, _data);   break;
+                    case packet_tag::user_id:       _body.emplace<user_id_view>(span<const char>{ reinterpret_cast<const char*>(_data.data()), _data.size() });   break;
+                    default:
+                        // the raw data is available from data()
+                        break;
+                }
+            }
+
+            /**
+             *  Comparison operators
+             *
+             *  @param  other   The object to compare with
+             */
+            bool operator==(const packet_view &other) const noexcept;
+            bool operator!=(const packet_view &other) const noexcept;
+
+            /**
+             *  Retrieve the packet tag
+             *  @return The packet tag, as described in https://tools.ietf.org/html/rfc4880#section-4.3
+             */
+            packet_tag tag() const noexcept;
+
+            /**
+             *  Retrieve the encoded body data
+             *
+             *  @return The referenced body of the packet
+             */
+            span<const uint8_t> data() const noexcept;
+
+            /**
+             *  Retrieve the decoded packet view
+             *
+             *  @return The view on the packet that was parsed
+             */
+            const view_variant &body() const noexcept;
+
+            /**
+             *  Convert to an owning packet, copying the data
+             *
+             *  @return The packet holding a copy of the data
+             *  @throws std::out_of_range, std::range_error
+             */
+            explicit operator packet() const;
+        private:
+            packet_tag          _tag;   // the tag of the packet
+            span<const uint8_t> _data;  // the encoded body data
+            view_variant        _body;  // the view on the decoded packet
+    };
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "decoder_traits.h"
+#include "variable_number.h"
+#include "decoder.h"
+
+
+namespace pgp {
+
+    /**
+     *  Class for decoding a packet body that was split
+     *  up in chunks, using partial body lengths.
+     *
+     *  The chunks are reassembled into a single range,
+     *  which can then be parsed like any regular body.
+     *
+     *  @see https://tools.ietf.org/html/rfc4880#section-4.2.2.4
+     */
+    class partial_body_decoder : public decoder
+    {
+        public:
+            /**
+             *  Constructor
+             *
+             *  The offset and the error reporting are taken over
+             *  from the parser, by way of an empty splice.
+             *
+             *  @param  parser  The decoder to read the chunks from
+             *  @param  length  The length of the first chunk, as read from the header
+             *  @throws std::out_of_range
+             */
+            template <class decoder_t, class = std::enable_if_t<is_decoder_v<decoder_t>>>
+            partial_body_decoder(decoder_t &parser, variable_number length) :
+                decoder{ parser.splice(0) }
+            {
+                // keep reading chunks until we reach the final one
+                while (true) {
+                    // splice off the chunk and copy over its data
+                    auto chunk_parser   = parser.splice(length);
+                    auto chunk          = chunk_parser.template extract_blob<uint8_t>(length);
+                    _data.insert(_data.end(), chunk.begin(), chunk.end());
+
+                    // the last chunk has a definite length
+                    if (!length.is_partial()) {
+                        // all chunks have been read
+                        break;
+                    }
+
+                    // read the length of the next chunk
+                    length = variable_number{ parser };
+                }
+
+                // decode from the reassembled data
+                replace(_data);
+            }
+        private:
+            std::vector<uint8_t>    _data;  // the reassembled body data
+    };
+
+}
@@ -0,0 +1,286 @@
+#pragma once
+
+#include <boost/endian/conversion.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "variable_number.h"
+#include "packet_tag.h"
+#include "util/contiguous.h"
+#include "util/span.h"
+
+
+namespace pgp {
+
+    /**
+     *  Class for encoding a packet body using partial body lengths,
+     *  so that the body can be written without knowing its size.
+     *
+     *  Data is collected in a buffer holding a single chunk, which
+     *  is written to the underlying encoder once it is filled up.
+     *  After all body data is pushed, flush() must be called to
+     *  write out the final chunk with a definite length.
+     *
+     *  @see https://tools.ietf.org/html/rfc4880#section-4.2.2.4
+     */
+    template <class encoder_t>
+    class partial_body_encoder
+    {
+        public:
+            /**
+             *  The smallest chunk size allowed, the first
+             *  partial length must be at least 512 octets
+             */
+            static constexpr const size_t minimum_chunk_size = 512;
+
+            /**
+             *  The largest chunk size that can be encoded
+             */
+            static constexpr const size_t maximum_chunk_size = 1U << 30;
+
+            /**
+             *  The default chunk size
+             */
+            static constexpr const size_t default_chunk_size = 65536;
+
+            /**
+             *  Constructor
+             *
+             *  @param  writer      The encoder to write the chunks to
+             *  @param  chunk_size  The size of each partial chunk, a power of two
+             *  @throws std::range_error
+             */
+            explicit partial_body_encoder(encoder_t &writer, size_t chunk_size = default_chunk_size) :
+                _writer{ writer },
+                _chunk_size{ chunk_size }
+            {
+                // the chunk size must be an encodable power of two
+                if (chunk_size < minimum_chunk_size || chunk_size > maximum_chunk_size || (chunk_size & (chunk_size - 1)) != 0) {
+                    // we cannot write chunks of this size
+                    throw std::range_error{ "Chunk size must be a power of two between 512 and 2^30" };
+                }
+
+                // reserve room for a single chunk
+                _buffer.reserve(chunk_size);
+            }
+
+            /**
+             *  Constructor
+             *
+             *  This writes a new-format packet header for the
+             *  given tag before any of the body data. Only data
+             *  packets may be split up in chunks.
+             *
+             *  @param  writer      The encoder to write the packet to
+             *  @param  tag         The tag of the packet to write
+             *  @param  chunk_size  The size of each partial chunk, a power of two
+             *  @throws std::out_of_range, std::range_error
+             *  @throws std::invalid_argument if the tag is not for a data packet
+             */
+            partial_body_encoder(encoder_t &writer, packet_tag tag, size_t chunk_size = default_chunk_size) :
+                partial_body_encoder{ writer, chunk_size }
+            {
+                // other packets - like keys - must have a definite length
+                if (!packet_tag_allows_partial_length(tag)) {
+                    // we cannot write this packet in chunks
+                    throw std::invalid_argument{ "Partial body lengths are only allowed for data packets" };
+                }
+
+                // partial lengths are only available in the new packet format
+                _writer.insert_bits(1, 1);
+                _writer.insert_bits(1, 1);
+                _writer.insert_bits(6, static_cast<typename std::underlying_type_t<packet_tag>>(tag));
+            }
+
+            /**
+             *  Retrieve the number of body bytes written
+             *  @return The number of bytes pushed to the encoder
+             */
+            size_t size() const noexcept
+            {
+                // we count both the written chunks and the buffered data
+                return _written + _buffer.size();
+            }
+
+            /**
+             *  Push a number to the encoder
+             *
+             *  @param  value   The number to push
+             *  @return self, for chaining
+             *  @throws std::out_of_range, std::range_error
+             */
+            template <typename T>
+            typename std::enable_if_t<std::numeric_limits<T>::is_integer, partial_body_encoder&>
+            push(T value)
+            {
+                // convert the value to big endian
+                auto result = boost::endian::native_to_big(static_cast<std::make_unsigned_t<T>>(value));
+
+                // and add the bytes of the number
+                return insert_blob(span<const uint8_t>{ reinterpret_cast<const uint8_t*>(&result), sizeof result });
+            }
+
+            /**
+             *  Insert an enum
+             *
+             *  @param  value   The enum to insert
+             *  @return self, for chaining
+             *  @throws std::out_of_range, std::range_error
+             */
+            template <typename T>
+            typename std::enable_if_t<std::is_enum<T>::value, partial_body_encoder&>
+            push(T value)
+            {
+                // cast it to a number and insert it
+                return push(static_cast<typename std::underlying_type_t<T>>(value));
+            }
+
+            /**
+             *  Push a range of data
+             *
+             *  @param  begin   The iterator to the beginning of the data
+             *  @param  end     The iterator to the end of the data
+             *  @return self, for chaining
+             *  @throws std::out_of_range, std::range_error
+             */
+            template <typename iterator_t>
+            partial_body_encoder &push(iterator_t begin, iterator_t end)
+            {
+                // do we have a contiguous range of bytes?
+                if constexpr (util::is_contiguous_byte_iterator_v<iterator_t>) {
+                    // push the whole range at once
+                    return insert_blob(util::make_span(begin, end));
+                } else {
+                    // iterate over the range
+                    while (begin != end) {
+                        // push the data
+                        push(*begin);
+
+                        // move to next element
+                        ++begin;
+                    }
+                }
+
+                // allow chaining
+                return *this;
+            }
+
+            /**
+             *  Insert a blob of data
+             *
+             *  @param  value   The data to insert
+             *  @return self, for chaining
+             *  @throws std::out_of_range, std::range_error
+             */
+            template <typename T>
+            partial_body_encoder &insert_blob(span<const T> value)
+            {
+                // process the data as raw bytes
+                span<const uint8_t> data{ reinterpret_cast<const uint8_t*>(value.data()), value.size() * sizeof(T) };
+
+                // keep going until all data is processed
+                while (!data.empty()) {
+                    // can we write a whole chunk without buffering it first?
+                    if (_buffer.empty() && static_cast<size_t>(data.size()) >= _chunk_size) {
+                        // write the chunk directly from the input
+                        write_chunk(data.first(_chunk_size), false);
+                        data = data.subspan(_chunk_size);
+                        continue;
+                    }
+
+                    // add as much data as still fits in the chunk
+                    auto count = std::min(static_cast<size_t>(data.size()), _chunk_size - _buffer.size());
+                    _buffer.insert(_buffer.end(), data.begin(), data.begin() + count);
+                    data = data.subspan(count);
+
+                    // is the chunk now complete?
+                    if (_buffer.size() == _chunk_size) {
+                        // write it out and start a new chunk
+                        write_chunk(_buffer, true);
+                        _buffer.clear();
+                    }
+                }
+
+                // allow chaining
+                return *this;
+            }
+
+            /**
+             *  Write out the buffered data as the final chunk, using a
+             *  definite length. No more data may be pushed afterwards.
+             *
+             *  @throws std::out_of_range, std::range_error
+             */
+            void flush()
+            {
+                // write the length of the last chunk, which may be empty
+                variable_number{ static_cast<uint32_t>(_buffer.size()) }.encode(_writer);
+                write_data(_buffer, true);
+
+                // register the written data
+                _written += _buffer.size();
+                _buffer.clear();
+            }
+        private:
+            /**
+             *  Check whether an encoder can be told to copy data
+             *  that it would otherwise keep a reference to
+             */
+            template <class writer_t, class = void>
+            struct has_copy_blob : std::false_type {};
+
+            template <class writer_t>
+            struct has_copy_blob<writer_t, std::void_t<decltype(std::declval<writer_t&>().copy_blob(std::declval<span<const uint8_t>>()))>> : std::true_type {};
+
+            /**
+             *  Write data to the underlying encoder
+             *
+             *  @param  data        The data to write
+             *  @param  buffered    Whether the data is in our buffer, which is reused
+             *  @throws std::out_of_range, std::range_error
+             */
+            void write_data(span<const uint8_t> data, bool buffered)
+            {
+                // does the encoder possibly refer to the data?
+                if constexpr (has_copy_blob<encoder_t>::value) {
+                    // our buffer is overwritten, so it must be copied
+                    if (buffered) {
+                        // let the encoder copy the data
+                        _writer.copy_blob(data);
+                        return;
+                    }
+                }
+
+                // the data may be inserted as is
+                _writer.insert_blob(data);
+            }
+
+            /**
+             *  Write a single, complete chunk with a partial length
+             *
+             *  @param  data        The chunk data to write
+             *  @param  buffered    Whether the data is in our buffer, which is reused
+             *  @throws std::out_of_range, std::range_error
+             */
+            void write_chunk(span<const uint8_t> data, bool buffered)
+            {
+                // write the partial length followed by the data
+                variable_number::partial(static_cast<uint32_t>(data.size())).encode(_writer);
+                write_data(data, buffered);
+
+                // register the written data
+                _written += data.size();
+            }
+
+            encoder_t              &_writer;                // the encoder to write chunks to
+            size_t                  _chunk_size;            // the size of each partial chunk
+            std::vector<uint8_t>    _buffer;                // the data for the current chunk
+            size_t                  _written    { 0 };      // the number of body bytes written out
+    };
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "hash_algorithm.h"
+#include "util/span.h"
+
+
+namespace pgp {
+
+    /**
+     *  Retrieve the DER encoded DigestInfo prefix for a hash algorithm
+     *
+     *  @param  algorithm   The hash algorithm used
+     *  @return The prefix to place before the digest
+     *  @throws pgp::unsupported_algorithm for unsupported hash algorithms
+     */
+    span<const uint8_t> digest_info_prefix(hash_algorithm algorithm);
+
+    /**
+     *  Encode a digest for an RSA signature, as described
+     *  by EMSA-PKCS1-v1_5: 00 01 FF .. FF 00, followed by the
+     *  DigestInfo prefix and the digest itself
+     *
+     *  @param  algorithm   The hash algorithm used for the digest
+     *  @param  digest      The digest to encode
+     *  @param  length      The size of the encoded message, which is the size of the modulus
+     *  @return The encoded message
+     *  @throws pgp::unsupported_algorithm for unsupported hash algorithms
+     *  @throws std::invalid_argument if the message is too short to hold the digest
+     */
+    std::vector<uint8_t> pkcs1_encode(hash_algorithm algorithm, span<const uint8_t> digest, size_t length);
+
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cryptopp/cryptlib.h>
+#include <sodium/crypto_stream_chacha20.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <sys/types.h>
+#include "util/span.h"
+
+
+namespace pgp {
+
+    /**
+     *  The random number generator used for making signatures
+     *
+     *  Every thread has its own generator, which is seeded from
+     *  the operating system when it is first used and reseeded
+     *  after a fixed amount of output. In between, the output is
+     *  taken from a ChaCha20 keystream, replacing the key every
+     *  time the buffer is refilled, so earlier output cannot be
+     *  recovered from the state. The state is kept in secure memory.
+     *
+     *  A child process created with fork() starts with a copy of the
+     *  state of its parent, so the generator is reseeded when it is
+     *  used from another process than the one that seeded it. This
+     *  prevents, for example, two processes from using the same ECDSA
+     *  nonce for different messages.
+     *
+     *  For testing, a generator can be given a fixed seed, after
+     *  which its output is fully determined by that seed until it
+     *  is reseeded from the operating system again.
+     */
+    class random_generator : public CryptoPP::RandomNumberGenerator
+    {
+        public:
+            /**
+             *  The size of the seed for deterministic output
+             */
+            constexpr static const size_t seed_size = crypto_stream_chacha20_ietf_KEYBYTES;
+
+            /**
+             *  The number of bytes generated before reseeding
+             */
+            constexpr static const size_t reseed_interval = 1 << 20;
+
+            /**
+             *  Retrieve the generator for the current thread
+             *
+             *  @return The random number generator
+             */
+            static random_generator &instance();
+
+            /**
+             *  The generator can be neither copied nor moved
+             *
+             *  @param  that    The generator to copy or move
+             */
+            random_generator(const random_generator &that) = delete;
+            random_generator(random_generator &&that) = delete;
+
+            /**
+             *  Assignment operator, the generator cannot be assigned
+             *
+             *  @param  that    The generator to assign
+             */
+            random_generator &operator=(const random_generator &that) = delete;
+            random_generator &operator=(random_generator &&that) = delete;
+
+            /**
+             *  Fill a buffer with random data
+             *
+             *  @param  output  The buffer to fill
+             *  @param  size    The number of bytes to generate
+             */
+            void GenerateBlock(CryptoPP::byte *output, size_t size) override;
+
+            /**
+             *  Mix additional data into the generator state
+             *
+             *  @param  input   The data to mix in
+             *  @param  length  The number of bytes to mix in
+             */
+            void IncorporateEntropy(const CryptoPP::byte *input, size_t length) override;
+
+            /**
+             *  Check whether additional data can be mixed in
+             *
+             *  @return Always true
+             */
+            bool CanIncorporateEntropy() const override;
+
+            /**
+             *  Make the output deterministic, for testing
+             *
+             *  @param  seed    The seed to generate output from
+             *  @throws std::invalid_argument if the seed has the wrong size
+             */
+            void seed(span<const uint8_t> seed);
+
+            /**
+             *  Reseed the generator from the operating system,
+             *  this also ends deterministic output
+             *
+             *  This also happens automatically after a fork().
+             */
+            void reseed() noexcept;
+
+            /**
+             *  Check whether the output is deterministic
+             *
+             *  @return Whether a fixed seed is in use
+             */
+            bool deterministic() const noexcept;
+        private:
+            /**
+             *  Constructor
+             */
+            random_generator();
+
+            /**
+             *  Refill the output buffer, replacing the key
+             */
+            void refill() noexcept;
+
+            /**
+             *  The generator state, which is kept in secure memory
+             */
+            struct state
+            {
+                std::array<uint8_t, seed_size>  key;                // the current keystream key
+                std::array<uint8_t, 480>        buffer;             // output not yet handed out
+                size_t                          available;          // number of bytes left in the buffer
+                size_t                          generated;          // number of bytes since the last reseed
+                bool                            deterministic;      // whether a fixed seed is in use
+                pid_t                           process;            // the process the generator was seeded in
+            };
+
+            std::shared_ptr<state>  _state;     // the state of the generator
+    };
+
+}
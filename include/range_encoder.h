@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <stdexcept>
 #include <type_traits>
+#include "util/contiguous.h"
 #include "util/span.h"
 #include <cstring>
 #include <limits>
@@ -126,39 +127,31 @@ namespace pgp {
             template <typename iterator_t>
             range_encoder &push(iterator_t begin, iterator_t end)
             {
-                // note: possible c++20 optimization
-                // // do we have a contiguous range of memory?
-                // if constexpr(std::is_same_v<std::iterator_traits<iterator_t>::iterator_category, std::contiguous_iterator_tag>) {
-                //     // make sure we have enough data for inserting the data
-                //     if (_data.size() < _size + sizeof(T) * value.size()) {
-                //         // trying to write out-of-bounds
-                //         throw std::out_of_range{ "Buffer too small for inserting blob" };
-                //     }
-                //
-                //     // push the whole range at once
-                //     std::memcpy(_data.data() + _size, value.data(), value.size() * sizeof(T));
-                //
-                //     // register the bytes in the buffer
-                //     _size += value.size() * sizeof(T);
-                // }
-
-                util::transaction transaction([this, size_val=_size, current_val=_current, skip_bits_val=_skip_bits]() {
-                    _size = size_val;
-                    _current = current_val;
-                    _skip_bits = skip_bits_val;
-                });
-
-                // iterate over the range
-                while (begin != end) {
-                    // push the data
-                    push(*begin);
-
-                    // move to next element
-                    ++begin;
+                // do we have a contiguous range of bytes?
+                if constexpr (util::is_contiguous_byte_iterator_v<iterator_t>) {
+                    // push the whole range at once, the bounds are
+                    // checked up front so nothing needs rolling back
+                    return insert_blob(util::make_span(begin, end));
+                } else {
+                    // restore the state from before the push on failure
+                    util::transaction transaction([this, size_val=_size, current_val=_current, skip_bits_val=_skip_bits]() {
+                        _size = size_val;
+                        _current = current_val;
+                        _skip_bits = skip_bits_val;
+                    });
+
+                    // iterate over the range
+                    while (begin != end) {
+                        // push the data
+                        push(*begin);
+
+                        // move to next element
+                        ++begin;
+                    }
+
+                    transaction.commit();
                 }
 
-                transaction.commit();
-
                 // allow chaining
                 return *this;
             }
@@ -25,7 +25,10 @@ namespace pgp {
                 _p{ parser },
                 _q{ parser },
                 _u{ parser }
-            {}
+            {
+                // derive the exponents for signing
+                derive_exponents();
+            }
 
             /**
              *  Constructor
@@ -35,7 +38,7 @@ namespace pgp {
              *  @param  q   The secret prime value q
              *  @param  u   The multiplicative inverse p mod q
              */
-            rsa_secret_key(multiprecision_integer d, multiprecision_integer p, multiprecision_integer q, multiprecision_integer u) noexcept;
+            rsa_secret_key(secret_multiprecision_integer d, secret_multiprecision_integer p, secret_multiprecision_integer q, secret_multiprecision_integer u) noexcept;
 
             /**
              *  Comparison operators
@@ -56,28 +59,44 @@ namespace pgp {
              *
              *  @return The secret exponent
              */
-            const multiprecision_integer &d() const noexcept;
+            const secret_multiprecision_integer &d() const noexcept;
 
             /**
              *  Retrieve the secret prime value p
              *
              *  @return The secret prime value p
              */
-            const multiprecision_integer &p() const noexcept;
+            const secret_multiprecision_integer &p() const noexcept;
 
             /**
              *  Retrieve the secret prime value q
              *
              *  @return The secret prime value q
              */
-            const multiprecision_integer &q() const noexcept;
+            const secret_multiprecision_integer &q() const noexcept;
 
             /**
              *  Retrieve the u value
              *
              *  @return The multiplicative inverse of p mod q
              */
-            const multiprecision_integer &u() const noexcept;
+            const secret_multiprecision_integer &u() const noexcept;
+
+            /**
+             *  Retrieve the exponent d mod (p - 1), which is
+             *  derived from the key to sign using the CRT
+             *
+             *  @return The derived exponent, empty when p, q and u are inconsistent
+             */
+            const secret_multiprecision_integer &dp() const noexcept;
+
+            /**
+             *  Retrieve the exponent d mod (q - 1), which is
+             *  derived from the key to sign using the CRT
+             *
+             *  @return The derived exponent, empty when p, q and u are inconsistent
+             */
+            const secret_multiprecision_integer &dq() const noexcept;
 
             /**
              *  Write the data to an encoder
@@ -95,10 +114,18 @@ namespace pgp {
                 _u.encode(writer);
             }
         private:
-             multiprecision_integer     _d;     // the secret exponent d
-             multiprecision_integer     _p;     // the secret prime value p
-             multiprecision_integer     _q;     // the secret prime value q
-             multiprecision_integer     _u;     // the multiplicative inverse p mod q
+            /**
+             *  Derive the exponents for the chinese remainder
+             *  theorem, when the primes allow it
+             */
+            void derive_exponents() noexcept;
+
+             secret_multiprecision_integer     _d;     // the secret exponent d
+             secret_multiprecision_integer     _p;     // the secret prime value p
+             secret_multiprecision_integer     _q;     // the secret prime value q
+             secret_multiprecision_integer     _u;     // the multiplicative inverse p mod q
+             secret_multiprecision_integer     _dp;    // the derived exponent d mod (p - 1)
+             secret_multiprecision_integer     _dq;    // the derived exponent d mod (q - 1)
     };
 
 }
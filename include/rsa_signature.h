@@ -3,8 +3,12 @@
 #include <cstddef>
 #include <type_traits>
 #include "multiprecision_integer.h"
+#include "util/span.h"
 #include "rsa_signature_encoder.h"
+#include "rsa_signature_signer.h"
+#include "rsa_signature_verifier.h"
 #include "decoder_traits.h"
+#include "hash_algorithm.h"
 
 
 namespace pgp {
@@ -16,6 +20,8 @@ namespace pgp {
     {
         public:
             using encoder_t = rsa_signature_encoder;
+            using signer_t = rsa_signature_signer;
+            using verifier_t = rsa_signature_verifier;
 
             /**
              *  Constructor
@@ -55,6 +61,20 @@ namespace pgp {
              */
             const multiprecision_integer &s() const noexcept;
 
+            /**
+             *  Verify the signature over a digest
+             *
+             *  The signature is checked against the PKCS #1 v1.5
+             *  encoding of the digest.
+             *
+             *  @param  key         The public key of the signer
+             *  @param  algorithm   The hash algorithm used for the digest
+             *  @param  digest      The digest that was signed
+             *  @return Whether the signature is valid
+             *  @throws std::runtime_error for unsupported hash algorithms
+             */
+            bool verify(const rsa_public_key &key, hash_algorithm algorithm, span<const uint8_t> digest) const;
+
             /**
              *  Write the data to an encoder
              *
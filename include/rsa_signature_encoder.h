@@ -1,160 +1,59 @@
 #pragma once
 
-#include <cryptopp/cryptlib.h>
-#include <cryptopp/osrng.h>
-#include <cryptopp/pkcspad.h>
-#include <cryptopp/pubkey.h>
-#include <cryptopp/rsa.h>
-#include <cryptopp/sha.h>
-#include <cstdint>
-#include <array>
-#include <boost/endian/conversion.hpp>
-#include <limits>
-#include <memory>
 #include <tuple>
-#include <type_traits>
-#include <utility>
 #include "basic_key.h"
 #include "basic_secret_key.h"
+#include "hash_encoder.h"
 #include "multiprecision_integer.h"
 #include "packet_tag.h"
 #include "rsa_public_key.h"
 #include "rsa_secret_key.h"
+#include "rsa_signature_signer.h"
 #include "secret_key.h"
-#include "util/span.h"
 
 
 namespace pgp {
 
     /**
-     *  Class for encoding data into an RSA signature
+     *  An encoder to produce RSA signatures
+     *
+     *  The data is hashed only once, the hash prefix is taken
+     *  from the resulting digest, which is then signed.
      */
-    class rsa_signature_encoder
+    class rsa_signature_encoder : public sha256_encoder
     {
-        private:
-            using signer_t = CryptoPP::RSASS<CryptoPP::PKCS1v15, CryptoPP::SHA256>::Signer;
-
         public:
             /**
-             *  Constructor
+             *  Create the encoder
+             *
+             *  @param key        The secret key with which to make the signature
              */
             template <packet_tag key_tag>
             explicit rsa_signature_encoder(const basic_key<secret_key_traits<key_tag>> &key) :
-                _signature_context{signer_t{}.NewSignatureAccumulator(_prng)},
-                rsa_key{get<basic_secret_key<rsa_public_key, rsa_secret_key>>(key.key())}
+                _signer{get<basic_secret_key<rsa_public_key, rsa_secret_key>>(key.key())}
             {}
 
             /**
-             *  Push a number to the encoder
-             *
-             *  @param  value   The number to push
-             *  @return self, for chaining
-             */
-            template <typename T>
-            typename std::enable_if_t<std::numeric_limits<T>::is_integer, rsa_signature_encoder&>
-            push(T value) noexcept
-            {
-                // convert the value to big endian
-                auto result = boost::endian::native_to_big(value);
-
-                // add it to the accumulators
-                insert_blob(span<const T>{&result, 1});
-
-                // allow chaining
-                return *this;
-            }
-
-            /**
-             *  Insert an enum
-             *
-             *  @param  value   The enum to insert
-             *  @return self, for chaining
-             */
-            template <typename T>
-            typename std::enable_if_t<std::is_enum<T>::value, rsa_signature_encoder&>
-            push(T value)
-            {
-                // cast it to a number and insert it
-                return push(static_cast<typename std::underlying_type_t<T>>(value));
-            }
-
-            /**
-             *  Push a range of data
+             *  Create the encoder
              *
-             *  @param  begin   The iterator to the beginning of the data
-             *  @param  end     The iterator to the end of the data
-             *  @return self, for chaining
+             *  @param signer     The prepared signer with which to make the signature
              */
-            template <typename iterator_t>
-            rsa_signature_encoder &push(iterator_t begin, iterator_t end)
-            {
-                // note: possible c++20 optimization
-                // // do we have a contiguous range of memory?
-                // if constexpr(std::is_same_v<std::iterator_traits<iterator_t>::iterator_category, std::contiguous_iterator_tag>) {
-                //     // push the whole range at once
-                //     insert_blob(span<const decltype(*begin)>{&(*begin), std::distance(begin, end)});
-                // }
-
-                // iterate over the range
-                while (begin != end) {
-                    // push the data
-                    push(*begin);
-
-                    // move to next element
-                    ++begin;
-                }
-
-                // allow chaining
-                return *this;
-            }
+            explicit rsa_signature_encoder(const rsa_signature_signer &signer) noexcept :
+                _signer{signer}
+            {}
 
             /**
-             *  Insert a blob of data
+             *  Make the signature
              *
-             *  @param  value   The data to insert
-             *  @return self, for chaining
+             *  @return The RSA s parameter of the signature
              */
-            template <typename T>
-            rsa_signature_encoder &insert_blob(span<const T> value)
-            {
-                // add the data to the accumulators
-                _signature_context->Update(reinterpret_cast<const uint8_t*>(value.data()), value.size() * sizeof(T));
-                _hash_context.Update      (reinterpret_cast<const uint8_t*>(value.data()), value.size() * sizeof(T));
-
-                // allow chaining
-                return *this;
-            }
+            std::tuple<multiprecision_integer> finalize();
 
+        private:
             /**
-             *  Retrieve the RSA s parameter of the final sigature
-             *
-             *  This method should be called *at most once*.
-             *
-             *  @return The signature of the data
+             *  The signer with which to make the signature
              */
-            std::tuple<pgp::multiprecision_integer> finalize() noexcept;
-
-            /**
-             *  Retrieve the hash prefix: the first two bytes of the hash
-             *
-             *  This method should be called *at most once*.
-             *
-             *  @return The two-byte prefix of the hash of the data
-             */
-            std::array<uint8_t, 2> hash_prefix() noexcept;
-
-        private:
-            // a random number generator for the message accumulator
-            CryptoPP::AutoSeededRandomPool _prng;
-
-            // accumulator context for the signature
-            std::unique_ptr<CryptoPP::PK_MessageAccumulator> _signature_context;
-
-            // accumulator context for the bare hash
-            CryptoPP::SHA256 _hash_context;
-
-            // key with which to make the signature
-            basic_secret_key<rsa_public_key, rsa_secret_key> rsa_key;
+            rsa_signature_signer _signer;
     };
 
 }
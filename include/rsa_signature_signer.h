@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cryptopp/rsa.h>
+#include <cstdint>
+#include <memory>
+#include "basic_secret_key.h"
+#include "multiprecision_integer.h"
+#include "rsa_public_key.h"
+#include "rsa_secret_key.h"
+#include "util/span.h"
+
+
+namespace pgp {
+
+    // Forward declaration to prevent header dependency cycles
+    class rsa_signature;
+
+    /**
+     *  Class for making RSA signatures with a single key
+     *
+     *  The key is converted once, into a Crypto++ private key, using
+     *  the chinese remainder theorem when the key allows it. Copies
+     *  of the signer share the same Crypto++ key, and the signer is
+     *  not modified when used, so it may make signatures from several
+     *  threads at once.
+     *
+     *  Only the Crypto++ key object itself is allocated in secure
+     *  memory. Crypto++ stores the integers of the key in buffers of
+     *  its own, which are wiped when released, but are not locked in
+     *  memory, so these may end up in swap.
+     */
+    class rsa_signature_signer
+    {
+        public:
+            /**
+             *  The signature type we make
+             */
+            using signature_t = rsa_signature;
+
+            /**
+             *  Constructor
+             *
+             *  @param  key     The secret key to sign with
+             */
+            explicit rsa_signature_signer(const basic_secret_key<rsa_public_key, rsa_secret_key> &key);
+
+            /**
+             *  Sign a SHA-256 digest
+             *
+             *  @param  digest  The digest to sign
+             *  @return The RSA s parameter of the signature
+             *  @throws std::invalid_argument if the key is too small for the digest
+             */
+            multiprecision_integer sign(span<const uint8_t> digest) const;
+        private:
+            std::shared_ptr<const CryptoPP::RSA::PrivateKey> _key;     // the prepared key
+    };
+
+}
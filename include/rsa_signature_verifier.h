@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cryptopp/integer.h>
+#include <cryptopp/rsa.h>
+#include <cstddef>
+#include <cstdint>
+#include "hash_algorithm.h"
+#include "rsa_public_key.h"
+#include "util/span.h"
+
+
+namespace pgp {
+
+    // Forward declaration to prevent header dependency cycles
+    class rsa_signature;
+
+    /**
+     *  Class for verifying RSA signatures made by a single key
+     *
+     *  The key is parsed once, so that it can be used to verify
+     *  many signatures. The verifier is not modified when used,
+     *  so it may verify signatures from several threads at once.
+     */
+    class rsa_signature_verifier
+    {
+        public:
+            /**
+             *  The signature type we verify
+             */
+            using signature_t = rsa_signature;
+
+            /**
+             *  Constructor
+             *
+             *  @param  key     The public key of the signer
+             */
+            explicit rsa_signature_verifier(const rsa_public_key &key);
+
+            /**
+             *  Verify a signature over a digest
+             *
+             *  The signature is checked against the PKCS #1 v1.5
+             *  encoding of the digest.
+             *
+             *  @param  signature   The signature to verify
+             *  @param  algorithm   The hash algorithm used for the digest
+             *  @param  digest      The digest that was signed
+             *  @return Whether the signature is valid
+             *  @throws pgp::unsupported_algorithm for unsupported hash algorithms
+             */
+            bool verify(const rsa_signature &signature, hash_algorithm algorithm, span<const uint8_t> digest) const;
+        private:
+            CryptoPP::RSA::PublicKey    _key;       // the parsed public key
+            size_t                      _length;    // the number of bytes in the modulus
+    };
+
+}
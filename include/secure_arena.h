@@ -0,0 +1,201 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+
+namespace pgp {
+
+    /**
+     *  Arena handing out locked memory for secret data
+     *
+     *  Memory is locked in large regions, so that it is never
+     *  paged out, and divided into chunks of a fixed size. This
+     *  avoids a system call for every single allocation, which
+     *  quickly adds up when creating many small secret values.
+     *
+     *  Released chunks are wiped in batches, before being handed
+     *  out again, and all chunks handed out are zero-initialized.
+     *  Larger allocations, and those that would exceed the budget
+     *  of locked memory, are not served by the arena.
+     *
+     *  Once none of the chunks in a region are in use any longer,
+     *  the region is unlocked and given back to the system, except
+     *  for the region chunks are currently being carved from, which
+     *  is given back once carving moves on to a new region.
+     */
+    class secure_arena
+    {
+        public:
+            /**
+             *  The size of the regions locked at once
+             */
+            static constexpr size_t region_size = 16384;
+
+            /**
+             *  The largest allocation served by the arena
+             */
+            static constexpr size_t max_chunk_size = 4096;
+
+            /**
+             *  The alignment of all chunks
+             */
+            static constexpr size_t alignment = 16;
+
+            /**
+             *  The number of released chunks wiped in one go
+             */
+            static constexpr size_t wipe_batch = 16;
+
+            /**
+             *  Constructor
+             *
+             *  The budget defaults to half the limit on locked memory
+             *  set for the process, leaving the rest for secure objects
+             *  that lock their own memory and for other libraries.
+             */
+            secure_arena();
+
+            /**
+             *  Constructor
+             *
+             *  @param  budget  The maximum number of bytes to lock
+             */
+            explicit secure_arena(size_t budget) noexcept;
+
+            /**
+             *  The arena cannot be copied or moved
+             */
+            secure_arena(const secure_arena &that) = delete;
+            secure_arena &operator=(const secure_arena &that) = delete;
+
+            /**
+             *  Destructor
+             *
+             *  All memory is wiped and unlocked, so no chunks may
+             *  be in use any longer.
+             */
+            ~secure_arena();
+
+            /**
+             *  Retrieve the arena used for secure allocations
+             *
+             *  @return The arena shared by the whole process
+             */
+            static secure_arena &instance();
+
+            /**
+             *  Allocate a wiped chunk of memory
+             *
+             *  @param  size    The number of bytes to allocate
+             *  @return The allocated memory, or nullptr when it
+             *          cannot be served by the arena
+             */
+            void *allocate(size_t size) noexcept;
+
+            /**
+             *  Release a chunk of memory
+             *
+             *  @param  address The address of the chunk
+             *  @param  size    The number of bytes that were allocated
+             *  @return Whether the chunk was allocated by this arena
+             */
+            bool deallocate(void *address, size_t size) noexcept;
+
+            /**
+             *  Wipe all released chunks now, instead of waiting
+             *  for enough of them to fill a batch
+             */
+            void wipe() noexcept;
+
+            /**
+             *  Retrieve the maximum number of bytes to lock
+             *  @return The budget of locked memory
+             */
+            size_t budget() const noexcept;
+
+            /**
+             *  Retrieve the number of bytes currently locked
+             *  @return The size of all regions
+             */
+            size_t locked() const noexcept;
+        private:
+            /**
+             *  A single locked region
+             */
+            struct region
+            {
+                uint8_t    *start;          // the start of the region
+                size_t      used;           // the number of chunks handed out
+            };
+
+            /**
+             *  Chunks of a single size
+             */
+            struct size_class
+            {
+                std::vector<void*>  available;          // the wiped chunks ready for use
+                std::vector<void*>  released;           // the chunks waiting to be wiped
+                size_t              carved      { 0 };  // the number of chunks carved
+            };
+
+            /**
+             *  Determine the size class to use for an allocation
+             *
+             *  @param  size    The number of bytes to allocate
+             *  @return The index of the size class
+             */
+            static size_t class_index(size_t size) noexcept;
+
+            /**
+             *  Wipe the released chunks in a size class, so
+             *  they become available again
+             *
+             *  @param  chunks  The size class to wipe
+             *  @param  size    The size of the chunks
+             */
+            static void wipe(size_class &chunks, size_t size) noexcept;
+
+            /**
+             *  Carve a new chunk from the current region,
+             *  locking a new region if necessary
+             *
+             *  @param  index   The size class to carve a chunk for
+             *  @return The new chunk, or nullptr when over budget
+             */
+            void *carve(size_t index) noexcept;
+
+            /**
+             *  Find the region an address is part of
+             *
+             *  @param  address The address to find
+             *  @return The region holding the address, or nullptr
+             *          if the address does not belong to the arena
+             */
+            region *find(const void *address) noexcept;
+
+            /**
+             *  Give a region that is no longer in use back to the system
+             *
+             *  @param  unused  The region to release
+             */
+            void release(region &unused) noexcept;
+
+            // the number of different chunk sizes, from the alignment up to the maximum size
+            static constexpr size_t class_count = 9;
+
+            // the size classes must cover all sizes up to the maximum
+            static_assert(alignment << (class_count - 1) == max_chunk_size);
+
+            mutable std::mutex                      _lock;                      // the lock protecting all state
+            std::array<size_class, class_count>     _classes;                   // the chunks of each size
+            std::vector<region>                     _regions;                   // the locked regions, sorted by address
+            uint8_t                                *_current    { nullptr };    // the region we are carving from
+            size_t                                  _carved     { 0 };          // number of bytes carved from the region
+            size_t                                  _budget;                    // the maximum number of bytes to lock
+    };
+
+}
@@ -1,12 +1,32 @@
 #pragma once
 
 #include <sodium/utils.h>
+#include <stdexcept>
+#include <type_traits>
+#include "allocator.h"
 
 
 namespace pgp {
 
+    /**
+     *  Determine whether an object keeps its contents in
+     *  memory obtained through the secure allocator
+     */
+    template <typename T, typename = void>
+    struct uses_secure_allocator : std::false_type {};
+
+    template <typename T>
+    struct uses_secure_allocator<T, std::void_t<typename T::allocator_type>> :
+        std::is_same<typename T::allocator_type, allocator<typename T::value_type>>
+    {};
+
     /**
      *  A class that explicitly locks and erases memory
+     *
+     *  When the object keeps its contents in memory from the
+     *  secure allocator, that memory is locked already, so the
+     *  object itself - which only refers to it - is not locked
+     *  again. It is still erased when it is destroyed.
      */
     template <typename base_t>
     class secure_object : public base_t
@@ -58,9 +78,14 @@ namespace pgp {
                 // first destruct the managed object
                 this->base_t::~base_t();
 
-                // zero out the memory and unlock it
+                // zero out the memory
                 sodium_memzero(this, sizeof(*this));
-                sodium_munlock(this, sizeof(*this));
+
+                // and unlock it, unless it was never locked
+                if constexpr (!uses_secure_allocator<base_t>::value) {
+                    // allow the memory to be swapped again
+                    sodium_munlock(this, sizeof(*this));
+                }
 
                 // default construct the base again
                 // so that the implicit destructor
@@ -99,13 +124,25 @@ namespace pgp {
              */
             void lock()
             {
-                // ensure the data is locked so it is
-                // not swapped to disk in low-memory
-                if (sodium_mlock(this, sizeof(*this)) == -1) {
-                    // failed to secure the memory
-                    throw std::runtime_error{ "Failed to lock memory, check ulimit" };
+                // no need to lock when the allocator locked the contents
+                if constexpr (!uses_secure_allocator<base_t>::value) {
+                    // ensure the data is locked so it is
+                    // not swapped to disk in low-memory
+                    if (sodium_mlock(this, sizeof(*this)) == -1) {
+                        // failed to secure the memory
+                        throw std::runtime_error{ "Failed to lock memory, check ulimit" };
+                    }
                 }
             }
     };
 
+    /**
+     *  Determine whether a type is a secure object
+     */
+    template <typename T>
+    struct is_secure_object : std::false_type {};
+
+    template <typename base_t>
+    struct is_secure_object<secure_object<base_t>> : std::true_type {};
+
 }
@@ -11,6 +11,7 @@
 #include "expected_number.h"
 #include "fixed_number.h"
 #include "hash_algorithm.h"
+#include "hash_encoder.h"
 #include "key_algorithm.h"
 #include "packet_tag.h"
 #include "rsa_signature.h"
@@ -18,6 +19,7 @@
 #include "decoder.h"
 #include "signature_subpacket_set.h"
 #include "signature_type.h"
+#include "signing_context.h"
 #include "unknown_signature.h"
 #include "decoder_traits.h"
 #include "user_id.h"
@@ -76,7 +78,8 @@ namespace pgp {
                         _signature.emplace<ecdsa_signature>(parser);
                         break;
                     default:
-                        // do nothing, use the unknown_key
+                        // keep the raw data of the unknown signature
+                        _signature.emplace<unknown_signature>(parser);
                         break;
                 }
             }
@@ -113,6 +116,17 @@ namespace pgp {
              */
             signature(const secret_key &bound_key, const user_id &user, signature_subpacket_set hashed_subpackets, signature_subpacket_set unhashed_subpackets);
 
+            /**
+             *  Constructor
+             *
+             *  @param  context                 The signing context, created for the bound key
+             *  @param  user                    The user id we are binding in the signature
+             *  @param  hashed_subpackets       The subpackets that will be used for generating the hash
+             *  @param  unhashed_subpackets     The subpackets that will not be hashed
+             *  @throws std::invalid_argument if the context was created for a subkey
+             */
+            signature(const signing_context &context, const user_id &user, signature_subpacket_set hashed_subpackets, signature_subpacket_set unhashed_subpackets);
+
             /**
              *  Constructor
              *
@@ -128,43 +142,40 @@ namespace pgp {
                 signature_subpacket_set hashed_subpackets,
                 signature_subpacket_set unhashed_subpackets
             ) :
-                _type{ secret_key_traits<signer_tag>::is_subkey()
-                            ? signature_type::primary_key_binding
-                            : signature_type::subkey_binding },
                 _key_algorithm{ signer.algorithm() },
                 _hash_algorithm{ hash_algorithm::sha256 },
                 _hashed_subpackets{ std::move(hashed_subpackets) },
                 _unhashed_subpackets{ std::move(unhashed_subpackets) }
             {
-                visit([&signer, &signee, this](auto &&key_instance) {
-                    // obtain the appropriate types
-                    using signature_t = typename std::decay_t<decltype(key_instance)>::signature_t;
-                    using encoder_t = typename signature_t::encoder_t;
-
-                    // construct the appropriate signature encoder
-                    encoder_t encoder{signer};
-
-                    // hash the keys; the main key always comes first
-                    if constexpr (!secret_key_traits<signer_tag>::is_subkey()) {
-                        // for a subkey binding, the main key is the signer
-                        signer.hash(encoder);
-                        signee.hash(encoder);
-                    } else {
-                        // for a primary key binding, the main key is the signee
-                        signee.hash(encoder);
-                        signer.hash(encoder);
-                    }
-
-                    // now hash the signature data itself
-                    hash_signature(encoder);
-
-                    // store the hash prefix
-                    _hash_prefix = decoder{encoder.hash_prefix()};
+                // sign the binding without a prepared key
+                sign_binding(nullptr, signer, signee);
+            }
 
-                    // Extra move was deemed worth it versus the monstrosity that would
-                    // be required to use std::apply here.
-                    _signature.emplace<signature_t>(util::make_from_tuple<signature_t>(encoder.finalize()));
-                }, signer.key());
+            /**
+             *  Constructor
+             *
+             *  @param  context                 The signing context, created for the key that certifies it owns/trusts another key
+             *  @param  signee                  The (usually sub-)key that belongs to the owner
+             *  @param  hashed_subpackets       The subpackets that will be used for generating the hash
+             *  @param  unhashed_subpackets     The subpackets that will not be hashed
+             */
+            template <typename signee_traits>
+            signature(
+                const signing_context &context,
+                const basic_key<signee_traits> &signee,
+                signature_subpacket_set hashed_subpackets,
+                signature_subpacket_set unhashed_subpackets
+            ) :
+                _key_algorithm{ context.algorithm() },
+                _hash_algorithm{ hash_algorithm::sha256 },
+                _hashed_subpackets{ std::move(hashed_subpackets) },
+                _unhashed_subpackets{ std::move(unhashed_subpackets) }
+            {
+                // sign the binding with the key from the context
+                visit([&context, &signee, this](auto &&signer) {
+                    // sign with the prepared key
+                    sign_binding(&context, signer, signee);
+                }, context.key());
             }
 
             /**
@@ -275,14 +286,17 @@ namespace pgp {
                     signature.encode(writer);
                 }, _signature);
             }
-        private:
+
             /**
              *  Hash the signature data
              *
+             *  This hashes the fields covered by the signature, and
+             *  the trailer, after the signed data has been hashed.
+             *
              *  @param  hash_encoder    The encoder to write to
              */
             template <class encoder_t>
-            void hash_signature(encoder_t&& hash_encoder)
+            void hash_signature(encoder_t&& hash_encoder) const
             {
                 // hash our own data
                 hash_encoder.push(version());
@@ -304,6 +318,113 @@ namespace pgp {
                     )
                 );
             }
+        private:
+            /**
+             *  Sign the certification of a user id
+             *
+             *  @param  context     The signing context created for the key, if any
+             *  @param  key         The key we are binding in the signature
+             *  @param  user        The user id we are binding in the signature
+             *  @throws std::runtime_error for unsupported key types
+             */
+            void sign_certification(const signing_context *context, const secret_key &key, const user_id &user);
+
+            /**
+             *  Sign the binding between a primary key and a subkey
+             *
+             *  @param  context     The signing context created for the signer, if any
+             *  @param  signer      The key that will certify it owns/trusts another key
+             *  @param  signee      The (usually sub-)key that belongs to the owner
+             *  @throws std::runtime_error for unsupported key types
+             */
+            template <packet_tag signer_tag, typename signee_traits>
+            void sign_binding(const signing_context *context, const basic_key<secret_key_traits<signer_tag>> &signer, const basic_key<signee_traits> &signee)
+            {
+                // a subkey signs the binding back to its primary key
+                _type = secret_key_traits<signer_tag>::is_subkey()
+                    ? signature_type::primary_key_binding
+                    : signature_type::subkey_binding;
+
+                visit([context, &signer, &signee, this](auto &&key_instance) {
+                    // obtain the appropriate signature type
+                    using signature_t = typename std::decay_t<decltype(key_instance)>::signature_t;
+
+                    // construct the appropriate signature encoder
+                    auto encoder = make_encoder<signature_t>(context, signer);
+
+                    // hash the keys; the main key always comes first
+                    if constexpr (!secret_key_traits<signer_tag>::is_subkey()) {
+                        // for a subkey binding, the main key is the signer
+                        hash_key(context, signer, encoder);
+                        signee.hash(encoder);
+                    } else {
+                        // for a primary key binding, the main key is the signee
+                        signee.hash(encoder);
+                        signer.hash(encoder);
+                    }
+
+                    // now hash the signature data itself
+                    hash_signature(encoder);
+
+                    // store the hash prefix
+                    _hash_prefix = decoder{encoder.hash_prefix()};
+
+                    // Extra move was deemed worth it versus the monstrosity that would
+                    // be required to use std::apply here.
+                    _signature.emplace<signature_t>(util::make_from_tuple<signature_t>(encoder.finalize()));
+                }, signer.key());
+            }
+
+            /**
+             *  Create the encoder for making a signature
+             *
+             *  @param  context     The signing context created for the key, if any
+             *  @param  key         The key to sign with
+             *  @return The encoder for the signature
+             *  @throws std::runtime_error for unsupported key types
+             */
+            template <class signature_t, class key_t>
+            static typename signature_t::encoder_t make_encoder(const signing_context *context, const key_t &key)
+            {
+                // can we use the prepared signer?
+                if constexpr (signing_context::has_signer<signature_t>::value) {
+                    // was the key prepared already?
+                    if (context != nullptr) {
+                        // create the encoder with the signer from the context
+                        return typename signature_t::encoder_t{ context->signer<typename signature_t::signer_t>() };
+                    }
+                }
+
+                // let the encoder prepare the key, or raise the error
+                return typename signature_t::encoder_t{ key };
+            }
+
+            /**
+             *  Hash the key that starts the signed data
+             *
+             *  When the signing context holds the hash state for the
+             *  key, the encoder continues from a copy of that state.
+             *
+             *  @param  context     The signing context created for the key, if any
+             *  @param  key         The key to hash
+             *  @param  encoder     The encoder to write to
+             */
+            template <class key_t, class encoder_t>
+            static void hash_key(const signing_context *context, const key_t &key, encoder_t &encoder)
+            {
+                // can the encoder continue from the stored state?
+                if constexpr (std::is_base_of_v<sha256_encoder, encoder_t>) {
+                    // was the key hashed already?
+                    if (auto *key_hash = context == nullptr ? nullptr : context->key_hash(); key_hash != nullptr) {
+                        // copy the hash state into the encoder
+                        static_cast<sha256_encoder&>(encoder) = *key_hash;
+                        return;
+                    }
+                }
+
+                // hash the key into the encoder
+                key.hash(encoder);
+            }
 
             expected_number<uint8_t, 4>         _version;               // the expected signature version format
             signature_type                      _type;                  // the signature type used
@@ -6,6 +6,7 @@
 #include <stdexcept>
 #include <type_traits>
 #include "../decoder_traits.h"
+#include "../decode_error.h"
 #include "../variable_number.h"
 #include "../signature_subpacket_type.h"
 #include "../util/narrow_cast.h"
@@ -33,7 +34,7 @@ namespace pgp::signature_subpacket {
                 // all data should be consumed
                 if (!parser.empty()) {
                     // this is probably not the correct subpacket type
-                    throw std::runtime_error{ "Incorrect subpacket type detected" };
+                    parser.fail(decode_error_kind::invalid_subpacket, "Incorrect subpacket type detected");
                 }
             }
 
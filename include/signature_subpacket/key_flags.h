@@ -26,7 +26,7 @@ namespace pgp::signature_subpacket {
                 // all data should be consumed
                 if (!parser.empty()) {
                     // this is probably not the correct subpacket type
-                    throw std::runtime_error{ "Incorrect subpacket type detected" };
+                    parser.fail(decode_error_kind::invalid_subpacket, "Incorrect subpacket type detected");
                 }
             }
 
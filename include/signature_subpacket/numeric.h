@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../signature_subpacket_type.h"
+#include "../decode_error.h"
 #include "../variable_number.h"
 #include "../fixed_number.h"
 
@@ -26,7 +27,7 @@ namespace pgp::signature_subpacket {
                 // all data should be consumed
                 if (!parser.empty()) {
                     // this is probably not the correct subpacket type
-                    throw std::runtime_error{ "Incorrect subpacket type detected" };
+                    parser.fail(decode_error_kind::invalid_subpacket, "Incorrect subpacket type detected");
                 }
             }
 
@@ -6,6 +6,7 @@
 #include "../hash_algorithm.h"
 #include "../variable_number.h"
 #include "../fixed_number.h"
+#include "../memory_resource.h"
 #include <vector>
 
 
@@ -25,7 +26,8 @@ namespace pgp::signature_subpacket {
              *  @param  parser  The parser to decode the data
              */
             template <class decoder, class = std::enable_if_t<is_decoder_v<decoder>>>
-            explicit preferred_algorithms(decoder &parser)
+            explicit preferred_algorithms(decoder &parser) :
+                _data( resource_allocator<algorithm>{ parser.resource() } )
             {
                 // allocate memory for the data
                 _data.reserve(parser.size());
@@ -43,7 +45,7 @@ namespace pgp::signature_subpacket {
              *  @param  data    The data to store
              */
             explicit preferred_algorithms(std::vector<algorithm> data) :
-                _data{ std::move(data) }
+                _data( data.begin(), data.end() )
             {}
 
             /**
@@ -123,7 +125,7 @@ namespace pgp::signature_subpacket {
                 }
             }
         private:
-            std::vector<algorithm>  _data;
+            resource_vector<algorithm>  _data;
     };
 
     /**
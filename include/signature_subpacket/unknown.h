@@ -2,9 +2,9 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <vector>
 #include <type_traits>
 #include "../decoder_traits.h"
+#include "../memory_resource.h"
 #include "../signature_subpacket_type.h"
 #include "../variable_number.h"
 #include "../util/span.h"
@@ -26,16 +26,12 @@ namespace pgp::signature_subpacket {
              */
             template <class decoder, class = std::enable_if_t<is_decoder_v<decoder>>>
             unknown(signature_subpacket_type type, decoder &parser) :
-                _type{ type }
+                _type{ type },
+                _data( resource_allocator<uint8_t>{ parser.resource() } )
             {
-                // reserve memory for the data
-                _data.reserve(parser.size());
-        
-                // and fill the buffer
-                while (!parser.empty()) {
-                    // add another byte
-                    _data.push_back(parser.template extract_number<uint8_t>());
-                }
+                // copy all the remaining data at once
+                auto data = parser.template extract_blob<uint8_t>(parser.size());
+                _data.assign(data.begin(), data.end());
             }
 
             /**
@@ -87,15 +83,12 @@ namespace pgp::signature_subpacket {
                 // add the subpacket type
                 writer.push(_type);
 
-                // now go over the whole data set
-                for (auto number : _data) {
-                    // add the number
-                    writer.push(number);
-                }
+                // now add the whole data set
+                writer.insert_blob(span<const uint8_t>{ _data });
             }
         private:
             signature_subpacket_type    _type;
-            std::vector<uint8_t>        _data;
+            resource_vector<uint8_t>    _data;
     };
 
 }
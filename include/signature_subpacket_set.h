@@ -1,5 +1,6 @@
 #pragma once
 
+#include "decode_error.h"
 #include "signature_subpacket/preferred_algorithms.h"
 #include "signature_subpacket/issuer_fingerprint.h"
 #include "signature_subpacket/fixed_array.h"
@@ -8,6 +9,8 @@
 #include "signature_subpacket/unknown.h"
 #include "signature_subpacket/numeric.h"
 #include "signature_subpacket_type.h"
+#include "memory_resource.h"
+#include "variable_number.h"
 #include "util/variant.h"
 
 
@@ -49,22 +52,29 @@ namespace pgp {
              *  @param  parser      The decoder to parse the data
              */
             template <class decoder, class = std::enable_if_t<is_decoder_v<decoder>>>
-            explicit signature_subpacket_set(decoder &parser)
+            explicit signature_subpacket_set(decoder &parser) :
+                _subpackets( resource_allocator<subpacket_variant>{ parser.resource() } )
             {
                 // splice off the allocated data from the main parser
                 auto set_parser = parser.splice(uint16{ parser });
 
                 // now read all the data in the subpackets
                 while (!set_parser.empty()) {
-                    // read the length and type of the subpacket
-                    uint32_t length = variable_number           { set_parser                                    };
-                    auto     type   = signature_subpacket_type  { set_parser.template extract_number<uint8_t>() };
+                    // read the length of the subpacket
+                    variable_number length{ set_parser };
 
-                    // the length includes the type - which we already parsed
-                    --length;
+                    // subpackets cannot be split up in chunks
+                    if (length.is_partial()) {
+                        // this is not a valid subpacket length
+                        set_parser.fail(decode_error_kind::invalid_subpacket, "Invalid subpacket: partial lengths are not allowed");
+                    }
+
+                    // read the type of the subpacket
+                    auto type = signature_subpacket_type{ set_parser.template extract_number<uint8_t>() };
 
-                    // now create a parser specially for the packet
-                    auto subpacket_parser = set_parser.splice(length);
+                    // now create a parser specially for the packet, the
+                    // length includes the type - which we already parsed
+                    auto subpacket_parser = set_parser.splice(length - 1);
 
                     // what subpacket type are we creating?
                     switch (type) {
@@ -114,6 +124,9 @@ namespace pgp {
                             break;
                     }
                 }
+
+                // all subpackets are read, so the size is known
+                _size = determine_size();
             }
 
             /**
@@ -187,7 +200,14 @@ namespace pgp {
                 }
             }
         private:
-            std::vector<subpacket_variant>  _subpackets;    // the subpackets in the set
+            /**
+             *  Determine the size used in encoded format
+             *  @return The number of bytes used for encoded storage
+             */
+            size_t determine_size() const noexcept;
+
+            resource_vector<subpacket_variant>  _subpackets;                    // the subpackets in the set
+            size_t                              _size       { uint16::size() }; // the encoded size of the set
     };
 
 }
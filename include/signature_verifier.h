@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cryptopp/sha.h>
+#include <cstdint>
+#include <type_traits>
+#include "basic_key.h"
+#include "ecdsa_signature_verifier.h"
+#include "eddsa_signature_verifier.h"
+#include "hash_algorithm.h"
+#include "hash_encoder.h"
+#include "key_algorithm.h"
+#include "rsa_signature_verifier.h"
+#include "signature.h"
+#include "unsupported_algorithm.h"
+#include "util/span.h"
+#include "util/variant.h"
+
+
+namespace pgp {
+
+    /**
+     *  Class for verifying signatures made by a single key
+     *
+     *  The key is prepared once, when the verifier is created,
+     *  after which many signatures can be verified with it. The
+     *  verifier is not modified when used, so it may verify
+     *  signatures from several threads at once.
+     *
+     *  The signed data is passed as a context, which must provide
+     *  an accepts() method to check whether a signature type signs
+     *  the data, and a hash() method to hash the data.
+     */
+    class signature_verifier
+    {
+        public:
+            /**
+             *  The verifiers for the supported key algorithms
+             */
+            using verifier_variant = variant<
+                monostate,
+                rsa_signature_verifier,
+                eddsa_signature_verifier,
+                ecdsa_signature_verifier
+            >;
+
+            /**
+             *  Constructor
+             *
+             *  @param  key     The key that made the signatures
+             */
+            template <class key_traits>
+            explicit signature_verifier(const basic_key<key_traits> &key) :
+                _algorithm{ key.algorithm() }
+            {
+                // prepare the key, if we can verify signatures made with it
+                visit([this](auto &&key_instance) {
+                    // obtain the appropriate signature type
+                    using signature_t = typename std::decay_t<decltype(key_instance)>::signature_t;
+
+                    // does the signature come with a verifier?
+                    if constexpr (has_verifier<signature_t>::value) {
+                        // create the verifier for the key
+                        _verifier.emplace<typename signature_t::verifier_t>(key_instance);
+                    }
+                }, key.key());
+            }
+
+            /**
+             *  Verify a signature over the given data
+             *
+             *  @param  sig         The signature to verify
+             *  @param  context     The signed data
+             *  @return Whether the signature is valid
+             *  @throws pgp::unsupported_algorithm for unsupported algorithms
+             */
+            template <class context_t>
+            bool verify(const signature &sig, const context_t &context) const
+            {
+                // the signature must be of the right type, made by the right kind of key
+                if (!context.accepts(sig.type()) || sig.public_key_algorithm() != _algorithm) {
+                    // this cannot be a valid signature
+                    return false;
+                }
+
+                // do we support the key algorithm?
+                if (holds_alternative<monostate>(_verifier)) {
+                    // then there is no need to hash anything
+                    throw unsupported_algorithm{ "Unsupported key algorithm for verifying signatures" };
+                }
+
+                // hash with the algorithm used for the signature
+                switch (sig.hashing_algorithm()) {
+                    case hash_algorithm::sha1:      return verify<CryptoPP::SHA1>(sig, context);
+                    case hash_algorithm::sha224:    return verify<CryptoPP::SHA224>(sig, context);
+                    case hash_algorithm::sha256:    return verify<CryptoPP::SHA256>(sig, context);
+                    case hash_algorithm::sha384:    return verify<CryptoPP::SHA384>(sig, context);
+                    case hash_algorithm::sha512:    return verify<CryptoPP::SHA512>(sig, context);
+                    default:                        break;
+                }
+
+                // we do not support this hash algorithm
+                throw unsupported_algorithm{ "Unsupported hash algorithm for verifying signatures" };
+            }
+        private:
+            /**
+             *  Check whether a signature type comes with a verifier
+             */
+            template <class signature_t, class = void>
+            struct has_verifier : std::false_type {};
+
+            template <class signature_t>
+            struct has_verifier<signature_t, std::void_t<typename signature_t::verifier_t>> : std::true_type {};
+
+            /**
+             *  Verify a signature over the given data, using a specific hash
+             *
+             *  @param  sig         The signature to verify
+             *  @param  context     The signed data
+             *  @return Whether the signature is valid
+             *  @throws pgp::unsupported_algorithm for unsupported algorithms
+             */
+            template <class hasher_t, class context_t>
+            bool verify(const signature &sig, const context_t &context) const
+            {
+                // hash the signed data, followed by the signature itself
+                hash_encoder<hasher_t> encoder;
+                context.hash(encoder);
+                sig.hash_signature(encoder);
+
+                // retrieve the digest to verify
+                auto digest = encoder.digest();
+
+                // the prefix is checked before doing any expensive math
+                if (static_cast<uint16_t>(digest[0] << 8 | digest[1]) != sig.hash_prefix()) {
+                    // the signature was made over different data
+                    return false;
+                }
+
+                // now verify the digest itself
+                return verify_digest(sig, digest);
+            }
+
+            /**
+             *  Verify the signature over a digest
+             *
+             *  @param  sig         The signature to verify
+             *  @param  digest      The digest of the signed data
+             *  @return Whether the signature is valid
+             *  @throws pgp::unsupported_algorithm for unsupported algorithms
+             */
+            bool verify_digest(const signature &sig, span<const uint8_t> digest) const;
+
+            key_algorithm       _algorithm;     // the algorithm of the key
+            verifier_variant    _verifier;      // the verifier for the key, if supported
+    };
+
+}
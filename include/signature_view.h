@@ -0,0 +1,185 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "decoder_traits.h"
+#include "hash_algorithm.h"
+#include "key_algorithm.h"
+#include "mpi_view.h"
+#include "packet_tag.h"
+#include "signature.h"
+#include "signature_type.h"
+#include "util/narrow_cast.h"
+#include "util/span.h"
+
+
+namespace pgp {
+
+    /**
+     *  A view on a signature, referring to the encoded
+     *  data instead of holding a copy of it.
+     *
+     *  The subpackets are available as raw ranges, the
+     *  signature values are split into their integers.
+     *  The view is only valid as long as the data it was
+     *  decoded from is kept alive.
+     */
+    class signature_view
+    {
+        public:
+            /**
+             *  Constructor
+             *
+             *  @param  parser  The decoder to parse the data
+             *  @throws std::out_of_range, std::range_error
+             */
+            template <class decoder, class = std::enable_if_t<is_decoder_v<decoder>>>
+            explicit signature_view(decoder &parser) :
+                signature_view{ parser.template extract_blob<uint8_t>(parser.size()) }
+            {}
+
+            /**
+             *  Constructor
+             *
+             *  @param  data    The encoded signature data to refer to
+             *  @throws std::out_of_range, std::range_error
+             */
+            explicit signature_view(span<const uint8_t> data);
+
+            /**
+             *  Comparison operators
+             *
+             *  @param  other   The object to compare with
+             */
+            bool operator==(const signature_view &other) const noexcept;
+            bool operator!=(const signature_view &other) const noexcept;
+
+            /**
+             *  Retrieve the packet tag used for this
+             *  packet type
+             *  @return The packet type to use
+             */
+            static constexpr packet_tag tag() noexcept
+            {
+                // this is a signature packet
+                return packet_tag::signature;
+            }
+
+            /**
+             *  Determine the size used in encoded format
+             *  @return The number of bytes used for encoded storage
+             */
+            size_t size() const noexcept;
+
+            /**
+             *  Get the signature version
+             *  @return The signature version format
+             */
+            constexpr uint8_t version() const noexcept
+            {
+                // we only support version 4 signatures
+                return 4;
+            }
+
+            /**
+             *  Get the signature type
+             *  @return The type of signature
+             */
+            signature_type type() const noexcept;
+
+            /**
+             *  Get the used key algorithm
+             *
+             *  @return The public key algorithm
+             */
+            key_algorithm public_key_algorithm() const noexcept;
+
+            /**
+             *  Get the used hashing algorithm
+             *
+             *  @return The hashing algorithm
+             */
+            hash_algorithm hashing_algorithm() const noexcept;
+
+            /**
+             *  Retrieve the encoded hashed subpackets
+             *
+             *  @return The hashed subpacket data
+             */
+            span<const uint8_t> hashed_subpackets() const noexcept;
+
+            /**
+             *  Retrieve the encoded unhashed subpackets
+             *
+             *  @return The unhashed subpacket data
+             */
+            span<const uint8_t> unhashed_subpackets() const noexcept;
+
+            /**
+             *  Retrieve the 16 most significant bits from the signed hash
+             *
+             *  @return Two bytes of hash data
+             */
+            uint16_t hash_prefix() const noexcept;
+
+            /**
+             *  Retrieve the integers making up the signature,
+             *  e.g. s for RSA or r and s for (EC)DSA and EdDSA
+             *
+             *  @return The signature integers
+             */
+            span<const mpi_view> integers() const noexcept;
+
+            /**
+             *  Hash the signature data, including the trailer
+             *
+             *  @param  writer  The hasher to write to
+             */
+            template <class encoder_t>
+            void hash(encoder_t &writer) const noexcept
+            {
+                // hash the signature fields and hashed subpackets as encoded
+                writer.insert_blob(_hashed_data);
+
+                // add trailer
+                writer.push(version());
+                writer.template push<uint8_t>(0xFF);
+                writer.push(util::narrow_cast<uint32_t>(_hashed_data.size()));
+            }
+
+            /**
+             *  Convert to an owning signature, copying the data
+             *
+             *  @return The signature holding a copy of the data
+             *  @throws std::out_of_range, std::range_error
+             */
+            explicit operator signature() const;
+
+            /**
+             *  Write the data to an encoder
+             *
+             *  @param  writer  The encoder to write to
+             *  @throws std::out_of_range, std::range_error
+             */
+            template <class encoder_t>
+            void encode(encoder_t&& writer) const
+            {
+                // write out the referenced data
+                writer.insert_blob(_data);
+            }
+        private:
+            span<const uint8_t>     _data;                  // the complete encoded signature
+            span<const uint8_t>     _hashed_data;           // the data covered by the signature hash
+            signature_type          _type;                  // the signature type used
+            key_algorithm           _key_algorithm;         // the used key algorithm
+            hash_algorithm          _hash_algorithm;        // the used hashing algorithm
+            span<const uint8_t>     _hashed_subpackets;     // the encoded hashed subpackets
+            span<const uint8_t>     _unhashed_subpackets;   // the encoded unhashed subpackets
+            uint16_t                _hash_prefix;           // the 16 most significant bits of the signed hash
+            std::array<mpi_view, 2> _integers;              // the integers in the signature
+            size_t                  _integer_count{ 0 };    // the number of integers used
+    };
+
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include "basic_key.h"
+#include "ecdsa_signature.h"
+#include "eddsa_signature.h"
+#include "hash_encoder.h"
+#include "key_algorithm.h"
+#include "packet_tag.h"
+#include "rsa_signature.h"
+#include "secret_key.h"
+#include "util/variant.h"
+
+
+namespace pgp {
+
+    /**
+     *  Class for making many signatures with a single key
+     *
+     *  The key is prepared for the crypto library once, when the
+     *  context is created, after which every signature made with
+     *  the context reuses it. Copies of the context share the
+     *  prepared key, and the context is not modified when used, so
+     *  it may be used to make signatures from several threads at once.
+     *
+     *  An EdDSA key is prepared entirely in secure memory. For RSA
+     *  and ECDSA keys, Crypto++ keeps the key integers in buffers of
+     *  its own, which are wiped when released but may be swapped out.
+     *
+     *  A context for a primary key also hashes the key once. The
+     *  user id certifications and subkey bindings it makes start
+     *  from a copy of this hash state, instead of hashing the key
+     *  again for every signature. The context keeps its own copy of
+     *  the key, and signatures made with the context are always
+     *  made by that key, so that the prepared key and the hash
+     *  state cannot get out of step with it.
+     *
+     *  Keys for which we cannot make signatures get an empty
+     *  context, signing with these still raises an error.
+     */
+    class signing_context
+    {
+        public:
+            /**
+             *  The signers for the supported key algorithms
+             */
+            using signer_variant = variant<
+                monostate,
+                rsa_signature_signer,
+                eddsa_signature_signer,
+                ecdsa_signature_signer
+            >;
+
+            /**
+             *  The keys a context can be created for
+             */
+            using key_variant = variant<
+                secret_key,
+                secret_subkey
+            >;
+
+            /**
+             *  Check whether a signature type comes with a signer
+             */
+            template <class signature_t, class = void>
+            struct has_signer : std::false_type {};
+
+            template <class signature_t>
+            struct has_signer<signature_t, std::void_t<typename signature_t::signer_t>> : std::true_type {};
+
+            /**
+             *  Constructor
+             *
+             *  @param  key     The secret key to sign with
+             */
+            template <packet_tag key_tag>
+            explicit signing_context(const basic_key<secret_key_traits<key_tag>> &key) :
+                _algorithm{ key.algorithm() },
+                _key{ std::make_shared<const key_variant>(in_place_type_t<basic_key<secret_key_traits<key_tag>>>{}, key) }
+            {
+                // prepare the key, if we can make signatures with it
+                visit([this](auto &&key_instance) {
+                    // obtain the appropriate signature type
+                    using signature_t = typename std::decay_t<decltype(key_instance)>::signature_t;
+
+                    // does the signature come with a signer?
+                    if constexpr (has_signer<signature_t>::value) {
+                        // create the signer for the key
+                        _signer.emplace<typename signature_t::signer_t>(key_instance);
+                    }
+                }, key.key());
+
+                // signatures made by a primary key start by hashing it,
+                // unless we cannot sign with the key in the first place
+                if constexpr (!secret_key_traits<key_tag>::is_subkey()) {
+                    // can we sign with the key?
+                    if (!holds_alternative<monostate>(_signer)) {
+                        // keep the hash state after hashing the key
+                        auto key_hash = std::make_shared<sha256_encoder>();
+                        key.hash(*key_hash);
+                        _key_hash = std::move(key_hash);
+                    }
+                }
+            }
+
+            /**
+             *  Retrieve the algorithm of the key
+             *
+             *  @return The key algorithm
+             */
+            key_algorithm algorithm() const noexcept
+            {
+                // return the stored algorithm
+                return _algorithm;
+            }
+
+            /**
+             *  Retrieve the hash state after hashing the key
+             *
+             *  @return The hash state, or a nullptr for subkeys
+             */
+            const sha256_encoder *key_hash() const noexcept
+            {
+                // return the stored state, if any
+                return _key_hash.get();
+            }
+
+            /**
+             *  Retrieve the key the context was created for
+             *
+             *  @return The primary key or subkey to sign with
+             */
+            const key_variant &key() const noexcept
+            {
+                // return the stored key
+                return *_key;
+            }
+
+            /**
+             *  Retrieve the prepared signer
+             *
+             *  @return The signer for the key
+             *  @throws std::invalid_argument if the key does not use this signer
+             */
+            template <class signer_t>
+            const signer_t &signer() const
+            {
+                // was the context created for this type of key?
+                if (!holds_alternative<signer_t>(_signer)) {
+                    // then we cannot sign with it
+                    throw std::invalid_argument{ "Signing context was created for a different type of key" };
+                }
+
+                // return the signer
+                return get<signer_t>(_signer);
+            }
+        private:
+            key_algorithm                           _algorithm;     // the algorithm of the key
+            std::shared_ptr<const key_variant>      _key;           // the key to sign with
+            signer_variant                          _signer;        // the signer for the key, if supported
+            std::shared_ptr<const sha256_encoder>   _key_hash;      // the hash state after hashing a primary key
+    };
+
+}
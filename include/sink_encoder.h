@@ -0,0 +1,249 @@
+#pragma once
+
+#include <boost/endian/conversion.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include "util/vector.h"
+#include "util/contiguous.h"
+#include "util/span.h"
+
+
+namespace pgp {
+
+    /**
+     *  Class for encoding packet data directly to a sink,
+     *  such as a file descriptor or an output stream.
+     *
+     *  Data is collected in a fixed-size buffer, which is
+     *  written out to the sink whenever it fills up. Large
+     *  blobs bypass the buffer. After all data is encoded,
+     *  flush() should be called to write out the remainder.
+     */
+    class sink_encoder
+    {
+        public:
+            /**
+             *  The sink to write data to, it must write all of the
+             *  given data, throwing an exception if this fails.
+             */
+            using sink_t = std::function<void(span<const uint8_t>)>;
+
+            /**
+             *  The default size for the write buffer
+             */
+            static constexpr size_t default_buffer_size = 65536;
+
+            /**
+             *  Constructor
+             *
+             *  @param  sink            The sink to write data to
+             *  @param  buffer_size     The size of the write buffer
+             */
+            explicit sink_encoder(sink_t sink, size_t buffer_size = default_buffer_size);
+
+            /**
+             *  Constructor
+             *
+             *  @param  fd              The file descriptor to write data to
+             *  @param  buffer_size     The size of the write buffer
+             */
+            explicit sink_encoder(int fd, size_t buffer_size = default_buffer_size);
+
+            /**
+             *  Constructor
+             *
+             *  @param  stream          The stream to write data to
+             *  @param  buffer_size     The size of the write buffer
+             */
+            explicit sink_encoder(std::ostream &stream, size_t buffer_size = default_buffer_size);
+
+            /**
+             *  The encoder can be neither copied nor moved
+             *
+             *  @param  that    The encoder to copy
+             */
+            sink_encoder(const sink_encoder &that) = delete;
+            sink_encoder(sink_encoder &&that) = delete;
+
+            /**
+             *  Destructor
+             *
+             *  This writes out any buffered data, but errors cannot
+             *  be reported here, call flush() to be informed of them.
+             */
+            ~sink_encoder();
+
+            /**
+             *  The encoder can be neither copied nor moved
+             *
+             *  @param  that    The encoder to assign
+             */
+            sink_encoder &operator=(const sink_encoder &that) = delete;
+            sink_encoder &operator=(sink_encoder &&that) = delete;
+
+            /**
+             *  Flush the encoder, so any partial-written bytes and
+             *  all buffered data are written out to the sink. Note
+             *  that after this operation, bitwise operations start
+             *  at the beginning again.
+             *
+             *  @throws Forwards exceptions from the sink
+             */
+            void flush();
+
+            /**
+             *  Retrieve the number of encoded bytes
+             *  @return The number of bytes written and buffered
+             */
+            size_t size() const noexcept;
+
+            /**
+             *  Insert one or more bits
+             *
+             *  @param  count   The number of bits to insert
+             *  @param  value   The value to store in the bits
+             *  @return self, for chaining
+             *  @throws std::out_of_range, std::range_error
+             */
+            sink_encoder &insert_bits(size_t count, uint8_t value);
+
+            /**
+             *  Push a number to the encoder
+             *
+             *  @param  value   The number to push
+             *  @return self, for chaining
+             *  @throws std::range_error
+             */
+            template <typename T>
+            typename std::enable_if_t<std::numeric_limits<T>::is_integer, sink_encoder&>
+            push(T value)
+            {
+                // ensure that masking the number doesn't change it
+                if ((value & (std::numeric_limits<T>::max() >> _skip_bits)) != value) {
+                    // the number is out of range because it has bits set which should be masked
+                    throw std::range_error{ "Cannot insert number, masked bits are set" };
+                }
+
+                // retrieve the currently-set bits and shift them to the left of the number
+                T result = static_cast<T>(static_cast<T>(_current) << ((sizeof(T) - 1) * 8));
+
+                // add the new value to it and convert it to big-endian, see
+                // range_encoder for why we go through the unsigned type
+                result |= value;
+                result = static_cast<T>(
+                    boost::endian::native_to_big(static_cast<std::make_unsigned_t<T>>(result))
+                );
+
+                // the partial byte is now written
+                _current = 0;
+                _skip_bits = 0;
+
+                // write out the bytes of the number
+                write(span<const uint8_t>{ reinterpret_cast<const uint8_t*>(&result), sizeof result });
+
+                // allow chaining
+                return *this;
+            }
+
+            /**
+             *  Insert an enum
+             *
+             *  @param  value   The enum to insert
+             *  @return self, for chaining
+             *  @throws std::range_error
+             */
+            template <typename T>
+            typename std::enable_if_t<std::is_enum<T>::value, sink_encoder&>
+            push(T value)
+            {
+                // cast it to a number and insert it
+                return push(static_cast<typename std::underlying_type_t<T>>(value));
+            }
+
+            /**
+             *  Push a range of data
+             *
+             *  @note   Since data may already have been written to the sink,
+             *          a failure halfway through the range is not rolled back
+             *
+             *  @param  begin   The iterator to the beginning of the data
+             *  @param  end     The iterator to the end of the data
+             *  @return self, for chaining
+             *  @throws std::range_error
+             */
+            template <typename iterator_t>
+            sink_encoder &push(iterator_t begin, iterator_t end)
+            {
+                // do we have a contiguous range of bytes?
+                if constexpr (util::is_contiguous_byte_iterator_v<iterator_t>) {
+                    // push the whole range at once
+                    return insert_blob(util::make_span(begin, end));
+                } else {
+                    // iterate over the range
+                    while (begin != end) {
+                        // push the data
+                        push(*begin);
+
+                        // move to next element
+                        ++begin;
+                    }
+                }
+
+                // allow chaining
+                return *this;
+            }
+
+            /**
+             *  Insert a blob of data
+             *
+             *  @param  value   The data to insert
+             *  @return self, for chaining
+             *  @throws std::range_error
+             */
+            template <typename T>
+            sink_encoder &insert_blob(span<const T> value)
+            {
+                if (value.empty()) {
+                    // nothing to do if the input is empty
+                    return *this;
+                }
+
+                // add the first value using push() to merge in the possible queued bits
+                push(value[0]);
+
+                // then write out the rest of the data in one go
+                write(span<const uint8_t>{ reinterpret_cast<const uint8_t*>(value.data() + 1), (static_cast<size_t>(value.size()) - 1) * sizeof(T) });
+
+                // allow chaining
+                return *this;
+            }
+        private:
+            /**
+             *  Write whole bytes of data
+             *
+             *  @param  data    The data to write
+             *  @throws Forwards exceptions from the sink
+             */
+            void write(span<const uint8_t> data);
+
+            /**
+             *  Write all buffered data out to the sink
+             *
+             *  @throws Forwards exceptions from the sink
+             */
+            void drain();
+
+            sink_t          _sink;                  // the sink to write to
+            vector<uint8_t> _buffer;                // the write buffer
+            size_t          _buffered   { 0 };      // number of bytes in the buffer
+            size_t          _written    { 0 };      // number of bytes written to the sink
+            uint8_t         _current    { 0 };      // the current byte we are working on
+            uint8_t         _skip_bits  { 0 };      // number of bits to skip from data
+    };
+
+}
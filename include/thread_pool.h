@@ -0,0 +1,82 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace pgp {
+
+    /**
+     *  A fixed-size pool of worker threads, executing
+     *  tasks in the order in which they were submitted.
+     *
+     *  The pool can be used as the executor for the
+     *  parallel operations in this library.
+     */
+    class thread_pool
+    {
+        public:
+            /**
+             *  Constructor
+             *
+             *  @param  size    The number of worker threads to start,
+             *                  by default one for every hardware thread
+             */
+            explicit thread_pool(size_t size = std::thread::hardware_concurrency());
+
+            /**
+             *  The pool can be neither copied nor moved
+             *
+             *  @param  that    The pool to copy or move
+             */
+            thread_pool(const thread_pool &that) = delete;
+            thread_pool(thread_pool &&that) = delete;
+
+            /**
+             *  Destructor
+             *
+             *  This waits for all submitted tasks to complete.
+             */
+            ~thread_pool();
+
+            /**
+             *  Assignment operator, the pool cannot be assigned
+             *
+             *  @param  that    The pool to assign
+             */
+            thread_pool &operator=(const thread_pool &that) = delete;
+            thread_pool &operator=(thread_pool &&that) = delete;
+
+            /**
+             *  Retrieve the number of worker threads
+             *
+             *  @return The number of threads in the pool
+             */
+            size_t size() const noexcept;
+
+            /**
+             *  Submit a task to be executed on one of the workers,
+             *  the task should not throw any exceptions
+             *
+             *  @param  task    The task to execute
+             */
+            void execute(std::function<void()> task);
+        private:
+            /**
+             *  Run tasks until the pool is stopped
+             */
+            void run();
+
+            std::mutex                          _mutex;                 // the mutex protecting the queue
+            std::condition_variable             _condition;             // signalled when tasks are added
+            std::deque<std::function<void()>>   _tasks;                 // the tasks waiting to be executed
+            bool                                _stopped    { false };  // whether the pool is shutting down
+            std::vector<std::thread>            _workers;               // the worker threads
+    };
+
+}
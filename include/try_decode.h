@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include "decode_error.h"
+#include "decoder.h"
+#include "util/expected.h"
+
+
+namespace pgp {
+
+    /**
+     *  Decode an object, without raising an exception
+     *  when the data turns out to be malformed
+     *
+     *  This can be used with any object that is constructible
+     *  from a decoder, e.g. a packet. On success, the parser is
+     *  moved beyond the decoded data. When an error is returned,
+     *  the parser is left untouched.
+     *
+     *  @param  parser  The decoder to parse the data
+     *  @return The decoded object, or the first error encountered
+     */
+    template <class T>
+    expected<T, decode_error> try_decode(decoder &parser)
+    {
+        // continue from the parser, but without exceptions
+        decode_error    error;
+        decoder         checked{ parser, error };
+        T               result{ checked };
+
+        // did we encounter malformed data?
+        if (error) {
+            // return the first error
+            return unexpected<decode_error>{ error };
+        }
+
+        // skip the parser past the decoded data
+        parser.splice(parser.size() - checked.size());
+
+        // return the decoded object
+        return result;
+    }
+
+}
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 #include "decoder_traits.h"
+#include "util/vector.h"
+#include "util/span.h"
 
 
 namespace pgp {
@@ -10,6 +15,12 @@ namespace pgp {
 
     /**
      *  Class representing a key using an unknown algorithm
+     *
+     *  The raw key material is kept, so that the key can be
+     *  encoded again exactly as it was read. Since the format
+     *  is unknown, the public and secret parts of a secret key
+     *  cannot be told apart, so such a key cannot be hashed or
+     *  fingerprinted.
      */
     class unknown_key
     {
@@ -31,60 +42,56 @@ namespace pgp {
 
             /**
              *  Constructor
+             *
+             *  @param  parser  The decoder to parse the data
              */
             template <class decoder, class = std::enable_if_t<is_decoder_v<decoder>>>
-            explicit unknown_key(decoder&) noexcept {}
+            explicit unknown_key(decoder &parser) :
+                unknown_key{ parser.template extract_blob<uint8_t>(parser.size()) }
+            {}
 
             /**
-             *  Comparison operators
+             *  Constructor
+             *
+             *  @param  data    The raw key material
              */
-            bool operator==(const unknown_key&) const noexcept
-            {
-                return true;
-            }
+            explicit unknown_key(span<const uint8_t> data);
 
             /**
              *  Comparison operators
+             *
+             *  @param  other   The object to compare with
              */
-            bool operator!=(const unknown_key &other) const noexcept
-            {
-                return !operator==(other);
-            }
+            bool operator==(const unknown_key &other) const noexcept;
+            bool operator!=(const unknown_key &other) const noexcept;
 
             /**
              *  Determine the size used in encoded format
              *  @return The number of bytes used for encoded storage
-             *  @throws std::runtime_error for the unknown key
              */
-            size_t size() const
-            {
-                // we do not know the size
-                throw std::runtime_error{ "Unknown keys have an unknown size" };
-            }
+            size_t size() const noexcept;
 
             /**
-             *  Hash the key into a given hash context
+             *  Retrieve the raw key material
              *
-             *  @throws std::runtime_error for the unknown key
+             *  @return The data following the key algorithm
              */
-            template <class encoder_t>
-            void hash(encoder_t &) const
-            {
-                // unknown key cannot be hashed
-                throw std::runtime_error{ "Unknown keys cannot be hashed" };
-            }
+            span<const uint8_t> data() const noexcept;
 
             /**
              *  Write the data to an encoder
              *
-             *  @throws std::runtime_error for the unknown key
+             *  @param  writer  The encoder to write to
+             *  @throws std::out_of_range, std::range_error
              */
             template <class encoder_t>
-            void encode(encoder_t&) const
+            void encode(encoder_t &&writer) const
             {
-                // unknown key cannot be encoded
-                throw std::runtime_error{ "Failed to encode unknown key" };
+                // write out the raw key material
+                writer.insert_blob(data());
             }
+        private:
+            vector<uint8_t> _data;  // the raw key material
     };
 
 }
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 #include "decoder_traits.h"
+#include "memory_resource.h"
 #include "packet_tag.h"
+#include "util/span.h"
 
 
 namespace pgp {
@@ -9,6 +14,9 @@ namespace pgp {
     /**
      *  A packet used when the packet tag is not supported
      *  or if it is an unknown packet altogether.
+     *
+     *  The tag and the raw body data are kept, so that the
+     *  packet can be encoded again exactly as it was read.
      */
     class unknown_packet
     {
@@ -20,59 +28,71 @@ namespace pgp {
 
             /**
              *  Constructor
+             *
+             *  @param  tag     The tag of the packet
+             *  @param  parser  The decoder to parse the data
              */
             template <class decoder, class = std::enable_if_t<is_decoder_v<decoder>>>
-            explicit unknown_packet(decoder&) noexcept {}
+            unknown_packet(packet_tag tag, decoder &parser) :
+                _tag{ tag },
+                _data( resource_allocator<uint8_t>{ parser.resource() } )
+            {
+                // copy all the remaining data at once
+                auto data = parser.template extract_blob<uint8_t>(parser.size());
+                _data.assign(data.begin(), data.end());
+            }
 
             /**
-             *  Comparison operators
+             *  Constructor
+             *
+             *  @param  tag     The tag of the packet
+             *  @param  data    The raw body data
              */
-            bool operator==(const unknown_packet&) const noexcept
-            {
-                return true;
-            }
+            unknown_packet(packet_tag tag, span<const uint8_t> data);
 
             /**
              *  Comparison operators
+             *
+             *  @param  other   The object to compare with
              */
-            bool operator!=(const unknown_packet &other) const noexcept
-            {
-                return !operator==(other);
-            }
+            bool operator==(const unknown_packet &other) const noexcept;
+            bool operator!=(const unknown_packet &other) const noexcept;
 
             /**
              *  Retrieve the packet tag used for this
              *  packet type
              *  @return The packet type to use
              */
-            static constexpr packet_tag tag() noexcept
-            {
-                // an unknown packet has no tag
-                return packet_tag::reserved;
-            }
+            packet_tag tag() const noexcept;
 
             /**
              *  Determine the size used in encoded format
              *  @return The number of bytes used for encoded storage
-             *  @throws std::runtime_error
              */
-            size_t size() const
-            {
-                // we don't have a known size
-                throw std::runtime_error{ "Unknown packet does not have a known size" };
-            }
+            size_t size() const noexcept;
+
+            /**
+             *  Retrieve the raw body data
+             *
+             *  @return The body of the packet
+             */
+            span<const uint8_t> data() const noexcept;
 
             /**
              *  Write the data to an encoder
              *
+             *  @param  writer  The encoder to write to
              *  @throws std::out_of_range, std::range_error
              */
             template <class encoder_t>
-            void encode(encoder_t&) const
+            void encode(encoder_t &&writer) const
             {
-                // unknown packets cannot be encoded
-                throw std::runtime_error{ "Failed to encode unknown packet" };
+                // write out the raw body
+                writer.insert_blob(data());
             }
+        private:
+            packet_tag                  _tag    { packet_tag::reserved };   // the tag of the packet
+            resource_vector<uint8_t>    _data;                              // the raw body data
     };
 
 }
@@ -2,14 +2,20 @@
 
 #include "unknown_signature_encoder.h"
 #include "decoder_traits.h"
+#include "memory_resource.h"
 #include "secret_key.h"
-#include <stdexcept>
+#include "util/span.h"
+#include <cstddef>
+#include <cstdint>
 
 
 namespace pgp {
 
     /**
      *  Class for holding an unknown signature
+     *
+     *  The raw signature data is kept, so that the signature
+     *  can be encoded again exactly as it was read.
      */
     class unknown_signature
     {
@@ -23,47 +29,60 @@ namespace pgp {
 
             /**
              *  Constructor
+             *
+             *  @param  parser  The decoder to parse the data
              */
             template <class decoder, class = std::enable_if_t<is_decoder_v<decoder>>>
-            explicit unknown_signature(decoder&) noexcept {}
+            explicit unknown_signature(decoder &parser) :
+                _data( resource_allocator<uint8_t>{ parser.resource() } )
+            {
+                // copy all the remaining data at once
+                auto data = parser.template extract_blob<uint8_t>(parser.size());
+                _data.assign(data.begin(), data.end());
+            }
 
             /**
-             *  Comparison operators
+             *  Constructor
+             *
+             *  @param  data    The raw signature data
              */
-            bool operator==(const unknown_signature&) const noexcept
-            {
-                return true;
-            }
+            explicit unknown_signature(span<const uint8_t> data);
 
             /**
              *  Comparison operators
+             *
+             *  @param  other   The object to compare with
              */
-            bool operator!=(const unknown_signature &other) const noexcept
-            {
-                return !operator==(other);
-            }
+            bool operator==(const unknown_signature &other) const noexcept;
+            bool operator!=(const unknown_signature &other) const noexcept;
 
             /**
              *  Determine the size used in encoded format
              *  @return The number of bytes used for encoded storage
              */
-            size_t size() const
-            {
-                // we do not know the size
-                throw std::runtime_error{ "Unknown signatures have an unknown size" };
-            }
+            size_t size() const noexcept;
+
+            /**
+             *  Retrieve the raw signature data
+             *
+             *  @return The data following the hash prefix
+             */
+            span<const uint8_t> data() const noexcept;
 
             /**
              *  Write the data to an encoder
              *
+             *  @param  writer  The encoder to write to
              *  @throws std::out_of_range, std::range_error
              */
             template <class encoder_t>
-            void encode(encoder_t&) const
+            void encode(encoder_t &&writer) const
             {
-                // unknown key cannot be encoded
-                throw std::runtime_error{ "Failed to encode unknown signature" };
+                // write out the raw signature data
+                writer.insert_blob(data());
             }
+        private:
+            resource_vector<uint8_t>    _data;  // the raw signature data
     };
 
 }
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stdexcept>
+
+
+namespace pgp {
+
+    /**
+     *  Error raised when a key or signature uses an algorithm - a
+     *  public key algorithm, hash algorithm or curve - that we do
+     *  not support, as opposed to a key or signature that is invalid
+     */
+    class unsupported_algorithm : public std::runtime_error
+    {
+        public:
+            /**
+             *  Constructor
+             *
+             *  @param  message The description of the error
+             */
+            using std::runtime_error::runtime_error;
+    };
+
+}
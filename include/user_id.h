@@ -30,8 +30,9 @@ namespace pgp {
              *  Constructor
              *
              *  @param  id      The user id to use
+             *  @throws std::bad_alloc
              */
-            explicit user_id(span<const char> id) noexcept;
+            explicit user_id(span<const char> id);
 
             /**
              *  Constructor
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include "decoder_traits.h"
+#include "packet_tag.h"
+#include "user_id.h"
+#include "util/span.h"
+
+
+namespace pgp {
+
+    /**
+     *  A view on a user id, referring to the encoded
+     *  data instead of holding a copy of it.
+     *
+     *  The view is only valid as long as the data it was
+     *  decoded from is kept alive.
+     */
+    class user_id_view
+    {
+        public:
+            /**
+             *  Constructor
+             *
+             *  @param  parser  The parser to decode data from
+             */
+            template <class decoder, class = std::enable_if_t<is_decoder_v<decoder>>>
+            explicit user_id_view(decoder &parser) :
+                user_id_view{ parser.template extract_blob<char>(parser.size()) }
+            {}
+
+            /**
+             *  Constructor
+             *
+             *  @param  id      The user id to refer to
+             */
+            explicit user_id_view(span<const char> id) noexcept;
+
+            /**
+             *  Comparison operators
+             *
+             *  @param  other   The object to compare with
+             */
+            bool operator==(const user_id_view &other) const noexcept;
+            bool operator!=(const user_id_view &other) const noexcept;
+
+            /**
+             *  Retrieve the packet tag used for this
+             *  packet type
+             *  @return The packet type to use
+             */
+            packet_tag tag() const noexcept
+            {
+                // this is a user id packet
+                return packet_tag::user_id;
+            }
+
+            /**
+             *  Determine the size used in encoded format
+             *  @return The number of bytes used for encoded storage
+             */
+            size_t size() const noexcept;
+
+            /**
+             *  Retrieve the user id
+             *
+             *  @return The user id
+             */
+            span<const char> id() const noexcept;
+
+            /**
+             *  Convert to an owning user id, copying the data
+             *  @return The user id holding a copy of the data
+             */
+            explicit operator user_id() const;
+
+            /**
+             *  Write the data to an encoder
+             *
+             *  @param  writer  The encoder to write to
+             *  @throws std::out_of_range, std::range_error
+             */
+            template <class encoder_t>
+            void encode(encoder_t&& writer) const
+            {
+                // insert the id into the encoder
+                writer.insert_blob(_id);
+            }
+        private:
+            span<const char>    _id;    // the user id representation
+    };
+
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <boost/utility/string_view.hpp>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "vector.h"
+#include "span.h"
+
+
+namespace util {
+
+    /**
+     *  Determine whether an iterator refers to contiguous
+     *  storage, holding single-byte integral values
+     *
+     *  Before c++20, there is no way to detect contiguous
+     *  iterators in general, so we recognize the pointers and
+     *  iterators of the containers we commonly encode from.
+     *  Since the values are single bytes, the range can be
+     *  copied as-is, without converting the byte order.
+     */
+    template <typename iterator_t, typename = void>
+    struct is_contiguous_byte_iterator : std::false_type {};
+
+    template <typename iterator_t>
+    struct is_contiguous_byte_iterator<iterator_t, std::enable_if_t<
+        std::is_integral_v<typename std::iterator_traits<iterator_t>::value_type>                       &&
+        !std::is_same_v<typename std::iterator_traits<iterator_t>::value_type, bool>                    &&
+        sizeof(typename std::iterator_traits<iterator_t>::value_type) == 1
+    >>
+    {
+        private:
+            // the type of the values in the range
+            using value_t = typename std::iterator_traits<iterator_t>::value_type;
+
+            /**
+             *  Check whether the iterator is one of
+             *  the iterator types of a container
+             */
+            template <typename container_t>
+            static constexpr bool is_iterator_of =
+                std::is_same_v<iterator_t, typename container_t::iterator> ||
+                std::is_same_v<iterator_t, typename container_t::const_iterator>;
+        public:
+            static constexpr bool value =
+                std::is_pointer_v<iterator_t>                                       ||
+                is_iterator_of<std::vector<value_t>>                                ||
+                is_iterator_of<std::vector<value_t, pgp::allocator<value_t>>>       ||
+                is_iterator_of<std::string>                                         ||
+                is_iterator_of<boost::string_view>                                  ||
+                is_iterator_of<pgp::span<value_t>>                                  ||
+                is_iterator_of<pgp::span<const value_t>>;
+    };
+
+    template <typename iterator_t>
+    constexpr bool is_contiguous_byte_iterator_v = is_contiguous_byte_iterator<iterator_t>::value;
+
+    /**
+     *  Create a read-only span over a contiguous range
+     *
+     *  @param  begin   The iterator to the beginning of the data
+     *  @param  end     The iterator to the end of the data
+     *  @return The span covering the range
+     */
+    template <typename iterator_t, typename = std::enable_if_t<is_contiguous_byte_iterator_v<iterator_t>>>
+    auto make_span(iterator_t begin, iterator_t end) noexcept
+    {
+        // the type of the values in the range
+        using value_t = typename std::iterator_traits<iterator_t>::value_type;
+
+        // an empty range cannot be dereferenced
+        if (begin == end) {
+            // so we return an empty span
+            return pgp::span<const value_t>{};
+        }
+
+        // refer to the memory of the range
+        return pgp::span<const value_t>{ &*begin, static_cast<size_t>(std::distance(begin, end)) };
+    }
+
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+#include "variant.h"
+
+
+namespace pgp {
+
+    /**
+     *  Wrapper to construct an expected holding an error
+     */
+    template <typename E>
+    class unexpected
+    {
+        public:
+            /**
+             *  Constructor
+             *
+             *  @param  error   The error to hold
+             */
+            constexpr explicit unexpected(E error) :
+                _error{ std::move(error) }
+            {}
+
+            /**
+             *  Retrieve the error
+             *
+             *  @return The held error
+             */
+            constexpr const E &error() const noexcept
+            {
+                return _error;
+            }
+        private:
+            E   _error; // the held error
+    };
+
+    /**
+     *  Class holding either a value or the error
+     *  explaining why no value could be produced
+     */
+    template <typename T, typename E>
+    class expected
+    {
+        public:
+            /**
+             *  Constructor
+             *
+             *  @param  value   The value to hold
+             */
+            expected(T value) :
+                _data{ in_place_type_t<T>{}, std::move(value) }
+            {}
+
+            /**
+             *  Constructor
+             *
+             *  @param  error   The error to hold
+             */
+            expected(unexpected<E> error) :
+                _data{ in_place_type_t<unexpected<E>>{}, std::move(error) }
+            {}
+
+            /**
+             *  Check whether a value is held
+             *
+             *  @return Whether we hold a value instead of an error
+             */
+            bool has_value() const noexcept
+            {
+                return holds_alternative<T>(_data);
+            }
+
+            /**
+             *  Check whether a value is held
+             *
+             *  @return Whether we hold a value instead of an error
+             */
+            explicit operator bool() const noexcept
+            {
+                return has_value();
+            }
+
+            /**
+             *  Retrieve the value
+             *
+             *  @return The held value
+             *  @throws bad_variant_access when holding an error
+             */
+            T &value() &
+            {
+                return get<T>(_data);
+            }
+
+            const T &value() const &
+            {
+                return get<T>(_data);
+            }
+
+            T &&value() &&
+            {
+                return get<T>(std::move(_data));
+            }
+
+            /**
+             *  Retrieve the value
+             *
+             *  @return The held value
+             *  @throws bad_variant_access when holding an error
+             */
+            T &operator*() &                { return value(); }
+            const T &operator*() const &    { return value(); }
+            T &&operator*() &&              { return std::move(*this).value(); }
+            T *operator->()                 { return &value(); }
+            const T *operator->() const     { return &value(); }
+
+            /**
+             *  Retrieve the error
+             *
+             *  @return The held error
+             *  @throws bad_variant_access when holding a value
+             */
+            const E &error() const
+            {
+                return get<unexpected<E>>(_data).error();
+            }
+        private:
+            variant<T, unexpected<E>>   _data;  // the value or the error
+    };
+
+}
@@ -44,8 +44,10 @@ namespace pgp {
                     // simple four-octet number
                     _value = parser.template extract_number<uint32_t>();
                 } else {
-                    // error: we don't support par
-                    throw std::runtime_error{ "Partial body length not implemented" };
+                    // a partial body length, the lower five bits
+                    // give the power of two of the chunk size
+                    _value   = 1U << (parser.template extract_number<uint8_t>() & 0x1f);
+                    _partial = true;
                 }
             }
 
@@ -56,6 +58,15 @@ namespace pgp {
              */
             explicit variable_number(uint32_t value) noexcept;
 
+            /**
+             *  Create a partial body length
+             *
+             *  @param  value   The size of the chunk, a power of two up to 2^30
+             *  @return The partial body length
+             *  @throws std::range_error
+             */
+            static variable_number partial(uint32_t value);
+
             /**
              *  Assignment operator
              *
@@ -64,6 +75,14 @@ namespace pgp {
              */            
             variable_number &operator=(uint32_t value) noexcept;
 
+            /**
+             *  Check whether this is a partial body length, meaning that
+             *  more chunks of body data follow after this one
+             *
+             *  @return Whether the length is partial
+             */
+            bool is_partial() const noexcept;
+
             /**
              *  Determine the size used in encoded format
              *
@@ -88,7 +107,17 @@ namespace pgp {
             void encode(encoder_t&& writer) const
             {
                 // encoding depends on the value
-                if (_value < 192) {
+                if (_partial) {
+                    // find the power of two of the chunk size
+                    uint8_t exponent = 0;
+                    while ((1U << exponent) < _value) {
+                        // try the next power of two
+                        ++exponent;
+                    }
+
+                    // the power of two is stored in the lower five bits
+                    writer.push(static_cast<uint8_t>(224 + exponent));
+                } else if (_value < 192) {
                     // directly encode the number
                     auto value = util::narrow_cast<uint8_t>(_value);
                     writer.push(value);
@@ -105,7 +134,8 @@ namespace pgp {
                 }
             }
         private:
-            uint32_t    _value{ 0 };
+            uint32_t    _value  { 0 };      // the stored number
+            bool        _partial{ false };  // whether this is a partial body length
     };
 
 }
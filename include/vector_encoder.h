@@ -0,0 +1,232 @@
+#pragma once
+
+#include <boost/endian/conversion.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include "util/contiguous.h"
+#include "util/span.h"
+#include "util/transaction.h"
+
+
+namespace pgp {
+
+    /**
+     *  Class for encoding packet data into a vector, which
+     *  grows as needed. This avoids having to determine the
+     *  encoded size up front, so encoding is a single pass.
+     *
+     *  Data is appended to whatever the vector already holds.
+     *  Any vector of bytes can be used, including the secure
+     *  pgp::vector, which is recommended for secret key data.
+     */
+    template <class vector_t>
+    class vector_encoder
+    {
+        public:
+            /**
+             *  Constructor
+             *
+             *  @param  data    The vector to append the encoded data to
+             */
+            explicit vector_encoder(vector_t &data) noexcept :
+                _data{ data },
+                _begin{ data.size() }
+            {}
+
+            /**
+             *  Flush the encoder, so any partial-written bytes
+             *  are written out. Note that after this operation,
+             *  bitwise operations start at the beginning again.
+             */
+            void flush()
+            {
+                // do we have any partially-filled bytes?
+                if (_skip_bits > 0) {
+                    // write out the current byte
+                    _data.push_back(_current);
+
+                    // move to the next byte
+                    _current = 0;
+                    _skip_bits = 0;
+                }
+            }
+
+            /**
+             *  Retrieve the number of encoded bytes
+             *  @return The number of bytes appended by the encoder
+             */
+            size_t size() const noexcept
+            {
+                // we only count the bytes we added
+                return _data.size() - _begin;
+            }
+
+            /**
+             *  Insert one or more bits
+             *
+             *  @param  count   The number of bits to insert
+             *  @param  value   The value to store in the bits
+             *  @return self, for chaining
+             *  @throws std::out_of_range, std::range_error
+             */
+            vector_encoder &insert_bits(size_t count, uint8_t value)
+            {
+                // check whether the number fits within the given bit-size
+                if (value > (1U << count) - 1U) {
+                    // the value is too large to encode
+                    throw std::range_error{ "Cannot encode value, too large for given bit-size" };
+                }
+
+                // the write may not cross a byte boundary
+                if (count + _skip_bits > 8) {
+                    // cannot encode the value, does not fit within byte
+                    throw std::out_of_range{ "Cannot encode value, bit-wise operation may not cross byte boundaries" };
+                }
+
+                // shift the data so it fits with the existing data and add it
+                _current |= static_cast<uint8_t>(value << static_cast<uint8_t>(8U - _skip_bits - count));
+
+                // do we move on to the next byte?
+                if (count + _skip_bits == 8) {
+                    // store the byte now
+                    _data.push_back(_current);
+                    _current = 0;
+                    _skip_bits = 0;
+                } else {
+                    // just increment the bits to skip
+                    _skip_bits += count;
+                }
+
+                // allow chaining
+                return *this;
+            }
+
+            /**
+             *  Push a number to the encoder
+             *
+             *  @param  value   The number to push
+             *  @return self, for chaining
+             *  @throws std::range_error
+             */
+            template <typename T>
+            typename std::enable_if_t<std::numeric_limits<T>::is_integer, vector_encoder&>
+            push(T value)
+            {
+                // ensure that masking the number doesn't change it
+                if ((value & (std::numeric_limits<T>::max() >> _skip_bits)) != value) {
+                    // the number is out of range because it has bits set which should be masked
+                    throw std::range_error{ "Cannot insert number, masked bits are set" };
+                }
+
+                // retrieve the currently-set bits and shift them to the left of the number
+                T result = static_cast<T>(static_cast<T>(_current) << ((sizeof(T) - 1) * 8));
+
+                // add the new value to it and convert it to big-endian, see
+                // range_encoder for why we go through the unsigned type
+                result |= value;
+                result = static_cast<T>(
+                    boost::endian::native_to_big(static_cast<std::make_unsigned_t<T>>(result))
+                );
+
+                // append the bytes of the number
+                auto *bytes = reinterpret_cast<const uint8_t*>(&result);
+                _data.insert(_data.end(), bytes, bytes + sizeof(T));
+
+                // the partial byte is now written
+                _current = 0;
+                _skip_bits = 0;
+
+                // allow chaining
+                return *this;
+            }
+
+            /**
+             *  Insert an enum
+             *
+             *  @param  value   The enum to insert
+             *  @return self, for chaining
+             *  @throws std::range_error
+             */
+            template <typename T>
+            typename std::enable_if_t<std::is_enum<T>::value, vector_encoder&>
+            push(T value)
+            {
+                // cast it to a number and insert it
+                return push(static_cast<typename std::underlying_type_t<T>>(value));
+            }
+
+            /**
+             *  Push a range of data
+             *
+             *  @param  begin   The iterator to the beginning of the data
+             *  @param  end     The iterator to the end of the data
+             *  @return self, for chaining
+             *  @throws std::range_error
+             */
+            template <typename iterator_t>
+            vector_encoder &push(iterator_t begin, iterator_t end)
+            {
+                // do we have a contiguous range of bytes?
+                if constexpr (util::is_contiguous_byte_iterator_v<iterator_t>) {
+                    // push the whole range at once
+                    return insert_blob(util::make_span(begin, end));
+                } else {
+                    // restore the state from before the push on failure
+                    util::transaction transaction([this, size_val=_data.size(), current_val=_current, skip_bits_val=_skip_bits]() {
+                        _data.resize(size_val);
+                        _current = current_val;
+                        _skip_bits = skip_bits_val;
+                    });
+
+                    // iterate over the range
+                    while (begin != end) {
+                        // push the data
+                        push(*begin);
+
+                        // move to next element
+                        ++begin;
+                    }
+
+                    transaction.commit();
+                }
+
+                // allow chaining
+                return *this;
+            }
+
+            /**
+             *  Insert a blob of data
+             *
+             *  @param  value   The data to insert
+             *  @return self, for chaining
+             *  @throws std::range_error
+             */
+            template <typename T>
+            vector_encoder &insert_blob(span<const T> value)
+            {
+                if (value.empty()) {
+                    // nothing to do if the input is empty
+                    return *this;
+                }
+
+                // add the first value using push() to merge in the possible queued bits
+                push(value[0]);
+
+                // then append the rest of the data in one go
+                auto *bytes = reinterpret_cast<const uint8_t*>(value.data() + 1);
+                _data.insert(_data.end(), bytes, bytes + (static_cast<size_t>(value.size()) - 1) * sizeof(T));
+
+                // allow chaining
+                return *this;
+            }
+        private:
+            vector_t   &_data;                  // the vector to append to
+            size_t      _begin      { 0 };      // the size of the vector before encoding
+            uint8_t     _current    { 0 };      // the current byte we are working on
+            uint8_t     _skip_bits  { 0 };      // number of bits to skip from data
+    };
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <boost/utility/string_view.hpp>
+#include <cstdint>
+
+
+namespace pgp {
+
+    /**
+     *  The outcome of verifying a single signature
+     *
+     *  A value-initialized result is invalid, so
+     *  that a result never set does not pass.
+     */
+    enum class verification_result : uint8_t
+    {
+        invalid     = 0,
+        valid       = 1,
+        unsupported = 2
+    };
+
+    /**
+     *  Get a description of the verification result
+     *
+     *  @param  result  The result to get a description for
+     *  @return The description of the result
+     */
+    constexpr boost::string_view verification_result_description(verification_result result) noexcept
+    {
+        // check the given result
+        switch (result) {
+            case verification_result::invalid:      return "invalid";
+            case verification_result::valid:        return "valid";
+            case verification_result::unsupported:  return "unsupported";
+        }
+
+        // unknown result found
+        return "unknown verification result";
+    }
+
+}
@@ -0,0 +1,333 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <vector>
+#include "basic_key.h"
+#include "signature.h"
+#include "signature_type.h"
+#include "signature_verifier.h"
+#include "unsupported_algorithm.h"
+#include "user_id.h"
+#include "util/narrow_cast.h"
+#include "verification_result.h"
+
+
+namespace pgp {
+
+    /**
+     *  The data signed by a certification: a key
+     *  together with one of its user ids
+     */
+    template <class key_traits>
+    class user_id_certification
+    {
+        public:
+            /**
+             *  Constructor
+             *
+             *  @param  key     The key the user id belongs to
+             *  @param  user    The certified user id
+             */
+            user_id_certification(const basic_key<key_traits> &key, const user_id &user) noexcept :
+                _key{ key },
+                _user{ user }
+            {}
+
+            /**
+             *  Check whether a signature type signs this data
+             *
+             *  @param  type    The type of signature
+             *  @return Whether the type is a certification
+             */
+            static constexpr bool accepts(signature_type type) noexcept
+            {
+                // any of the four certification levels
+                switch (type) {
+                    case signature_type::generic_user_id_and_public_key_certification:
+                    case signature_type::persona_user_id_and_public_key_certification:
+                    case signature_type::casual_user_id_and_public_key_certification:
+                    case signature_type::positive_user_id_and_public_key_certification:
+                        return true;
+                    default:
+                        return false;
+                }
+            }
+
+            /**
+             *  Hash the signed data into a given hash context
+             *
+             *  @param  writer  The hasher to write to
+             */
+            template <class encoder_t>
+            void hash(encoder_t &writer) const
+            {
+                // hash the key
+                _key.hash(writer);
+
+                // hash the user id
+                writer.template push<uint8_t>(0xB4);
+                writer.push(util::narrow_cast<uint32_t>(_user.size()));
+                _user.encode(writer);
+            }
+        private:
+            const basic_key<key_traits>    &_key;   // the key the user id belongs to
+            const user_id                  &_user;  // the certified user id
+    };
+
+    /**
+     *  The data signed by a key binding: the primary
+     *  key together with one of its subkeys
+     *
+     *  A subkey binding is made by the primary key, a
+     *  primary key binding is made by the subkey.
+     */
+    template <class primary_traits, class subkey_traits>
+    class key_binding
+    {
+        public:
+            /**
+             *  Constructor
+             *
+             *  @param  primary The primary key
+             *  @param  subkey  The subkey bound to it
+             */
+            key_binding(const basic_key<primary_traits> &primary, const basic_key<subkey_traits> &subkey) noexcept :
+                _primary{ primary },
+                _subkey{ subkey }
+            {}
+
+            /**
+             *  Check whether a signature type signs this data
+             *
+             *  @param  type    The type of signature
+             *  @return Whether the type is a key binding
+             */
+            static constexpr bool accepts(signature_type type) noexcept
+            {
+                // both directions hash the same data
+                return type == signature_type::subkey_binding || type == signature_type::primary_key_binding;
+            }
+
+            /**
+             *  Hash the signed data into a given hash context
+             *
+             *  @param  writer  The hasher to write to
+             */
+            template <class encoder_t>
+            void hash(encoder_t &writer) const
+            {
+                // the primary key always comes first
+                _primary.hash(writer);
+                _subkey.hash(writer);
+            }
+        private:
+            const basic_key<primary_traits>    &_primary;   // the primary key
+            const basic_key<subkey_traits>     &_subkey;    // the subkey bound to it
+    };
+
+    /**
+     *  Verify a signature over a user id certification
+     *  or a key binding
+     *
+     *  @param  sig         The signature to verify
+     *  @param  signer      The key that made the signature
+     *  @param  context     The signed data
+     *  @return Whether the signature is valid
+     *  @throws pgp::unsupported_algorithm for unsupported algorithms
+     */
+    template <class signer_traits, class context_t>
+    bool verify(const signature &sig, const basic_key<signer_traits> &signer, const context_t &context)
+    {
+        // verify with a verifier for just this signature
+        return signature_verifier{ signer }.verify(sig, context);
+    }
+
+    /**
+     *  A single signature to verify in a batch
+     */
+    template <class signer_traits, class context_t>
+    struct verification_job
+    {
+        const signature                    &sig;       // the signature to verify
+        const basic_key<signer_traits>     &signer;    // the key that made the signature
+        context_t                           context;   // the signed data
+    };
+
+    /**
+     *  Deduction guide for creating a job
+     */
+    template <class signer_traits, class context_t>
+    verification_job(const signature &, const basic_key<signer_traits> &, context_t) -> verification_job<signer_traits, context_t>;
+
+    /**
+     *  Verify a batch of signatures, spreading the work
+     *  over the threads of the given executor
+     *
+     *  The jobs are grouped by the key that made them, so that
+     *  every key is prepared only once for a group of jobs. Jobs
+     *  are grouped by the address of the key, so all jobs made by
+     *  the same key should refer to the same key object. Groups
+     *  with more jobs than the batch size are split up, to keep
+     *  all the threads busy.
+     *
+     *  The executor must provide an execute() method taking a
+     *  std::function<void()>, like the thread_pool class does.
+     *  The call blocks until all jobs are verified, so it must
+     *  not be made from a task running on the executor.
+     *  When the executor fails to accept a batch, the call waits
+     *  for the batches it did accept before raising the error.
+     *
+     *  Jobs using an algorithm we cannot verify, such as DSA
+     *  keys or MD5 hashes, do not fail the batch; these jobs are
+     *  reported as unsupported, while the others are verified.
+     *
+     *  @param  jobs        The signatures to verify
+     *  @param  executor    The executor to run the batches on
+     *  @param  batch_size  The maximum number of jobs verified by a single task
+     *  @return The result for each signature, in the order of the jobs
+     *  @throws Any error other than an unsupported algorithm raised while
+     *          verifying, the error raised is the one for the first job
+     *  @throws Any error raised by the executor
+     */
+    template <class signer_traits, class context_t, class executor_t>
+    std::vector<verification_result> verify_batch(const std::vector<verification_job<signer_traits, context_t>> &jobs, executor_t &executor, size_t batch_size = 256)
+    {
+        // a number of jobs made by a single key, verified in a single task
+        struct batch
+        {
+            size_t              begin;      // the first job in the batch
+            size_t              end;        // one past the last job in the batch
+            std::exception_ptr  error;      // the error raised for the first failing job
+            size_t              failed;     // the index of the job that failed
+        };
+
+        // order the jobs by signer, keeping the order of jobs by the same signer
+        std::vector<size_t> order(jobs.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&jobs](size_t a, size_t b) {
+            // compare the key addresses
+            return std::less<const void*>{}(&jobs[a].signer, &jobs[b].signer);
+        });
+
+        // split the jobs in batches with a single signer
+        std::vector<batch>  batches;
+        size_t              begin   = 0;
+
+        // add jobs to the batch until it is big enough
+        for (size_t i = 0; i < order.size(); ++i) {
+            // is this the last job of this signer, or is the batch full?
+            if (i + 1 == order.size() || &jobs[order[i + 1]].signer != &jobs[order[i]].signer || i + 1 - begin >= batch_size) {
+                // create the batch with the jobs so far
+                batches.push_back(batch{ begin, i + 1, {}, 0 });
+                begin = i + 1;
+            }
+        }
+
+        // the results, which are written from different threads, invalid until verified
+        std::vector<verification_result> results(jobs.size(), verification_result::invalid);
+
+        // the synchronization for waiting on the batches
+        std::mutex              mutex;
+        std::condition_variable condition;
+        size_t                  remaining = batches.size();
+
+        // start verifying all the batches
+        for (size_t position = 0; position < batches.size(); ++position) {
+            // the batch to verify
+            auto &current = batches[position];
+
+            // the executor may fail to accept the batch
+            try {
+                // verify the batch on the executor
+                executor.execute([&jobs, &order, &results, &current, &mutex, &condition, &remaining]() {
+                    // the job we are verifying
+                    size_t index = order[current.begin];
+
+                    // verification may fail
+                    try {
+                        // prepare the key once for the whole batch
+                        signature_verifier verifier{ jobs[index].signer };
+
+                        // verify every job in the batch
+                        for (size_t i = current.begin; i < current.end; ++i) {
+                            // verify the job, continuing when it fails
+                            try {
+                                // store the result
+                                index = order[i];
+                                results[index] = verifier.verify(jobs[index].sig, jobs[index].context)
+                                    ? verification_result::valid
+                                    : verification_result::invalid;
+                            } catch (const unsupported_algorithm&) {
+                                // we cannot verify this signature
+                                results[index] = verification_result::unsupported;
+                            } catch (...) {
+                                // only the first error is raised
+                                if (!current.error) {
+                                    // store the error, so we can raise it later
+                                    current.error   = std::current_exception();
+                                    current.failed  = index;
+                                }
+                            }
+                        }
+                    } catch (const unsupported_algorithm&) {
+                        // the key cannot be used for verifying
+                        for (size_t i = current.begin; i < current.end; ++i) {
+                            // so none of its signatures can be verified
+                            results[order[i]] = verification_result::unsupported;
+                        }
+                    } catch (...) {
+                        // the key could not be prepared
+                        current.error   = std::current_exception();
+                        current.failed  = index;
+                    }
+
+                    // register that the batch is done
+                    std::lock_guard<std::mutex> lock{ mutex };
+                    --remaining;
+                    condition.notify_all();
+                });
+            } catch (...) {
+                // this batch and the ones after it will never run
+                std::unique_lock<std::mutex> lock{ mutex };
+                remaining -= batches.size() - position;
+
+                // but the queued batches still refer to our data
+                condition.wait(lock, [&remaining]() { return remaining == 0; });
+                throw;
+            }
+        }
+
+        // wait for all batches to complete
+        {
+            std::unique_lock<std::mutex> lock{ mutex };
+            condition.wait(lock, [&remaining]() { return remaining == 0; });
+        }
+
+        // find the first job that failed
+        const batch *failed = nullptr;
+        for (auto &current : batches) {
+            // is this job earlier than the one we found?
+            if (current.error && (failed == nullptr || current.failed < failed->failed)) {
+                // this is the error to raise
+                failed = &current;
+            }
+        }
+
+        // did any of the jobs fail?
+        if (failed != nullptr) {
+            // raise the error for the first job
+            std::rethrow_exception(failed->error);
+        }
+
+        // return the results
+        return results;
+    }
+
+}
@@ -1,4 +1,7 @@
 #include "curve_oid.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
 
 
 namespace pgp {
@@ -7,19 +10,44 @@ namespace pgp {
      *  Constructor
      *
      *  @param  data    The range of numbers
+     *  @throws std::range_error
      */
-    curve_oid::curve_oid(span<const uint8_t> data) noexcept :
-        _data{ data.begin(), data.end() }
-    {}
+    curve_oid::curve_oid(span<const uint8_t> data)
+    {
+        // store the data and find the curve
+        assign(data);
+    }
 
     /**
      *  Constructor
      *
      *  @param  data    The range of numbers
+     *  @throws std::range_error
+     */
+    curve_oid::curve_oid(std::initializer_list<const uint8_t> data)
+    {
+        // store the data and find the curve
+        assign({ data.begin(), data.end() });
+    }
+
+    /**
+     *  Constructor
+     *
+     *  @param  curve   The known curve to create the identifier for
      */
-    curve_oid::curve_oid(std::initializer_list<const uint8_t> data) noexcept :
-        _data{ data.begin(), data.end() }
-    {}
+    curve_oid::curve_oid(curve_id curve) noexcept
+    {
+        // find the curve in the registry
+        for (const auto &known : known_curves) {
+            // is this the curve we are looking for?
+            if (known.id == curve) {
+                // copy the identifier
+                _size   = known.size;
+                _id     = known.id;
+                _data   = known.data;
+            }
+        }
+    }
 
     /**
      *  Comparison operators
@@ -28,7 +56,8 @@ namespace pgp {
      */
     bool curve_oid::operator==(const curve_oid &other) const noexcept
     {
-        return data() == other.data();
+        // the identifiers are padded, so they can be compared as a whole
+        return _size == other._size && _data == other._data && _long == other._long;
     }
 
     /**
@@ -48,17 +77,61 @@ namespace pgp {
     size_t curve_oid::size() const noexcept
     {
         // one byte for the header, plus the data itself
-        return _data.size() + 1;
+        return _size + 1;
     }
 
     /**
      *  Retrieve the data
      *  @return A span containing all the integer numbers
      */
-    span<const uint8_t> curve_oid::data() const
+    span<const uint8_t> curve_oid::data() const noexcept
+    {
+        // was the identifier too long to store inline?
+        if (_size > inline_size) {
+            // then it is stored on the heap
+            return _long;
+        }
+
+        // provide access to the used part of the data
+        return { _data.data(), _size };
+    }
+
+    /**
+     *  Store the identifier and look up the curve
+     *
+     *  @param  data    The range of numbers
+     *  @throws std::range_error
+     */
+    void curve_oid::assign(span<const uint8_t> data)
     {
-        // provide access to the underlying data
-        return _data;
+        // check whether the size fits in the encoded header
+        if (static_cast<size_t>(data.size()) > std::numeric_limits<uint8_t>::max()) {
+            // we cannot encode this identifier
+            throw std::range_error{ "Curve OID is too long" };
+        }
+
+        // store the size of the identifier
+        _size = static_cast<uint8_t>(data.size());
+
+        // is the identifier too long to store inline?
+        if (_size > inline_size) {
+            // keep it on the heap, no known curve is this long
+            _long.assign(data.begin(), data.end());
+            _id = curve_id::unknown;
+            return;
+        }
+
+        // copy the data, the remainder is left zeroed
+        std::copy(data.begin(), data.end(), _data.begin());
+
+        // find the curve with the same identifier
+        auto iter = std::find_if(known_curves.begin(), known_curves.end(), [this](const known_curve &known) {
+            // the padded identifiers are compared in one go
+            return known.size == _size && known.data == _data;
+        });
+
+        // store the curve, if we know it
+        _id = iter == known_curves.end() ? curve_id::unknown : iter->id;
     }
 
 }
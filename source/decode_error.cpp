@@ -0,0 +1,73 @@
+#include "decode_error.h"
+
+
+namespace pgp {
+
+    /**
+     *  Constructor
+     *
+     *  @param  kind    The kind of error
+     *  @param  offset  The byte offset at which the error was detected
+     */
+    decode_error::decode_error(decode_error_kind kind, size_t offset) noexcept :
+        _kind{ kind },
+        _offset{ offset }
+    {}
+
+    /**
+     *  Comparison operators
+     *
+     *  @param  other   The object to compare with
+     */
+    bool decode_error::operator==(const decode_error &other) const noexcept
+    {
+        return kind() == other.kind() && offset() == other.offset();
+    }
+
+    /**
+     *  Comparison operators
+     *
+     *  @param  other   The object to compare with
+     */
+    bool decode_error::operator!=(const decode_error &other) const noexcept
+    {
+        return !operator==(other);
+    }
+
+    /**
+     *  Check whether an error occurred
+     *
+     *  @return Whether the kind is anything other than none
+     */
+    decode_error::operator bool() const noexcept
+    {
+        // any kind but none is an actual error
+        return _kind != decode_error_kind::none;
+    }
+
+    /**
+     *  Retrieve the kind of error
+     *
+     *  @return The error kind
+     */
+    decode_error_kind decode_error::kind() const noexcept
+    {
+        // return the kind of error
+        return _kind;
+    }
+
+    /**
+     *  Retrieve the offset of the error
+     *
+     *  @note   For packets using partial body lengths, errors inside
+     *          the body are counted from the start of the first chunk,
+     *          as if the chunks were stored without length octets
+     *  @return The number of bytes from the start of the input
+     */
+    size_t decode_error::offset() const noexcept
+    {
+        // return the offset of the error
+        return _offset;
+    }
+
+}
@@ -12,6 +12,58 @@ namespace pgp {
         _data{ data }
     {}
 
+    /**
+     *  Constructor
+     *
+     *  @param  data    The range to decode from
+     *  @param  error   The error to report malformed data to
+     */
+    decoder::decoder(span<const uint8_t> data, decode_error &error) noexcept :
+        _data{ data },
+        _error{ &error }
+    {}
+
+    /**
+     *  Constructor
+     *
+     *  @param  data        The range to decode from
+     *  @param  resource    The resource to allocate decoded data from
+     */
+    decoder::decoder(span<const uint8_t> data, memory_resource &resource) noexcept :
+        _data{ data },
+        _resource{ &resource }
+    {}
+
+    /**
+     *  Constructor
+     *
+     *  @param  data        The range to decode from
+     *  @param  resource    The resource to allocate decoded data from
+     *  @param  error       The error to report malformed data to
+     */
+    decoder::decoder(span<const uint8_t> data, memory_resource &resource, decode_error &error) noexcept :
+        _data{ data },
+        _error{ &error },
+        _resource{ &resource }
+    {}
+
+    /**
+     *  Constructor
+     *
+     *  Continue decoding where another decoder currently is,
+     *  reporting malformed data to the given error instead.
+     *
+     *  @param  parser  The decoder to continue from
+     *  @param  error   The error to report malformed data to
+     */
+    decoder::decoder(const decoder &parser, decode_error &error) noexcept :
+        _data{ parser._data },
+        _offset{ parser._offset },
+        _error{ &error },
+        _resource{ parser._resource },
+        _skip_bits{ parser._skip_bits }
+    {}
+
     /**
      *  Splice the data in the decoder into a second decoder
      *
@@ -24,14 +76,22 @@ namespace pgp {
         // check whether we have enough data
         if (size > _data.size()) {
             // trying to read out-of-bounds
-            throw std::out_of_range{ "Not enough data available to splice" };
+            fail(decode_error_kind::truncated, "Not enough data available to splice");
+            size = 0;
         }
 
         // first create a new decoder with the spliced data
         decoder result{ _data.first(size) };
 
+        // it is found at the current offset, reports to the same
+        // error and allocates from the same resource
+        result._offset      = _offset;
+        result._error       = _error;
+        result._resource    = _resource;
+
         // alter the stored data
         _data = _data.subspan(size);
+        _offset += size;
 
         // return the result
         return result;
@@ -60,6 +120,54 @@ namespace pgp {
         return _data.size();
     }
 
+    /**
+     *  The offset of the current position in the data
+     *
+     *  @return The number of bytes consumed since the start of the input
+     */
+    size_t decoder::offset() const noexcept
+    {
+        // return the offset of the remaining data
+        return _offset;
+    }
+
+    /**
+     *  The resource to allocate decoded data from
+     *
+     *  Secret key material ignores the resource, it
+     *  is always allocated in secure memory.
+     *
+     *  @return The resource, or a nullptr to use new and delete
+     */
+    memory_resource *decoder::resource() const noexcept
+    {
+        // return the resource to allocate from
+        return _resource;
+    }
+
+    /**
+     *  Report that the data is malformed
+     *
+     *  Unless the decoder reports to a decode_error, this raises
+     *  an exception matching the kind of error. Otherwise the error
+     *  is recorded - unless an earlier error already was - and
+     *  all remaining data is discarded.
+     *
+     *  @param  kind    The kind of error encountered
+     *  @param  message The message for the exception to raise
+     *  @throws std::out_of_range, std::range_error, std::runtime_error
+     */
+    void decoder::fail(decode_error_kind kind, const char *message)
+    {
+        // report the error first, this may throw
+        report(kind, message);
+
+        // we cannot make sense of the remaining data
+        _offset += _data.size();
+        _data = {};
+        _skip_bits = 0;
+    }
+
     /**
      *  Peek at bits at the current position, but
      *  do not consume them
@@ -73,7 +181,8 @@ namespace pgp {
         // check whether we have enough data
         if (empty()) {
             // trying to read out-of-bounds
-            throw std::out_of_range{ "No more data left to read" };
+            report(decode_error_kind::truncated, "No more data left to read");
+            return 0;
         }
 
         // retrieve the current leading byte and mask already-read bytes
@@ -92,6 +201,13 @@ namespace pgp {
      */
     uint8_t decoder::extract_bits(size_t count)
     {
+        // check whether we have enough data
+        if (empty()) {
+            // trying to read out-of-bounds
+            fail(decode_error_kind::truncated, "No more data left to read");
+            return 0;
+        }
+
         // retrieve the current data
         auto result = peek_bits(count);
 
@@ -99,6 +215,7 @@ namespace pgp {
         if (_skip_bits + count >= 8) {
             // move on to the next byte
             _data = _data.subspan<1>();
+            _offset += 1;
             _skip_bits = 0;
         } else {
             // just update the counter
@@ -109,4 +226,48 @@ namespace pgp {
         return result;
     }
 
+    /**
+     *  Replace the data to decode, keeping the offset
+     *  and the error reporting of the decoder intact
+     *
+     *  @param  data    The range to decode from
+     */
+    void decoder::replace(span<const uint8_t> data) noexcept
+    {
+        // start decoding from the new data
+        _data = data;
+        _skip_bits = 0;
+    }
+
+    /**
+     *  Report that the data is malformed, without
+     *  discarding the remaining data
+     *
+     *  @param  kind    The kind of error encountered
+     *  @param  message The message for the exception to raise
+     *  @throws std::out_of_range, std::range_error, std::runtime_error
+     */
+    void decoder::report(decode_error_kind kind, const char *message) const
+    {
+        // are we reporting errors without exceptions?
+        if (_error != nullptr) {
+            // only the first error is recorded, later
+            // errors are usually caused by the first one
+            if (!*_error) {
+                // store the kind and location of the error
+                *_error = decode_error{ kind, _offset };
+            }
+
+            // the error is registered
+            return;
+        }
+
+        // raise the exception matching the error
+        switch (kind) {
+            case decode_error_kind::truncated:          throw std::out_of_range{ message };
+            case decode_error_kind::unexpected_value:   throw std::range_error{ message };
+            default:                                    throw std::runtime_error{ message };
+        }
+    }
+
 }
@@ -9,7 +9,7 @@ namespace pgp {
      *
      *  @param  x   The secret exponent
      */
-    dsa_secret_key::dsa_secret_key(multiprecision_integer x) noexcept :
+    dsa_secret_key::dsa_secret_key(secret_multiprecision_integer x) noexcept :
         _x{ std::move(x) }
     {}
 
@@ -48,7 +48,7 @@ namespace pgp {
      *
      *  @return The secret exponent x
      */
-    const multiprecision_integer &dsa_secret_key::x() const noexcept
+    const secret_multiprecision_integer &dsa_secret_key::x() const noexcept
     {
         // return the secret exponent
         return _x;
@@ -1,16 +1,4 @@
 #include "ecdsa_signature_encoder.h"
-#include <cryptopp/eccrypto.h>
-#include <cryptopp/ecp.h>
-#include <cryptopp/integer.h>
-#include <cryptopp/oids.h>
-#include <cryptopp/osrng.h>
-#include <cryptopp/pubkey.h>
-#include <cstddef>
-#include <cstdint>
-#include <array>
-#include <stdexcept>
-#include "util/span.h"
-#include "null_hash.h"
 
 
 namespace pgp {
@@ -23,46 +11,11 @@ namespace pgp {
     std::tuple<multiprecision_integer, multiprecision_integer>
     ecdsa_signature_encoder::finalize()
     {
-        // Crypto++ does not export this information as constexpr
-        constexpr size_t signature_length = 64;
-
-        // retrieve the key data
-        auto secret_data = ecdsa_key.k().data();
-
-        // ECDSA needs randomness for signatures
-        CryptoPP::AutoSeededRandomPool prng;
-
-        CryptoPP::Integer k1_exponent;
-        k1_exponent.Decode(secret_data.data(), secret_data.size());
-
-        CryptoPP::ECDSA<CryptoPP::ECP, NullHash<32>>::PrivateKey k1;
-        k1.Initialize(CryptoPP::ASN1::secp256r1(), k1_exponent);
-
-        // the buffer for the signed message and the concatenated key
-        std::array<uint8_t, signature_length> signed_message;
-
-        // construct the signer
-        CryptoPP::ECDSA<CryptoPP::ECP, NullHash<32>>::Signer signer{k1};
-
-        if (signer.MaxSignatureLength() != signature_length) {
-            throw std::logic_error("Unexpected Crypto++ ECDSA maximum signature length");
-        }
-
         // get the digest to sign
         auto digest_data = digest();
 
-        // now sign the message
-        size_t actual_length = signer.SignMessage(prng, digest_data.data(), digest_data.size(), signed_message.data());
-
-        if (actual_length != signature_length) {
-            throw std::logic_error("Unexpected Crypto++ ECDSA actual signature length");
-        }
-
-        // split up the data and return it
-        return std::make_tuple(
-            multiprecision_integer{span{ signed_message.data(),      32 }},
-            multiprecision_integer{span{ signed_message.data() + 32, 32 }}
-        );
+        // and sign it with the prepared key
+        return _signer.sign(digest_data);
     }
 
 }
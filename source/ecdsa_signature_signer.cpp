@@ -0,0 +1,62 @@
+#include "ecdsa_signature_signer.h"
+#include <cryptopp/integer.h>
+#include <cryptopp/oids.h>
+#include <array>
+#include <stdexcept>
+#include "allocator.h"
+#include "random_generator.h"
+
+
+namespace pgp {
+
+    /**
+     *  Constructor
+     *
+     *  @param  key     The secret key to sign with
+     */
+    ecdsa_signature_signer::ecdsa_signature_signer(const basic_secret_key<ecdsa_public_key, ecdsa_secret_key> &key)
+    {
+        // retrieve the key data
+        auto secret_data = key.k().data();
+
+        CryptoPP::Integer k1_exponent;
+        k1_exponent.Decode(secret_data.data(), secret_data.size());
+
+        // create the signer in secure memory, instead of copying it there from the stack
+        auto prepared = std::allocate_shared<signer_t>(allocator<signer_t>{});
+        prepared->AccessKey().Initialize(CryptoPP::ASN1::secp256r1(), k1_exponent);
+        _signer = std::move(prepared);
+
+        // Crypto++ does not export this information as constexpr
+        if (_signer->MaxSignatureLength() != 2 * integer_size) {
+            throw std::logic_error("Unexpected Crypto++ ECDSA maximum signature length");
+        }
+    }
+
+    /**
+     *  Sign a digest
+     *
+     *  @param  digest  The digest to sign
+     *  @return Tuple of the r and s parameters for the ECDSA signature
+     *  @throws std::logic_error when Crypto++ makes an unexpected signature
+     */
+    std::tuple<multiprecision_integer, multiprecision_integer> ecdsa_signature_signer::sign(span<const uint8_t> digest) const
+    {
+        // the buffer for the signed message
+        std::array<uint8_t, 2 * integer_size> signed_message;
+
+        // now sign the message
+        size_t actual_length = _signer->SignMessage(random_generator::instance(), digest.data(), digest.size(), signed_message.data());
+
+        if (actual_length != signed_message.size()) {
+            throw std::logic_error("Unexpected Crypto++ ECDSA actual signature length");
+        }
+
+        // split up the data and return it
+        return std::make_tuple(
+            multiprecision_integer{span{ signed_message.data(),                integer_size }},
+            multiprecision_integer{span{ signed_message.data() + integer_size, integer_size }}
+        );
+    }
+
+}
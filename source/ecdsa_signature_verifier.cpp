@@ -0,0 +1,90 @@
+#include "ecdsa_signature_verifier.h"
+#include <cryptopp/integer.h>
+#include <cryptopp/oids.h>
+#include <algorithm>
+#include <array>
+#include "ecdsa_signature.h"
+#include "unsupported_algorithm.h"
+
+
+namespace pgp {
+
+    /**
+     *  Constructor
+     *
+     *  @param  key     The public key of the signer
+     */
+    ecdsa_signature_verifier::ecdsa_signature_verifier(const ecdsa_public_key &key) :
+        _supported{ key.curve().id() == curve_id::nist_p256 }
+    {
+        // retrieve the public key data
+        auto public_data = key.Q().data();
+
+        // the public key must be an uncompressed point on a supported curve
+        if (!_supported || public_data.size() != 2 * integer_size + 1 || public_data[0] != 0x04) {
+            // we cannot use this key
+            return;
+        }
+
+        // construct the public key from the coordinates
+        CryptoPP::ECDSA<CryptoPP::ECP, NullHash<integer_size>>::PublicKey public_key;
+        public_key.Initialize(CryptoPP::ASN1::secp256r1(), CryptoPP::ECP::Point{
+            CryptoPP::Integer{ public_data.data() + 1,                integer_size },
+            CryptoPP::Integer{ public_data.data() + 1 + integer_size, integer_size }
+        });
+
+        // and create the verifier for it
+        _verifier.emplace(public_key);
+    }
+
+    /**
+     *  Verify a signature over a digest
+     *
+     *  Digests longer than the curve order are truncated,
+     *  like they are when signing.
+     *
+     *  @param  signature   The signature to verify
+     *  @param  algorithm   The hash algorithm used for the digest
+     *  @param  digest      The digest that was signed
+     *  @return Whether the signature is valid
+     *  @throws pgp::unsupported_algorithm for unsupported curves
+     */
+    bool ecdsa_signature_verifier::verify(const ecdsa_signature &signature, hash_algorithm, span<const uint8_t> digest) const
+    {
+        // we only support signatures made on the NIST P-256 curve
+        if (!_supported) {
+            // we cannot verify this signature
+            throw unsupported_algorithm{ "Unsupported curve for ECDSA signatures" };
+        }
+
+        // retrieve the signature values
+        auto r_data = signature.r().data();
+        auto s_data = signature.s().data();
+
+        // the key must be valid, and both values must fit in their half of the signature
+        if (!_verifier || r_data.size() > integer_size || s_data.size() > integer_size) {
+            // this is not a valid signature
+            return false;
+        }
+
+        // the buffers for the signature and the digest
+        std::array<uint8_t, 2 * integer_size>   signature_data;
+        std::array<uint8_t, integer_size>       digest_data;
+
+        // leading zero bytes may have been dropped, so we fill these back in
+        auto iter = signature_data.begin();
+        iter = std::fill_n(iter, integer_size - r_data.size(), 0);
+        iter = std::copy(r_data.begin(), r_data.end(), iter);
+        iter = std::fill_n(iter, integer_size - s_data.size(), 0);
+        std::copy(s_data.begin(), s_data.end(), iter);
+
+        // use the leftmost bytes of longer digests, and pad shorter
+        // ones with leading zeroes, which keeps their numeric value
+        auto digest_size = std::min(digest.size(), digest_data.size());
+        std::copy_n(digest.begin(), digest_size, std::fill_n(digest_data.begin(), digest_data.size() - digest_size, 0));
+
+        // check the signature
+        return _verifier->VerifyMessage(digest_data.data(), digest_data.size(), signature_data.data(), signature_data.size());
+    }
+
+}
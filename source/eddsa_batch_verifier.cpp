@@ -0,0 +1,911 @@
+#include "eddsa_batch_verifier.h"
+#include <sodium/crypto_core_ed25519.h>
+#include <sodium/crypto_hash_sha512.h>
+#include <sodium/crypto_sign.h>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include "eddsa_signature.h"
+#include "unsupported_algorithm.h"
+
+
+namespace pgp {
+
+    // the arithmetic needs 128-bit products
+#ifdef __SIZEOF_INT128__
+    namespace {
+
+        /**
+         *  The arithmetic for verifying with precomputed multiples
+         *
+         *  Libsodium does not let us keep the multiples of a key
+         *  it computes for a signature, so we do the group arithmetic
+         *  ourselves, the way libsodium does it internally: field
+         *  elements have five limbs of 51 bits, points are in extended
+         *  coordinates. None of this needs to run in constant time,
+         *  since only public data is used.
+         */
+        using uint128_t     = unsigned __int128;
+        using field_element = std::array<uint64_t, 5>;
+
+        // the bits in a single limb
+        constexpr uint64_t limb_mask = (uint64_t{ 1 } << 51) - 1;
+
+        // the field elements we need
+        constexpr field_element fe_zero { 0, 0, 0, 0, 0 };
+        constexpr field_element fe_one  { 1, 0, 0, 0, 0 };
+        constexpr field_element fe_d    { 0x34dca135978a3, 0x1a8283b156ebd, 0x5e7a26001c029, 0x739c663a03cbb, 0x52036cee2b6ff };
+        constexpr field_element fe_d2   { 0x69b9426b2f159, 0x35050762add7a, 0x3cf44c0038052, 0x6738cc7407977, 0x2406d9dc56dff };
+        constexpr field_element fe_sqrtm1 { 0x61b274a0ea0b0, 0x0d5a5fc8f189d, 0x7ef5e9cbd0c60, 0x78595a6804c9e, 0x2b8324804fc1d };
+
+        // the encoding of the base point
+        constexpr std::array<uint8_t, 32> base_point {
+            0x58, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+            0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+            0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+            0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66
+        };
+
+        // the order of the base point, little-endian
+        constexpr std::array<uint8_t, 32> group_order {
+            0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58,
+            0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10
+        };
+
+        // the number of signatures a key must have made to be worth a table
+        constexpr size_t min_signatures_per_key = 4;
+
+        /**
+         *  Carry the limbs of a field element over, so
+         *  each limb fits in (slightly more than) 51 bits
+         *
+         *  @param  h       The element to carry
+         */
+        void fe_carry(field_element &h) noexcept
+        {
+            // move the excess bits to the next limb, wrapping around with 2^255 = 19
+            h[1] += h[0] >> 51; h[0] &= limb_mask;
+            h[2] += h[1] >> 51; h[1] &= limb_mask;
+            h[3] += h[2] >> 51; h[2] &= limb_mask;
+            h[4] += h[3] >> 51; h[3] &= limb_mask;
+            h[0] += (h[4] >> 51) * 19; h[4] &= limb_mask;
+        }
+
+        /**
+         *  Add two field elements
+         *
+         *  @param  h       The result
+         *  @param  f       The first element
+         *  @param  g       The second element
+         */
+        void fe_add(field_element &h, const field_element &f, const field_element &g) noexcept
+        {
+            // add the limbs and carry
+            for (size_t i = 0; i < h.size(); ++i) {
+                h[i] = f[i] + g[i];
+            }
+            fe_carry(h);
+        }
+
+        /**
+         *  Subtract two field elements
+         *
+         *  @param  h       The result
+         *  @param  f       The element to subtract from
+         *  @param  g       The element to subtract
+         */
+        void fe_sub(field_element &h, const field_element &f, const field_element &g) noexcept
+        {
+            // add four times the prime first, so the limbs cannot go below zero
+            h[0] = f[0] + 0x1FFFFFFFFFFFB4 - g[0];
+            h[1] = f[1] + 0x1FFFFFFFFFFFFC - g[1];
+            h[2] = f[2] + 0x1FFFFFFFFFFFFC - g[2];
+            h[3] = f[3] + 0x1FFFFFFFFFFFFC - g[3];
+            h[4] = f[4] + 0x1FFFFFFFFFFFFC - g[4];
+            fe_carry(h);
+        }
+
+        /**
+         *  Multiply two field elements
+         *
+         *  @param  h       The result
+         *  @param  f       The first element
+         *  @param  g       The second element
+         */
+        void fe_mul(field_element &h, const field_element &f, const field_element &g) noexcept
+        {
+            // the higher limbs of g, multiplied by 19 for wrapping around
+            uint64_t g1_19 = g[1] * 19;
+            uint64_t g2_19 = g[2] * 19;
+            uint64_t g3_19 = g[3] * 19;
+            uint64_t g4_19 = g[4] * 19;
+
+            // the products for every limb of the result
+            uint128_t t0 = uint128_t{ f[0] } * g[0] + uint128_t{ f[1] } * g4_19 + uint128_t{ f[2] } * g3_19 + uint128_t{ f[3] } * g2_19 + uint128_t{ f[4] } * g1_19;
+            uint128_t t1 = uint128_t{ f[0] } * g[1] + uint128_t{ f[1] } * g[0]  + uint128_t{ f[2] } * g4_19 + uint128_t{ f[3] } * g3_19 + uint128_t{ f[4] } * g2_19;
+            uint128_t t2 = uint128_t{ f[0] } * g[2] + uint128_t{ f[1] } * g[1]  + uint128_t{ f[2] } * g[0]  + uint128_t{ f[3] } * g4_19 + uint128_t{ f[4] } * g3_19;
+            uint128_t t3 = uint128_t{ f[0] } * g[3] + uint128_t{ f[1] } * g[2]  + uint128_t{ f[2] } * g[1]  + uint128_t{ f[3] } * g[0]  + uint128_t{ f[4] } * g4_19;
+            uint128_t t4 = uint128_t{ f[0] } * g[4] + uint128_t{ f[1] } * g[3]  + uint128_t{ f[2] } * g[2]  + uint128_t{ f[3] } * g[1]  + uint128_t{ f[4] } * g[0];
+
+            // carry the products over
+            t1 += static_cast<uint64_t>(t0 >> 51); h[0] = static_cast<uint64_t>(t0) & limb_mask;
+            t2 += static_cast<uint64_t>(t1 >> 51); h[1] = static_cast<uint64_t>(t1) & limb_mask;
+            t3 += static_cast<uint64_t>(t2 >> 51); h[2] = static_cast<uint64_t>(t2) & limb_mask;
+            t4 += static_cast<uint64_t>(t3 >> 51); h[3] = static_cast<uint64_t>(t3) & limb_mask;
+            h[0] += static_cast<uint64_t>(t4 >> 51) * 19; h[4] = static_cast<uint64_t>(t4) & limb_mask;
+            h[1] += h[0] >> 51; h[0] &= limb_mask;
+        }
+
+        /**
+         *  Square a field element
+         *
+         *  @param  h       The result
+         *  @param  f       The element to square
+         */
+        void fe_sq(field_element &h, const field_element &f) noexcept
+        {
+            // the doubled and wrapped limbs we need
+            uint64_t f0_2  = f[0] * 2;
+            uint64_t f1_2  = f[1] * 2;
+            uint64_t f1_38 = f[1] * 38;
+            uint64_t f2_38 = f[2] * 38;
+            uint64_t f3_38 = f[3] * 38;
+            uint64_t f3_19 = f[3] * 19;
+            uint64_t f4_19 = f[4] * 19;
+
+            // the products for every limb of the result
+            uint128_t t0 = uint128_t{ f[0] } * f[0] + uint128_t{ f1_38 } * f[4] + uint128_t{ f2_38 } * f[3];
+            uint128_t t1 = uint128_t{ f0_2 } * f[1] + uint128_t{ f2_38 } * f[4] + uint128_t{ f3_19 } * f[3];
+            uint128_t t2 = uint128_t{ f0_2 } * f[2] + uint128_t{ f[1] } * f[1] + uint128_t{ f3_38 } * f[4];
+            uint128_t t3 = uint128_t{ f0_2 } * f[3] + uint128_t{ f1_2 } * f[2] + uint128_t{ f4_19 } * f[4];
+            uint128_t t4 = uint128_t{ f0_2 } * f[4] + uint128_t{ f1_2 } * f[3] + uint128_t{ f[2] } * f[2];
+
+            // carry the products over
+            t1 += static_cast<uint64_t>(t0 >> 51); h[0] = static_cast<uint64_t>(t0) & limb_mask;
+            t2 += static_cast<uint64_t>(t1 >> 51); h[1] = static_cast<uint64_t>(t1) & limb_mask;
+            t3 += static_cast<uint64_t>(t2 >> 51); h[2] = static_cast<uint64_t>(t2) & limb_mask;
+            t4 += static_cast<uint64_t>(t3 >> 51); h[3] = static_cast<uint64_t>(t3) & limb_mask;
+            h[0] += static_cast<uint64_t>(t4 >> 51) * 19; h[4] = static_cast<uint64_t>(t4) & limb_mask;
+            h[1] += h[0] >> 51; h[0] &= limb_mask;
+        }
+
+        /**
+         *  Square a field element a number of times
+         *
+         *  @param  h       The result
+         *  @param  f       The element to square
+         *  @param  count   The number of times to square
+         */
+        void fe_sq(field_element &h, const field_element &f, size_t count) noexcept
+        {
+            // square the first time from the input
+            fe_sq(h, f);
+
+            // and the rest in place
+            for (size_t i = 1; i < count; ++i) {
+                fe_sq(h, h);
+            }
+        }
+
+        /**
+         *  Read a field element from its encoding, ignoring the top bit
+         *
+         *  @param  h       The result
+         *  @param  s       The encoded element
+         */
+        void fe_frombytes(field_element &h, const uint8_t *s) noexcept
+        {
+            // the encoding as four little-endian words
+            std::array<uint64_t, 4> words{};
+            for (size_t i = 0; i < 32; ++i) {
+                words[i / 8] |= uint64_t{ s[i] } << (8 * (i % 8));
+            }
+
+            // split the words in limbs
+            h[0] = words[0] & limb_mask;
+            h[1] = (words[0] >> 51 | words[1] << 13) & limb_mask;
+            h[2] = (words[1] >> 38 | words[2] << 26) & limb_mask;
+            h[3] = (words[2] >> 25 | words[3] << 39) & limb_mask;
+            h[4] = (words[3] >> 12) & limb_mask;
+        }
+
+        /**
+         *  Encode a field element, fully reduced
+         *
+         *  @param  s       The buffer to encode to
+         *  @param  h       The element to encode
+         */
+        void fe_tobytes(uint8_t *s, const field_element &h) noexcept
+        {
+            // carry twice, so the value is below 2^255 and properly carried
+            auto t = h;
+            fe_carry(t);
+            fe_carry(t);
+
+            // add 19, so values from the prime up carry over the top bit
+            t[0] += 19;
+            fe_carry(t);
+
+            // add 2^255 - 19, which cancels the 19 when we drop the top bit
+            t[0] += (uint64_t{ 1 } << 51) - 19;
+            t[1] += (uint64_t{ 1 } << 51) - 1;
+            t[2] += (uint64_t{ 1 } << 51) - 1;
+            t[3] += (uint64_t{ 1 } << 51) - 1;
+            t[4] += (uint64_t{ 1 } << 51) - 1;
+
+            // carry without wrapping around, dropping the top bit
+            t[1] += t[0] >> 51; t[0] &= limb_mask;
+            t[2] += t[1] >> 51; t[1] &= limb_mask;
+            t[3] += t[2] >> 51; t[2] &= limb_mask;
+            t[4] += t[3] >> 51; t[3] &= limb_mask;
+            t[4] &= limb_mask;
+
+            // join the limbs into four words
+            std::array<uint64_t, 4> words{
+                t[0]       | t[1] << 51,
+                t[1] >> 13 | t[2] << 38,
+                t[2] >> 26 | t[3] << 25,
+                t[3] >> 39 | t[4] << 12
+            };
+
+            // and write them out in little-endian order
+            for (size_t i = 0; i < 32; ++i) {
+                s[i] = static_cast<uint8_t>(words[i / 8] >> (8 * (i % 8)));
+            }
+        }
+
+        /**
+         *  Check whether a field element is zero
+         *
+         *  @param  f       The element to check
+         *  @return Whether the element is zero
+         */
+        bool fe_iszero(const field_element &f) noexcept
+        {
+            // encode the element to reduce it
+            std::array<uint8_t, 32> s;
+            fe_tobytes(s.data(), f);
+
+            // and check all the bytes
+            return std::all_of(s.begin(), s.end(), [](uint8_t byte) { return byte == 0; });
+        }
+
+        /**
+         *  Check whether a field element is negative,
+         *  meaning the lowest bit is set
+         *
+         *  @param  f       The element to check
+         *  @return Whether the element is negative
+         */
+        bool fe_isnegative(const field_element &f) noexcept
+        {
+            // encode the element to reduce it
+            std::array<uint8_t, 32> s;
+            fe_tobytes(s.data(), f);
+
+            // and check the lowest bit
+            return s[0] & 1;
+        }
+
+        /**
+         *  Raise a field element to the power (p - 5) / 8
+         *
+         *  @param  out     The result
+         *  @param  z       The element to raise
+         */
+        void fe_pow22523(field_element &out, const field_element &z) noexcept
+        {
+            // the addition chain libsodium uses
+            field_element t0, t1, t2;
+
+            fe_sq(t0, z);
+            fe_sq(t1, t0, 2);
+            fe_mul(t1, z, t1);
+            fe_mul(t0, t0, t1);
+            fe_sq(t0, t0);
+            fe_mul(t0, t1, t0);
+            fe_sq(t1, t0, 5);
+            fe_mul(t0, t1, t0);
+            fe_sq(t1, t0, 10);
+            fe_mul(t1, t1, t0);
+            fe_sq(t2, t1, 20);
+            fe_mul(t1, t2, t1);
+            fe_sq(t1, t1, 10);
+            fe_mul(t0, t1, t0);
+            fe_sq(t1, t0, 50);
+            fe_mul(t1, t1, t0);
+            fe_sq(t2, t1, 100);
+            fe_mul(t1, t2, t1);
+            fe_sq(t1, t1, 50);
+            fe_mul(t0, t1, t0);
+            fe_sq(t0, t0, 2);
+            fe_mul(out, t0, z);
+        }
+
+        /**
+         *  A point in extended coordinates, so
+         *  x = X / Z, y = Y / Z and x * y = T / Z
+         */
+        struct point
+        {
+            field_element   X;  // the x coordinate, times Z
+            field_element   Y;  // the y coordinate, times Z
+            field_element   Z;  // the projective factor
+            field_element   T;  // the product of the coordinates, times Z
+        };
+
+        /**
+         *  A point prepared for adding to other points
+         */
+        struct cached_point
+        {
+            field_element   YplusX;     // the sum of Y and X
+            field_element   YminusX;    // the difference of Y and X
+            field_element   Z;          // the projective factor
+            field_element   T2d;        // T, times two times d
+        };
+
+        /**
+         *  A table with multiples of a point, with a row for every
+         *  other digit of a scalar in radix 16: row i holds the
+         *  multiples 1, 2, ..., 8 of 256^i times the point
+         */
+        using point_table = std::array<std::array<cached_point, 8>, 32>;
+
+        /**
+         *  Prepare a point for adding to other points
+         *
+         *  @param  r       The prepared point
+         *  @param  p       The point to prepare
+         */
+        void to_cached(cached_point &r, const point &p) noexcept
+        {
+            // precompute what the addition needs
+            fe_add(r.YplusX, p.Y, p.X);
+            fe_sub(r.YminusX, p.Y, p.X);
+            r.Z = p.Z;
+            fe_mul(r.T2d, p.T, fe_d2);
+        }
+
+        /**
+         *  Add a prepared point to a point
+         *
+         *  @param  r       The result, which may be the same as p
+         *  @param  p       The point to add to
+         *  @param  q       The point to add
+         */
+        void point_add(point &r, const point &p, const cached_point &q) noexcept
+        {
+            field_element a, b, c, d, e, f, g, h;
+
+            // the unified addition formula for twisted edwards curves
+            fe_sub(a, p.Y, p.X);
+            fe_mul(a, a, q.YminusX);
+            fe_add(b, p.Y, p.X);
+            fe_mul(b, b, q.YplusX);
+            fe_mul(c, p.T, q.T2d);
+            fe_mul(d, p.Z, q.Z);
+            fe_add(d, d, d);
+            fe_sub(e, b, a);
+            fe_sub(f, d, c);
+            fe_add(g, d, c);
+            fe_add(h, b, a);
+
+            // and the resulting coordinates
+            fe_mul(r.X, e, f);
+            fe_mul(r.Y, g, h);
+            fe_mul(r.T, e, h);
+            fe_mul(r.Z, f, g);
+        }
+
+        /**
+         *  Subtract a prepared point from a point
+         *
+         *  @param  r       The result, which may be the same as p
+         *  @param  p       The point to subtract from
+         *  @param  q       The point to subtract
+         */
+        void point_sub(point &r, const point &p, const cached_point &q) noexcept
+        {
+            field_element a, b, c, d, e, f, g, h;
+
+            // the addition formula, with q negated
+            fe_sub(a, p.Y, p.X);
+            fe_mul(a, a, q.YplusX);
+            fe_add(b, p.Y, p.X);
+            fe_mul(b, b, q.YminusX);
+            fe_mul(c, p.T, q.T2d);
+            fe_mul(d, p.Z, q.Z);
+            fe_add(d, d, d);
+            fe_sub(e, b, a);
+            fe_add(f, d, c);
+            fe_sub(g, d, c);
+            fe_add(h, b, a);
+
+            // and the resulting coordinates
+            fe_mul(r.X, e, f);
+            fe_mul(r.Y, g, h);
+            fe_mul(r.T, e, h);
+            fe_mul(r.Z, f, g);
+        }
+
+        /**
+         *  Double a point
+         *
+         *  @param  r       The result, which may be the same as p
+         *  @param  p       The point to double
+         */
+        void point_double(point &r, const point &p) noexcept
+        {
+            field_element a, b, c, e, f, g, h;
+
+            // the doubling formula for twisted edwards curves with a = -1
+            fe_sq(a, p.X);
+            fe_sq(b, p.Y);
+            fe_sq(c, p.Z);
+            fe_add(c, c, c);
+            fe_add(h, a, b);
+            fe_add(e, p.X, p.Y);
+            fe_sq(e, e);
+            fe_sub(e, e, h);
+            fe_sub(g, b, a);
+            fe_sub(f, c, g);
+
+            // and the resulting coordinates
+            fe_mul(r.X, e, f);
+            fe_mul(r.Y, g, h);
+            fe_mul(r.T, e, h);
+            fe_mul(r.Z, f, g);
+        }
+
+        /**
+         *  Check whether a point is the neutral element
+         *
+         *  @param  p       The point to check
+         *  @return Whether x is zero and y is one
+         */
+        bool is_identity(const point &p) noexcept
+        {
+            // y is one when Y equals Z
+            field_element difference;
+            fe_sub(difference, p.Y, p.Z);
+
+            // check both coordinates
+            return fe_iszero(p.X) && fe_iszero(difference);
+        }
+
+        /**
+         *  Check whether a point has a small order,
+         *  dividing the cofactor of eight
+         *
+         *  @param  p       The point to check
+         *  @return Whether eight times the point is the neutral element
+         */
+        bool has_small_order(const point &p) noexcept
+        {
+            // multiply the point by the cofactor
+            point q;
+            point_double(q, p);
+            point_double(q, q);
+            point_double(q, q);
+
+            // and check what is left
+            return is_identity(q);
+        }
+
+        /**
+         *  Decode a point
+         *
+         *  Like libsodium, we reject encodings of y that are
+         *  not reduced, and a negative zero for x.
+         *
+         *  @param  r       The decoded point
+         *  @param  s       The encoded point
+         *  @return Whether the encoding was valid
+         */
+        bool decode_point(point &r, const uint8_t *s) noexcept
+        {
+            // read the y coordinate
+            fe_frombytes(r.Y, s);
+            r.Z = fe_one;
+
+            // the encoding must be reduced
+            std::array<uint8_t, 32> check;
+            fe_tobytes(check.data(), r.Y);
+            check[31] |= s[31] & 0x80;
+
+            // is the encoding the same?
+            if (!std::equal(check.begin(), check.end(), s)) {
+                // the y coordinate was not reduced
+                return false;
+            }
+
+            // x^2 = u / v, with u = y^2 - 1 and v = dy^2 + 1
+            field_element u, v, v3, vxx;
+            fe_sq(u, r.Y);
+            fe_mul(v, u, fe_d);
+            fe_sub(u, u, fe_one);
+            fe_add(v, v, fe_one);
+
+            // calculate x = uv^3 (uv^7)^((p - 5) / 8)
+            fe_sq(v3, v);
+            fe_mul(v3, v3, v);
+            fe_sq(r.X, v3);
+            fe_mul(r.X, r.X, v);
+            fe_mul(r.X, r.X, u);
+            fe_pow22523(r.X, r.X);
+            fe_mul(r.X, r.X, v3);
+            fe_mul(r.X, r.X, u);
+
+            // check that we found the square root
+            fe_sq(vxx, r.X);
+            fe_mul(vxx, vxx, v);
+
+            // is vx^2 equal to u?
+            field_element difference;
+            fe_sub(difference, vxx, u);
+            if (!fe_iszero(difference)) {
+                // otherwise, vx^2 must be -u
+                fe_add(difference, vxx, u);
+                if (!fe_iszero(difference)) {
+                    // there is no such point
+                    return false;
+                }
+
+                // and we need to multiply by the square root of -1
+                fe_mul(r.X, r.X, fe_sqrtm1);
+            }
+
+            // do we have the wrong sign?
+            if (fe_isnegative(r.X) != static_cast<bool>(s[31] >> 7)) {
+                // zero cannot be negated
+                if (fe_iszero(r.X)) {
+                    // so this encoding is invalid
+                    return false;
+                }
+
+                // negate the x coordinate
+                fe_sub(r.X, fe_zero, r.X);
+            }
+
+            // and calculate T from the coordinates
+            fe_mul(r.T, r.X, r.Y);
+            return true;
+        }
+
+        /**
+         *  Create the table of multiples of a point
+         *
+         *  This costs a little more than verifying a single
+         *  signature, so it only pays off for a key that made
+         *  a number of the signatures.
+         *
+         *  @param  table   The table to fill
+         *  @param  p       The point to take multiples of
+         */
+        void make_table(point_table &table, const point &p) noexcept
+        {
+            // the point for the current row
+            point current = p;
+
+            // fill all the rows
+            for (size_t row = 0; row < table.size(); ++row) {
+                // we add the point for the row every time
+                point           multiple = current;
+                cached_point    cached_current;
+                to_cached(cached_current, current);
+
+                // fill the row
+                table[row][0] = cached_current;
+                for (size_t i = 1; i < table[row].size(); ++i) {
+                    // move to the next multiple
+                    point_add(multiple, multiple, cached_current);
+                    to_cached(table[row][i], multiple);
+                }
+
+                // the next row is for 256 times the point
+                for (size_t i = 0; i < 8 && row + 1 < table.size(); ++i) {
+                    point_double(current, current);
+                }
+            }
+        }
+
+        /**
+         *  Convert a scalar to radix 16, where every
+         *  digit is a number from -8 to 8
+         *
+         *  @param  r       The digits, from the lowest
+         *  @param  a       The scalar, little-endian, below 2^255
+         */
+        void radix16(std::array<int8_t, 64> &r, const uint8_t *a) noexcept
+        {
+            // split every byte in two digits
+            for (size_t i = 0; i < 32; ++i) {
+                r[2 * i]        = static_cast<int8_t>(a[i] & 15);
+                r[2 * i + 1]    = static_cast<int8_t>(a[i] >> 4);
+            }
+
+            // and move the digits into range, carrying into the next one
+            int carry = 0;
+            for (size_t i = 0; i + 1 < r.size(); ++i) {
+                int digit   = r[i] + carry;
+                carry       = (digit + 8) >> 4;
+                r[i]        = static_cast<int8_t>(digit - carry * 16);
+            }
+
+            // the top digit cannot overflow, since the scalar is small enough
+            r[63] = static_cast<int8_t>(r[63] + carry);
+        }
+
+        /**
+         *  Add a digit times the point for a row of a table
+         *
+         *  @param  r       The point to add to
+         *  @param  row     The multiples of the point for the row
+         *  @param  digit   The digit, from -8 to 8
+         */
+        void add_multiple(point &r, const std::array<cached_point, 8> &row, int digit) noexcept
+        {
+            // add or subtract the multiple, if there is any
+            if (digit > 0) {
+                point_add(r, r, row[digit - 1]);
+            } else if (digit < 0) {
+                point_sub(r, r, row[-digit - 1]);
+            }
+        }
+
+        /**
+         *  Retrieve the table for the base point
+         *
+         *  @return The multiples of the base point
+         */
+        const point_table &base_table() noexcept
+        {
+            // the table is created once, on first use
+            static const auto table = []() {
+                // decode the base point, which cannot fail
+                point   base;
+                auto    result = std::make_unique<point_table>();
+                decode_point(base, base_point.data());
+                make_table(*result, base);
+                return result;
+            }();
+
+            return *table;
+        }
+
+        /**
+         *  Check whether a scalar is fully reduced
+         *
+         *  @param  s       The scalar, little-endian
+         *  @return Whether the scalar is smaller than the group order
+         */
+        bool is_canonical(const uint8_t *s) noexcept
+        {
+            // compare from the most significant byte
+            for (size_t i = group_order.size(); i-- > 0; ) {
+                // is this byte different?
+                if (s[i] != group_order[i]) {
+                    return s[i] < group_order[i];
+                }
+            }
+
+            // the scalar is the group order itself
+            return false;
+        }
+
+        /**
+         *  Verify a signature with the table for its key
+         *
+         *  Like libsodium, we calculate s * B - h * A and compare
+         *  it to r, so we get exactly the same result. With the
+         *  tables, this needs additions only, and four doublings.
+         *
+         *  @param  key         The multiples of the key
+         *  @param  signature   The r and s values, s being reduced
+         *  @param  hash        The hash of r, the key and the message, reduced
+         *  @return Whether the signature is valid
+         */
+        bool verify_signature(const point_table &key, const uint8_t *signature, const uint8_t *hash) noexcept
+        {
+            // r must be a valid point, not of small order
+            point r_point;
+            if (!decode_point(r_point, signature) || has_small_order(r_point)) {
+                // this signature is invalid
+                return false;
+            }
+
+            // the digits of both scalars
+            std::array<int8_t, 64> s_digits;
+            std::array<int8_t, 64> h_digits;
+            radix16(s_digits, signature + 32);
+            radix16(h_digits, hash);
+
+            // the table for the base point, and the result so far
+            auto    &base = base_table();
+            point   result{ fe_zero, fe_one, fe_one, fe_zero };
+
+            // add the odd digits, for which we have no row
+            for (size_t i = 1; i < s_digits.size(); i += 2) {
+                add_multiple(result, base[i / 2], s_digits[i]);
+                add_multiple(result, key[i / 2], -h_digits[i]);
+            }
+
+            // so they are multiplied by 16
+            for (size_t i = 0; i < 4; ++i) {
+                point_double(result, result);
+            }
+
+            // before adding the even digits
+            for (size_t i = 0; i < s_digits.size(); i += 2) {
+                add_multiple(result, base[i / 2], s_digits[i]);
+                add_multiple(result, key[i / 2], -h_digits[i]);
+            }
+
+            // compare with r, which has a Z of one
+            field_element x, y;
+            fe_mul(x, r_point.X, result.Z);
+            fe_mul(y, r_point.Y, result.Z);
+            fe_sub(x, x, result.X);
+            fe_sub(y, y, result.Y);
+
+            // both coordinates must be the same
+            return fe_iszero(x) && fe_iszero(y);
+        }
+
+    }
+#endif
+
+    /**
+     *  Add a signature to verify
+     *
+     *  @param  key         The public key of the signer
+     *  @param  signature   The signature to verify
+     *  @param  digest      The digest that was signed
+     *  @throws pgp::unsupported_algorithm for unsupported curves
+     */
+    void eddsa_batch_verifier::add(const eddsa_public_key &key, const eddsa_signature &signature, span<const uint8_t> digest)
+    {
+        // we only support signatures made on the ed25519 curve
+        if (key.curve().id() != curve_id::ed25519) {
+            // we cannot verify this signature
+            throw unsupported_algorithm{ "Unsupported curve for EdDSA signatures" };
+        }
+
+        // retrieve the key and signature data
+        auto public_data    = key.Q().data();
+        auto r_data         = signature.r().data();
+        auto s_data         = signature.s().data();
+
+        // the new entry for the signature
+        auto &current = _entries.emplace_back();
+
+        // the key needs its prefix, and both values must fit in their half of the signature
+        current.valid = public_data.size() == current.key.size() + 1 && public_data[0] == 0x40 && r_data.size() <= 32 && s_data.size() <= 32 && digest.size() <= current.digest.size();
+        current.size  = 0;
+
+        // is the signature usable at all?
+        if (!current.valid) {
+            // then we don't need the data
+            return;
+        }
+
+        // skip the leading byte of the public key
+        std::copy(public_data.begin() + 1, public_data.end(), current.key.begin());
+
+        // leading zero bytes may have been dropped, so we fill these back in
+        auto iter = current.signature.begin();
+        iter = std::fill_n(iter, 32 - r_data.size(), 0);
+        iter = std::copy(r_data.begin(), r_data.end(), iter);
+        iter = std::fill_n(iter, 32 - s_data.size(), 0);
+        std::copy(s_data.begin(), s_data.end(), iter);
+
+        // and store the digest
+        std::copy(digest.begin(), digest.end(), current.digest.begin());
+        current.size = static_cast<uint8_t>(digest.size());
+    }
+
+    /**
+     *  Retrieve the number of signatures added
+     *
+     *  @return The number of signatures to verify
+     */
+    size_t eddsa_batch_verifier::size() const noexcept
+    {
+        // every entry is a signature
+        return _entries.size();
+    }
+
+    /**
+     *  Verify all the signatures added
+     *
+     *  The results are exactly those of the eddsa_signature_verifier.
+     *
+     *  @return Whether each signature is valid, in the order they were added
+     */
+    std::vector<bool> eddsa_batch_verifier::verify() const
+    {
+        // the results for all the signatures
+        std::vector<bool> results(_entries.size(), false);
+
+#ifndef __SIZEOF_INT128__
+        // we cannot do the arithmetic, so check the signatures one by one
+        for (size_t i = 0; i < _entries.size(); ++i) {
+            // the signature to verify
+            auto &current = _entries[i];
+
+            // verify it like a single signature, if it is well-formed
+            results[i] = current.valid && crypto_sign_verify_detached(current.signature.data(), current.digest.data(), current.size, current.key.data()) == 0;
+        }
+#else
+        // the well-formed signatures, grouped by the key that made them
+        std::map<std::array<uint8_t, 32>, std::vector<size_t>>  keys;
+        for (size_t i = 0; i < _entries.size(); ++i) {
+            // the signature to check
+            auto &current = _entries[i];
+
+            // skip signatures that are malformed, or where s is not reduced
+            if (current.valid && is_canonical(current.signature.data() + 32)) {
+                // add it to the signatures for the key
+                keys[current.key].push_back(i);
+            }
+        }
+
+        // the table for the current key, which is too large for the stack
+        auto table = std::make_unique<point_table>();
+
+        // verify the signatures for every key
+        for (auto &[key, indices] : keys) {
+            // do we have enough signatures to pay for the table?
+            if (indices.size() < min_signatures_per_key) {
+                // check them one by one
+                for (size_t index : indices) {
+                    // the signature to verify
+                    auto &current = _entries[index];
+
+                    // verify it like a single signature
+                    results[index] = crypto_sign_verify_detached(current.signature.data(), current.digest.data(), current.size, current.key.data()) == 0;
+                }
+                continue;
+            }
+
+            // the key must be a valid point, not of small order
+            point key_point;
+            if (!decode_point(key_point, key.data()) || has_small_order(key_point)) {
+                // so all its signatures are invalid
+                continue;
+            }
+
+            // precompute the multiples of the key
+            make_table(*table, key_point);
+
+            // and verify the signatures made with it
+            for (size_t index : indices) {
+                // the signature to verify
+                auto &current = _entries[index];
+
+                // the hash of r, the key and the message
+                std::array<uint8_t, crypto_hash_sha512_BYTES> hash;
+                crypto_hash_sha512_state state;
+                crypto_hash_sha512_init(&state);
+                crypto_hash_sha512_update(&state, current.signature.data(), 32);
+                crypto_hash_sha512_update(&state, key.data(), key.size());
+                crypto_hash_sha512_update(&state, current.digest.data(), current.size);
+                crypto_hash_sha512_final(&state, hash.data());
+
+                // reduce it to a scalar
+                std::array<uint8_t, 32> scalar;
+                crypto_core_ed25519_scalar_reduce(scalar.data(), hash.data());
+
+                // and check the signature
+                results[index] = verify_signature(*table, current.signature.data(), scalar.data());
+            }
+        }
+#endif
+
+        return results;
+    }
+
+}
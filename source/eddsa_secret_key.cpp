@@ -9,7 +9,7 @@ namespace pgp {
      *
      *  @param  k       The secret scalar for the public point
      */
-    eddsa_secret_key::eddsa_secret_key(multiprecision_integer k) noexcept :
+    eddsa_secret_key::eddsa_secret_key(secret_multiprecision_integer k) noexcept :
         _k{ std::move(k) }
     {}
 
@@ -48,7 +48,7 @@ namespace pgp {
      *
      *  @return The secret scalar for the public point
      */
-    const multiprecision_integer &eddsa_secret_key::k() const noexcept
+    const secret_multiprecision_integer &eddsa_secret_key::k() const noexcept
     {
         // return the stored scalar
         return _k;
@@ -67,4 +67,22 @@ namespace pgp {
         return _s;
     }
 
+    /**
+     *  Verify the signature over a digest
+     *
+     *  EdDSA signs the digest itself, so it is checked as
+     *  the message, like it was signed.
+     *
+     *  @param  key         The public key of the signer
+     *  @param  algorithm   The hash algorithm used for the digest
+     *  @param  digest      The digest that was signed
+     *  @return Whether the signature is valid
+     *  @throws std::runtime_error for unsupported curves
+     */
+    bool eddsa_signature::verify(const eddsa_public_key &key, hash_algorithm algorithm, span<const uint8_t> digest) const
+    {
+        // verify with a verifier for just this signature
+        return verifier_t{ key }.verify(*this, algorithm, digest);
+    }
+
 }
@@ -0,0 +1,66 @@
+#include "eddsa_signature_signer.h"
+#include <sodium/crypto_sign.h>
+#include <algorithm>
+#include <cassert>
+#include "allocator.h"
+
+
+namespace pgp {
+
+    /**
+     *  Constructor
+     *
+     *  @param  key     The secret key to sign with
+     */
+    eddsa_signature_signer::eddsa_signature_signer(const basic_secret_key<eddsa_public_key, eddsa_secret_key> &key)
+    {
+        // allocate the buffer for the key in secure memory
+        auto key_data = std::allocate_shared<key_data_t>(allocator<key_data_t>{});
+
+        // retrieve the key data - ignore the silly leading byte from the public key
+        auto public_data = key.Q().data().subspan<1>();
+        auto secret_data = key.k().data();
+
+        // make sure the key fits within the provided key_data structure
+        assert(public_data.size() <= 32);
+        assert(secret_data.size() <= 32);
+
+        // the iterator to work with
+        auto iter = key_data->begin();
+
+        // if leading key bytes were missing (due to them being zero) we have to
+        // prefill this with zeroes to avoid libsodium being fed uninitialized data
+        iter = std::fill_n(iter, 32 - secret_data.size(), 0);
+        iter = std::copy(secret_data.begin(), secret_data.end(), iter);
+
+        // the public key data might also be missing leading bytes if they were zero
+        // so we should similary prefill it
+        iter = std::fill_n(iter, 32 - public_data.size(), 0);
+        std::copy(public_data.begin(), public_data.end(), iter);
+
+        // the key is ready for use
+        _key = std::move(key_data);
+    }
+
+    /**
+     *  Sign a digest
+     *
+     *  @param  digest  The digest to sign
+     *  @return Tuple of the r and s parameters for the EdDSA signature
+     */
+    std::tuple<multiprecision_integer, multiprecision_integer> eddsa_signature_signer::sign(span<const uint8_t> digest) const noexcept
+    {
+        // the buffer for the signed message
+        std::array<uint8_t, crypto_sign_BYTES> signed_message;
+
+        // now sign the message
+        crypto_sign_detached(signed_message.data(), nullptr, digest.data(), digest.size(), _key->data());
+
+        // split up the data and return it
+        return std::make_tuple(
+            multiprecision_integer{span{ signed_message.data(),      32 }},
+            multiprecision_integer{span{ signed_message.data() + 32, 32 }}
+        );
+    }
+
+}
@@ -0,0 +1,74 @@
+#include "eddsa_signature_verifier.h"
+#include <algorithm>
+#include "eddsa_signature.h"
+#include "unsupported_algorithm.h"
+
+
+namespace pgp {
+
+    /**
+     *  Constructor
+     *
+     *  @param  key     The public key of the signer
+     */
+    eddsa_signature_verifier::eddsa_signature_verifier(const eddsa_public_key &key) noexcept :
+        _supported{ key.curve().id() == curve_id::ed25519 }
+    {
+        // retrieve the public key data
+        auto public_data = key.Q().data();
+
+        // the public key is prefixed by a byte that is not part of the key
+        _valid = public_data.size() == _key.size() + 1 && public_data[0] == 0x40;
+
+        // can we use the key?
+        if (_valid) {
+            // skip the leading byte of the public key
+            std::copy(public_data.begin() + 1, public_data.end(), _key.begin());
+        }
+    }
+
+    /**
+     *  Verify a signature over a digest
+     *
+     *  EdDSA signs the digest itself, so it is checked as
+     *  the message, like it was signed.
+     *
+     *  @param  signature   The signature to verify
+     *  @param  algorithm   The hash algorithm used for the digest
+     *  @param  digest      The digest that was signed
+     *  @return Whether the signature is valid
+     *  @throws pgp::unsupported_algorithm for unsupported curves
+     */
+    bool eddsa_signature_verifier::verify(const eddsa_signature &signature, hash_algorithm, span<const uint8_t> digest) const
+    {
+        // we only support signatures made on the ed25519 curve
+        if (!_supported) {
+            // we cannot verify this signature
+            throw unsupported_algorithm{ "Unsupported curve for EdDSA signatures" };
+        }
+
+        // retrieve the signature values
+        auto r_data = signature.r().data();
+        auto s_data = signature.s().data();
+
+        // the key must be valid, and both values must fit in their half of the signature
+        if (!_valid || r_data.size() > 32 || s_data.size() > 32) {
+            // this is not a valid signature
+            return false;
+        }
+
+        // the buffer for the signature
+        std::array<uint8_t, crypto_sign_BYTES> signature_data;
+
+        // leading zero bytes may have been dropped, so we fill these back in
+        auto iter = signature_data.begin();
+        iter = std::fill_n(iter, 32 - r_data.size(), 0);
+        iter = std::copy(r_data.begin(), r_data.end(), iter);
+        iter = std::fill_n(iter, 32 - s_data.size(), 0);
+        std::copy(s_data.begin(), s_data.end(), iter);
+
+        // now verify the signature over the digest
+        return crypto_sign_verify_detached(signature_data.data(), digest.data(), digest.size(), _key.data()) == 0;
+    }
+
+}
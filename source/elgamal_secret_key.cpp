@@ -9,7 +9,7 @@ namespace pgp {
      *
      *  @param  x       The secret exponent x
      */
-    elgamal_secret_key::elgamal_secret_key(multiprecision_integer x) noexcept :
+    elgamal_secret_key::elgamal_secret_key(secret_multiprecision_integer x) noexcept :
         _x{ std::move(x) }
     {}
 
@@ -48,7 +48,7 @@ namespace pgp {
      *
      *  @return The secret exponent x
      */
-    const multiprecision_integer &elgamal_secret_key::x() const noexcept
+    const secret_multiprecision_integer &elgamal_secret_key::x() const noexcept
     {
         // return the secret exponent
         return _x;
@@ -0,0 +1,144 @@
+#include "iovec_encoder.h"
+
+
+namespace pgp {
+
+    /**
+     *  Constructor
+     *
+     *  @param  reference_threshold     Blobs at least this size are referenced instead of copied
+     */
+    iovec_encoder::iovec_encoder(size_t reference_threshold) noexcept :
+        _reference_threshold{ reference_threshold }
+    {}
+
+    /**
+     *  Flush the encoder, so any partial-written bytes
+     *  are written out. Note that after this operation,
+     *  bitwise operations start at the beginning again.
+     */
+    void iovec_encoder::flush()
+    {
+        // do we have any partially-filled bytes?
+        if (_skip_bits > 0) {
+            // write out the current byte
+            auto current = _current;
+            _current = 0;
+            _skip_bits = 0;
+            stage(span<const uint8_t>{ &current, 1 });
+        }
+    }
+
+    /**
+     *  Retrieve the number of encoded bytes
+     *  @return The number of bytes in all the buffers
+     */
+    size_t iovec_encoder::size() const noexcept
+    {
+        // return the number of bytes in the segments
+        return _size;
+    }
+
+    /**
+     *  Retrieve the buffers holding the encoded data
+     *
+     *  The buffers are valid until more data is encoded. Note
+     *  that the number of buffers may exceed IOV_MAX, in which
+     *  case they must be written using multiple calls.
+     *
+     *  @return The buffers, in order
+     */
+    std::vector<iovec> iovec_encoder::buffers() const
+    {
+        // the buffers to return
+        std::vector<iovec> result;
+        result.reserve(_segments.size());
+
+        // process all the segments
+        for (auto &segment : _segments) {
+            // staged segments are located in the staging buffer, which
+            // may have moved while encoding, so we resolve them here
+            auto *data = segment.data ? segment.data : _staging.data() + segment.offset;
+
+            // iovec is used for both reading and writing, so it
+            // holds a mutable pointer, but the data is never changed
+            result.push_back(iovec{ const_cast<uint8_t*>(data), segment.size });
+        }
+
+        // return the buffers
+        return result;
+    }
+
+    /**
+     *  Copy data to the staging buffer
+     *
+     *  @param  data    The data to copy
+     */
+    void iovec_encoder::stage(span<const uint8_t> data)
+    {
+        // does the last segment end at the end of the staging buffer?
+        if (_segments.empty() || _segments.back().data != nullptr) {
+            // no, start a new staged segment
+            _segments.push_back(segment{ nullptr, _staging.size(), 0 });
+        }
+
+        // copy the data and extend the segment
+        _staging.insert(_staging.end(), data.begin(), data.end());
+        _segments.back().size += data.size();
+        _size += data.size();
+    }
+
+    /**
+     *  Add a reference to external data
+     *
+     *  @param  data    The data to refer to
+     */
+    void iovec_encoder::reference(span<const uint8_t> data)
+    {
+        // add a segment referring to the data
+        _segments.push_back(segment{ data.data(), 0, static_cast<size_t>(data.size()) });
+        _size += data.size();
+    }
+
+    /**
+     *  Insert one or more bits
+     *
+     *  @param  count   The number of bits to insert
+     *  @param  value   The value to store in the bits
+     *  @return self, for chaining
+     *  @throws std::out_of_range, std::range_error
+     */
+    iovec_encoder &iovec_encoder::insert_bits(size_t count, uint8_t value)
+    {
+        // check whether the number fits within the given bit-size
+        if (value > (1U << count) - 1U) {
+            // the value is too large to encode
+            throw std::range_error{ "Cannot encode value, too large for given bit-size" };
+        }
+
+        // the write may not cross a byte boundary
+        if (count + _skip_bits > 8) {
+            // cannot encode the value, does not fit within byte
+            throw std::out_of_range{ "Cannot encode value, bit-wise operation may not cross byte boundaries" };
+        }
+
+        // shift the data so it fits with the existing data and add it
+        _current |= static_cast<uint8_t>(value << static_cast<uint8_t>(8U - _skip_bits - count));
+
+        // do we move on to the next byte?
+        if (count + _skip_bits == 8) {
+            // store the byte now
+            auto current = _current;
+            _current = 0;
+            _skip_bits = 0;
+            stage(span<const uint8_t>{ &current, 1 });
+        } else {
+            // just increment the bits to skip
+            _skip_bits += count;
+        }
+
+        // allow chaining
+        return *this;
+    }
+
+}
@@ -0,0 +1,230 @@
+#include "key_view.h"
+#include <algorithm>
+
+
+namespace pgp {
+
+    /**
+     *  Constructor
+     *
+     *  @param  tag     The tag of the packet holding the key
+     *  @param  data    The encoded key data to refer to
+     *  @throws std::out_of_range, std::range_error
+     */
+    key_view::key_view(packet_tag tag, span<const uint8_t> data) :
+        _tag{ tag },
+        _data{ data }
+    {
+        // the decoder to parse the fields from
+        decoder parser{ data };
+
+        // check the version and read the base fields
+        expected_number<uint8_t, 4>{ parser };
+        _creation_time  = parser.extract_number<uint32_t>();
+        _algorithm      = key_algorithm{ parser.extract_number<uint8_t>() };
+
+        // the public key material starts here
+        auto public_offset = data.size() - parser.size();
+
+        // read a number of integers from the key data
+        auto read_integers = [this, &parser](size_t count) {
+            // read the requested number of integers
+            while (_integer_count < count) {
+                // add another integer
+                _integers[_integer_count++] = mpi_view{ parser };
+            }
+        };
+
+        // read the curve identifier from the key data
+        auto read_curve = [this, &parser]() {
+            // the identifier is prefixed by its size
+            _curve = parser.extract_blob<uint8_t>(parser.extract_number<uint8_t>());
+        };
+
+        // which fields are present depends on the algorithm
+        switch (_algorithm) {
+            case key_algorithm::rsa_encrypt_or_sign:
+            case key_algorithm::rsa_encrypt_only:
+            case key_algorithm::rsa_sign_only:
+                // the modulus n and exponent e
+                read_integers(2);
+                break;
+            case key_algorithm::elgamal_encrypt_only:
+                // the prime p, generator g and public value y
+                read_integers(3);
+                break;
+            case key_algorithm::dsa:
+                // the primes p and q, generator g and public value y
+                read_integers(4);
+                break;
+            case key_algorithm::ecdh:
+                // the curve and point Q, followed by the kdf parameters
+                read_curve();
+                read_integers(1);
+                parser.extract_blob<uint8_t>(parser.extract_number<uint8_t>());
+                break;
+            case key_algorithm::eddsa:
+            case key_algorithm::ecdsa:
+                // the curve and the public point Q
+                read_curve();
+                read_integers(1);
+                break;
+            default:
+                // we do not know the key format, so consider
+                // all remaining data to be the public key
+                parser.extract_blob<uint8_t>(parser.size());
+                _unknown = true;
+                break;
+        }
+
+        // everything up to here is the public key, the rest is secret
+        _public_data    = data.subspan(public_offset, data.size() - parser.size() - public_offset);
+        _secret_data    = data.subspan(data.size() - parser.size());
+    }
+
+    /**
+     *  Comparison operators
+     *
+     *  @param  other   The object to compare with
+     */
+    bool key_view::operator==(const key_view &other) const noexcept
+    {
+        return tag() == other.tag() && _data == other._data;
+    }
+
+    /**
+     *  Comparison operators
+     *
+     *  @param  other   The object to compare with
+     */
+    bool key_view::operator!=(const key_view &other) const noexcept
+    {
+        return !operator==(other);
+    }
+
+    /**
+     *  Retrieve the packet tag used for this
+     *  packet type
+     *  @return The packet type to use
+     */
+    packet_tag key_view::tag() const noexcept
+    {
+        // return the tag of the packet we were read from
+        return _tag;
+    }
+
+    /**
+     *  Determine the size used in encoded format
+     *  @return The number of bytes used for encoded storage
+     */
+    size_t key_view::size() const noexcept
+    {
+        // this is the size of the referenced data
+        return _data.size();
+    }
+
+    /**
+     *  Get the creation time
+     *  @return UNIX timestamp with key creation time
+     */
+    uint32_t key_view::creation_time() const noexcept
+    {
+        // return the creation time of the key
+        return _creation_time;
+    }
+
+    /**
+     *  Retrieve the key algorithm
+     *  @return The algorithm used in the key
+     */
+    key_algorithm key_view::algorithm() const noexcept
+    {
+        // return the algorithm of the key
+        return _algorithm;
+    }
+
+    /**
+     *  Retrieve the curve object identifier, this is
+     *  empty for algorithms not using elliptic curves
+     *
+     *  @return The curve object identifier
+     */
+    span<const uint8_t> key_view::curve() const noexcept
+    {
+        // return the referenced curve identifier
+        return _curve;
+    }
+
+    /**
+     *  Retrieve the integers making up the public key,
+     *  e.g. n and e for RSA or Q for curve-based keys
+     *
+     *  @return The public key integers
+     */
+    span<const mpi_view> key_view::integers() const noexcept
+    {
+        // return only the integers that are in use
+        return span<const mpi_view>{ _integers.data(), _integer_count };
+    }
+
+    /**
+     *  Retrieve the algorithm-specific public key material
+     *
+     *  @return The encoded public key fields
+     */
+    span<const uint8_t> key_view::public_data() const noexcept
+    {
+        // return the referenced public key data
+        return _public_data;
+    }
+
+    /**
+     *  Retrieve the secret key material, which is empty
+     *  for public keys and may be encrypted for secret keys
+     *
+     *  @return The encoded secret key fields
+     */
+    span<const uint8_t> key_view::secret_data() const noexcept
+    {
+        // return the referenced secret key data
+        return _secret_data;
+    }
+
+    /**
+     *  Retrieve the fingerprint for this key
+     *
+     *  @return The 20-byte fingerprint
+     *  @throws std::runtime_error for secret keys with an unknown algorithm
+     */
+    std::array<uint8_t, 20> key_view::fingerprint() const
+    {
+        // the hashing context to create the fingerprint
+        sha1_encoder    encoder;
+
+        // hash the key into the context
+        hash(encoder);
+
+        // return the resulting digest
+        return encoder.digest();
+    }
+
+    /**
+     *  Retrieve the key ID for this key
+     *
+     *  @return The 8-byte key ID
+     *  @throws std::runtime_error for secret keys with an unknown algorithm
+     */
+    std::array<uint8_t, 8> key_view::key_id() const
+    {
+        // obtain the fingerprint
+        std::array<uint8_t, 20> print{ fingerprint() };
+
+        // copy the last 8 bytes into the result container
+        std::array<uint8_t, 8>  result;
+        std::copy(print.begin() + 12, print.end(), result.begin());
+
+        // return the result
+        return result;
+    }
+
+}
@@ -0,0 +1,125 @@
+#include "keyring.h"
+
+
+namespace pgp {
+
+    namespace {
+
+        /**
+         *  Decode all the packets in a keyring
+         *
+         *  @param  parser  The decoder holding the keyring data
+         *  @param  result  The container to add the packets to
+         *  @return The decoded packets, in order
+         *  @throws std::runtime_error, std::out_of_range, std::range_error
+         */
+        template <class container_t>
+        container_t decode_packets(decoder parser, container_t result)
+        {
+            // keep going until all data is read
+            while (!parser.empty()) {
+                // decode the next packet
+                result.emplace_back(parser);
+            }
+
+            // return the decoded packets
+            return result;
+        }
+
+        /**
+         *  Decode all the packets in a keyring, without raising
+         *  an exception when the data turns out to be malformed
+         *
+         *  @param  parser  The decoder holding the keyring data
+         *  @param  error   The error the decoder reports to
+         *  @param  result  The container to add the packets to
+         *  @return The decoded packets, in order, or the first error encountered
+         */
+        template <class container_t>
+        expected<container_t, decode_error> try_decode_packets(decoder parser, const decode_error &error, container_t result)
+        {
+            // keep going until all data is read
+            while (!parser.empty()) {
+                // decode the next packet
+                result.emplace_back(parser);
+
+                // was the packet malformed?
+                if (error) {
+                    // stop at the first error
+                    return unexpected<decode_error>{ error };
+                }
+            }
+
+            // return the decoded packets
+            return result;
+        }
+
+    }
+
+    /**
+     *  Decode all the packets in a keyring
+     *
+     *  @param  data    The encoded keyring data
+     *  @return The decoded packets, in order
+     *  @throws std::runtime_error, std::out_of_range, std::range_error
+     */
+    std::vector<packet> decode_keyring(span<const uint8_t> data)
+    {
+        // decode into an ordinary vector
+        return decode_packets(decoder{ data }, std::vector<packet>{});
+    }
+
+    /**
+     *  Decode all the packets in a keyring, without raising
+     *  an exception when the data turns out to be malformed
+     *
+     *  @param  data    The encoded keyring data
+     *  @return The decoded packets, in order, or the first error encountered
+     */
+    expected<std::vector<packet>, decode_error> try_decode_keyring(span<const uint8_t> data)
+    {
+        // the error to report malformed data to
+        decode_error error;
+
+        // decode into an ordinary vector
+        return try_decode_packets(decoder{ data, error }, error, std::vector<packet>{});
+    }
+
+#ifdef PGP_HAS_MEMORY_RESOURCE
+
+    /**
+     *  Decode all the packets in a keyring, allocating the
+     *  packets and all data they hold from the given resource
+     *
+     *  @param  data        The encoded keyring data
+     *  @param  resource    The resource to allocate from
+     *  @return The decoded packets, in order
+     *  @throws std::runtime_error, std::out_of_range, std::range_error
+     */
+    resource_vector<packet> decode_keyring(span<const uint8_t> data, std::pmr::memory_resource &resource)
+    {
+        // the packets and their data are allocated from the resource
+        return decode_packets(decoder{ data, resource }, resource_vector<packet>( resource_allocator<packet>{ &resource } ));
+    }
+
+    /**
+     *  Decode all the packets in a keyring, allocating from the
+     *  given resource, without raising an exception when the data
+     *  turns out to be malformed
+     *
+     *  @param  data        The encoded keyring data
+     *  @param  resource    The resource to allocate from
+     *  @return The decoded packets, in order, or the first error encountered
+     */
+    expected<resource_vector<packet>, decode_error> try_decode_keyring(span<const uint8_t> data, std::pmr::memory_resource &resource)
+    {
+        // the error to report malformed data to
+        decode_error error;
+
+        // the packets and their data are allocated from the resource
+        return try_decode_packets(decoder{ data, resource, error }, error, resource_vector<packet>( resource_allocator<packet>{ &resource } ));
+    }
+
+#endif
+
+}
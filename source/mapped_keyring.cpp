@@ -0,0 +1,193 @@
+#include "mapped_keyring.h"
+#include <cerrno>
+#include <system_error>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace pgp {
+
+    namespace {
+
+        /**
+         *  Raise an error for the last failed system call
+         *
+         *  @param  message The description of what failed
+         *  @throws std::system_error
+         */
+        [[noreturn]] void raise_error(const char *message)
+        {
+            // wrap the error number in an exception
+            throw std::system_error{ errno, std::generic_category(), message };
+        }
+
+    }
+
+    /**
+     *  Constructor
+     *
+     *  @param  path    The path of the keyring file to map
+     *  @param  pattern The expected access pattern
+     *  @throws std::system_error
+     */
+    mapped_keyring::mapped_keyring(const std::string &path, access_pattern pattern)
+    {
+        // open the file for reading
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+        // did we manage to open the file?
+        if (fd < 0) {
+            // the file cannot be read
+            raise_error("Failed to open keyring");
+        }
+
+        // map the file, making sure the descriptor is closed afterwards
+        try {
+            // move a mapping of the descriptor into ourselves
+            *this = mapped_keyring{ fd, pattern };
+        } catch (...) {
+            // close the file and report the error
+            ::close(fd);
+            throw;
+        }
+
+        // the mapping stays valid without the descriptor
+        ::close(fd);
+    }
+
+    /**
+     *  Constructor
+     *
+     *  @param  fd      The file descriptor of the keyring to map,
+     *                  which may be closed after construction
+     *  @param  pattern The expected access pattern
+     *  @throws std::system_error
+     */
+    mapped_keyring::mapped_keyring(int fd, access_pattern pattern)
+    {
+        // the file information, we need its size
+        struct stat info;
+
+        // retrieve the file information
+        if (::fstat(fd, &info) != 0) {
+            // we cannot map without knowing the size
+            raise_error("Failed to determine keyring size");
+        }
+
+        // an empty file cannot be mapped, but also needs no mapping
+        if (info.st_size == 0) {
+            // leave the mapping empty
+            return;
+        }
+
+        // map the whole file for reading
+        auto *mapping = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+        // did the mapping succeed?
+        if (mapping == MAP_FAILED) {
+            // the file could not be mapped
+            raise_error("Failed to map keyring");
+        }
+
+        // store the mapped range
+        _data = static_cast<const uint8_t*>(mapping);
+        _size = static_cast<size_t>(info.st_size);
+
+        // tell the kernel how we are going to read it
+        advise(pattern);
+    }
+
+    /**
+     *  Move constructor
+     *
+     *  @param  that    The mapping to move
+     */
+    mapped_keyring::mapped_keyring(mapped_keyring &&that) noexcept :
+        _data{ std::exchange(that._data, nullptr) },
+        _size{ std::exchange(that._size, 0) }
+    {}
+
+    /**
+     *  Destructor
+     */
+    mapped_keyring::~mapped_keyring()
+    {
+        // do we have a mapping to clean up?
+        if (_data != nullptr) {
+            // release the mapping
+            ::munmap(const_cast<uint8_t*>(_data), _size);
+        }
+    }
+
+    /**
+     *  Assignment operator, only using move
+     *
+     *  @param  that    The mapping to assign
+     */
+    mapped_keyring &mapped_keyring::operator=(mapped_keyring &&that) noexcept
+    {
+        // swap the mappings, so ours is cleaned up by the other object
+        std::swap(_data, that._data);
+        std::swap(_size, that._size);
+
+        // allow chaining
+        return *this;
+    }
+
+    /**
+     *  Change the expected access pattern
+     *
+     *  @param  pattern The expected access pattern
+     */
+    void mapped_keyring::advise(access_pattern pattern) const noexcept
+    {
+        // there is nothing to advise without a mapping
+        if (_data == nullptr) {
+            // nothing is mapped
+            return;
+        }
+
+        // convert the pattern to the advice for the kernel
+        int advice = pattern == access_pattern::sequential ? MADV_SEQUENTIAL : MADV_RANDOM;
+
+        // the advice is only a hint, so failure is not an error
+        ::madvise(const_cast<uint8_t*>(_data), _size, advice);
+    }
+
+    /**
+     *  Retrieve the size of the mapped data
+     *
+     *  @return The number of bytes in the keyring
+     */
+    size_t mapped_keyring::size() const noexcept
+    {
+        // return the size of the mapping
+        return _size;
+    }
+
+    /**
+     *  Retrieve the mapped data
+     *
+     *  @return The range of mapped keyring data
+     */
+    span<const uint8_t> mapped_keyring::data() const noexcept
+    {
+        // provide access to the mapping
+        return span<const uint8_t>{ _data, _size };
+    }
+
+    /**
+     *  Create a decoder over the mapped data
+     *
+     *  @return The decoder to parse the keyring with
+     */
+    decoder mapped_keyring::parser() const noexcept
+    {
+        // decode from the mapped range
+        return decoder{ data() };
+    }
+
+}
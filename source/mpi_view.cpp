@@ -0,0 +1,56 @@
+#include "mpi_view.h"
+
+
+namespace pgp {
+
+    /**
+     *  Comparison operators
+     *
+     *  @param  other   The object to compare with
+     */
+    bool mpi_view::operator==(const mpi_view &other) const noexcept
+    {
+        return data() == other.data();
+    }
+
+    /**
+     *  Comparison operators
+     *
+     *  @param  other   The object to compare with
+     */
+    bool mpi_view::operator!=(const mpi_view &other) const noexcept
+    {
+        return !operator==(other);
+    }
+
+    /**
+     *  Determine the size used in encoded format
+     *  @return The number of bytes used for encoded storage
+     */
+    size_t mpi_view::size() const noexcept
+    {
+        // two bytes for the header plus all the fields
+        return _bits.size() + _data.size();
+    }
+
+    /**
+     *  Retrieve the data
+     *  @return A span containing all the integer numbers
+     */
+    span<const uint8_t> mpi_view::data() const noexcept
+    {
+        // provide access to the referenced data
+        return _data;
+    }
+
+    /**
+     *  Convert to an owning integer, copying the data
+     *  @return The integer holding a copy of the data
+     */
+    mpi_view::operator multiprecision_integer() const
+    {
+        // copy the data into a new integer
+        return multiprecision_integer{ _data };
+    }
+
+}
@@ -38,12 +38,24 @@ namespace pgp {
 
     }
 
+    /**
+     *  Constructor
+     *
+     *  @param  that    The integer to copy or move
+     */
+    template <class storage_t>
+    basic_multiprecision_integer<storage_t>::basic_multiprecision_integer(const basic_multiprecision_integer &that) = default;
+
+    template <class storage_t>
+    basic_multiprecision_integer<storage_t>::basic_multiprecision_integer(basic_multiprecision_integer &&that) = default;
+
     /**
      *  Constructor
      *
      *  @param  data    The range of numbers
      */
-    multiprecision_integer::multiprecision_integer(span<const uint8_t> data) noexcept
+    template <class storage_t>
+    basic_multiprecision_integer<storage_t>::basic_multiprecision_integer(span<const uint8_t> data) noexcept
     {
         // assign the data
         operator=(data);
@@ -54,7 +66,8 @@ namespace pgp {
      *
      *  @param  data    The range of numbers
      */
-    multiprecision_integer::multiprecision_integer(vector<uint8_t> data) noexcept
+    template <class storage_t>
+    basic_multiprecision_integer<storage_t>::basic_multiprecision_integer(storage_t data) noexcept
     {
         // assign the data
         operator=(std::move(data));
@@ -65,7 +78,8 @@ namespace pgp {
      *
      *  @param  integer The Crypto++ integer to convert
      */
-    multiprecision_integer::multiprecision_integer(const CryptoPP::Integer &integer) noexcept
+    template <class storage_t>
+    basic_multiprecision_integer<storage_t>::basic_multiprecision_integer(const CryptoPP::Integer &integer) noexcept
     {
         // assign the integer
         operator=(integer);
@@ -78,7 +92,8 @@ namespace pgp {
      *  @param  data    The data to assign
      *  @return Same object for chaining
      */
-    multiprecision_integer &multiprecision_integer::operator=(span<const uint8_t> data) noexcept
+    template <class storage_t>
+    basic_multiprecision_integer<storage_t> &basic_multiprecision_integer<storage_t>::operator=(span<const uint8_t> data) noexcept
     {
         // eliminate leading zeroes
         while (!data.empty() && data[0] == 0) {
@@ -105,7 +120,8 @@ namespace pgp {
         return *this;
     }
 
-    multiprecision_integer &multiprecision_integer::operator=(vector<uint8_t> data) noexcept
+    template <class storage_t>
+    basic_multiprecision_integer<storage_t> &basic_multiprecision_integer<storage_t>::operator=(storage_t data) noexcept
     {
         // erase any leading zero bytes
         data.erase(
@@ -140,7 +156,8 @@ namespace pgp {
      *  @param  integer The data to assign
      *  @return Same object for chaining
      */
-    multiprecision_integer &multiprecision_integer::operator=(const CryptoPP::Integer &integer) noexcept
+    template <class storage_t>
+    basic_multiprecision_integer<storage_t> &basic_multiprecision_integer<storage_t>::operator=(const CryptoPP::Integer &integer) noexcept
     {
         // get the number of bytes required
         size_t encoded_size = integer.MinEncodedSize();
@@ -166,7 +183,8 @@ namespace pgp {
      *
      *  @param  other   The object to compare with
      */
-    bool multiprecision_integer::operator==(const multiprecision_integer &other) const noexcept
+    template <class storage_t>
+    bool basic_multiprecision_integer<storage_t>::operator==(const basic_multiprecision_integer &other) const noexcept
     {
         return data() == other.data();
     }
@@ -176,7 +194,8 @@ namespace pgp {
      *
      *  @param  other   The object to compare with
      */
-    bool multiprecision_integer::operator!=(const multiprecision_integer &other) const noexcept
+    template <class storage_t>
+    bool basic_multiprecision_integer<storage_t>::operator!=(const basic_multiprecision_integer &other) const noexcept
     {
         return !operator==(other);
     }
@@ -185,7 +204,8 @@ namespace pgp {
      *  Determine the size used in encoded format
      *  @return The number of bytes used for encoded storage
      */
-    size_t multiprecision_integer::size() const noexcept
+    template <class storage_t>
+    size_t basic_multiprecision_integer<storage_t>::size() const noexcept
     {
         // two bytes for the header plus all the fields
         return _bits.size() + _data.size();
@@ -195,17 +215,23 @@ namespace pgp {
      *  Retrieve the data
      *  @return A span containing all the integer numbers
      */
-    span<const uint8_t> multiprecision_integer::data() const noexcept
+    template <class storage_t>
+    span<const uint8_t> basic_multiprecision_integer<storage_t>::data() const noexcept
     {
         // provide access to the underlying vector
         return _data;
     }
 
-    multiprecision_integer::operator CryptoPP::Integer() const noexcept
+    template <class storage_t>
+    basic_multiprecision_integer<storage_t>::operator CryptoPP::Integer() const noexcept
     {
         // construct the Crypto++ Integer with our data bytes; note that this
         // is correct since both are in big-endian
         return CryptoPP::Integer(_data.data(), _data.size());
     }
 
+    // instantiate the public and secret integers
+    template class basic_multiprecision_integer<boost::container::small_vector<uint8_t, multiprecision_inline_size, resource_allocator<uint8_t>>>;
+    template class basic_multiprecision_integer<vector<uint8_t>>;
+
 }
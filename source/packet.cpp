@@ -51,14 +51,8 @@ namespace pgp {
      */
     size_t packet::size() const
     {
-        // the body size to return
-        uint32_t result;
-
-        // retrieve the body
-        visit([&result](auto &body) {
-            // retrieve the size from the body
-            result = util::narrow_cast<uint32_t>(body.size());
-        }, _body);
+        // the body size, determined when the packet was created
+        uint32_t result = _body_size;
 
         // is the packet compatible with the old format?
         if (packet_tag_compatible_with_old_format(tag())) {
@@ -83,6 +77,25 @@ namespace pgp {
         }
     }
 
+    /**
+     *  Determine the size of the body in encoded format
+     *  @return The number of bytes used for the body
+     */
+    uint32_t packet::determine_body_size() const
+    {
+        // the body size to return
+        uint32_t result;
+
+        // retrieve the body
+        visit([&result](auto &body) {
+            // retrieve the size from the body
+            result = util::narrow_cast<uint32_t>(body.size());
+        }, _body);
+
+        // return the retrieved size
+        return result;
+    }
+
     /**
      *  Retrieve the decoded packet
      *
@@ -0,0 +1,41 @@
+#include "packet_header.h"
+
+
+namespace pgp {
+
+    /**
+     *  Retrieve the format the header was encoded in
+     *
+     *  @return The packet format
+     */
+    packet_format packet_header::format() const noexcept
+    {
+        // return the format of the header
+        return _format;
+    }
+
+    /**
+     *  Retrieve the packet tag
+     *  @return The packet tag, as described in https://tools.ietf.org/html/rfc4880#section-4.3
+     */
+    packet_tag packet_header::tag() const noexcept
+    {
+        // return the tag of the packet
+        return _tag;
+    }
+
+    /**
+     *  Retrieve the length of the body, or of the first chunk
+     *  of the body when the length is partial. Old-format
+     *  packets may have an indeterminate length, extending
+     *  to the end of the input, in which case nothing is set.
+     *
+     *  @return The body length, if known
+     */
+    const boost::optional<variable_number> &packet_header::size() const noexcept
+    {
+        // return the size of the body
+        return _size;
+    }
+
+}
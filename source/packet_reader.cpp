@@ -0,0 +1,264 @@
+#include "packet_reader.h"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <unistd.h>
+#include "decoder.h"
+#include "packet_header.h"
+#include "variable_number.h"
+
+
+namespace pgp {
+
+    namespace {
+
+        /**
+         *  The largest possible packet header: a tag byte followed
+         *  by a five-octet length in the new packet format
+         */
+        constexpr const size_t max_header_size = 6;
+
+        /**
+         *  Create a source reading from a file descriptor
+         *
+         *  @param  fd      The file descriptor to read from
+         *  @return The source reading from the descriptor
+         */
+        packet_reader::source_t fd_source(int fd)
+        {
+            return [fd](span<uint8_t> data) -> size_t {
+                // keep trying until we read something or the input ends
+                while (true) {
+                    // read as much as fits in the buffer
+                    auto result = ::read(fd, data.data(), data.size());
+
+                    // did we read successfully?
+                    if (result >= 0) {
+                        // return the number of bytes read
+                        return static_cast<size_t>(result);
+                    }
+
+                    // interrupted calls should simply be retried
+                    if (errno != EINTR) {
+                        // this is a genuine read error
+                        throw std::system_error{ errno, std::generic_category(), "Failed to read packet data" };
+                    }
+                }
+            };
+        }
+
+        /**
+         *  Create a source reading from an input stream
+         *
+         *  @param  stream  The stream to read from
+         *  @return The source reading from the stream
+         */
+        packet_reader::source_t stream_source(std::istream &stream)
+        {
+            return [&stream](span<uint8_t> data) -> size_t {
+                // read as much as fits in the buffer
+                stream.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+                // a failure without reaching the end is a read error
+                if (stream.bad()) {
+                    // the stream is in an unrecoverable state
+                    throw std::system_error{ std::make_error_code(std::io_errc::stream), "Failed to read packet data" };
+                }
+
+                // return the number of bytes actually read
+                return static_cast<size_t>(stream.gcount());
+            };
+        }
+
+    }
+
+    /**
+     *  Constructor
+     *
+     *  @param  source          The source to read data from
+     *  @param  buffer_size     The initial size of the refill buffer
+     */
+    packet_reader::packet_reader(source_t source, size_t buffer_size) :
+        _source{ std::move(source) }
+    {
+        // allocate the refill buffer, we need room for at least a header
+        _buffer.resize(std::max(buffer_size, max_header_size));
+    }
+
+    /**
+     *  Constructor
+     *
+     *  @param  fd              The file descriptor to read data from
+     *  @param  buffer_size     The initial size of the refill buffer
+     */
+    packet_reader::packet_reader(int fd, size_t buffer_size) :
+        packet_reader{ fd_source(fd), buffer_size }
+    {}
+
+    /**
+     *  Constructor
+     *
+     *  @param  stream          The stream to read data from
+     *  @param  buffer_size     The initial size of the refill buffer
+     */
+    packet_reader::packet_reader(std::istream &stream, size_t buffer_size) :
+        packet_reader{ stream_source(stream), buffer_size }
+    {}
+
+    /**
+     *  Read the next packet from the source
+     *
+     *  @return The decoded packet, or nothing when the input is exhausted
+     *  @throws std::out_of_range for truncated input, std::runtime_error
+     *          for malformed packets and std::system_error on read errors
+     */
+    boost::optional<packet> packet_reader::next()
+    {
+        // make sure we have a complete header, unless the input ends before that
+        fill(max_header_size);
+
+        // if there is no more data, we have read all packets
+        if (buffered().empty()) {
+            // no packet left to read
+            return boost::none;
+        }
+
+        // parse the header to find out how much data the packet needs
+        decoder         parser{ buffered() };
+        packet_header   header{ parser };
+        auto            size = header.size();
+
+        // the total number of bytes the packet occupies
+        size_t total = buffered().size() - parser.size();
+
+        // do we know the size of the body?
+        if (size) {
+            // walk over the chunks of a body split up using partial lengths
+            while (size->is_partial()) {
+                // we need the chunk and the length of the next chunk,
+                // though that may be shorter than the maximum size
+                total += *size;
+                fill(total + max_header_size - 1);
+
+                // there must be at least some data for the next length
+                if (buffered().size() <= total) {
+                    // the input ended halfway through the packet
+                    throw std::out_of_range{ "Not enough data available to read packet" };
+                }
+
+                // read the length of the next chunk
+                decoder length_parser{ buffered().subspan(total) };
+                size = variable_number{ length_parser };
+                total = buffered().size() - length_parser.size();
+            }
+
+            // we need the header and the complete (final) body chunk
+            total += *size;
+
+            // read in the rest of the packet
+            if (!fill(total)) {
+                // the input ended halfway through the packet
+                throw std::out_of_range{ "Not enough data available to read packet" };
+            }
+        } else {
+            // the packet extends until the end of the input
+            fill_all();
+            total = buffered().size();
+        }
+
+        // decode the packet from the buffered data
+        decoder packet_parser{ buffered().first(total) };
+        packet  result{ packet_parser };
+
+        // the data has now been consumed
+        _begin += total;
+
+        // return the decoded packet
+        return result;
+    }
+
+    /**
+     *  Retrieve the current size of the refill buffer
+     *
+     *  @return The number of bytes allocated for buffering
+     */
+    size_t packet_reader::buffer_size() const noexcept
+    {
+        // return the allocated buffer size
+        return _buffer.size();
+    }
+
+    /**
+     *  Retrieve the data currently buffered
+     *
+     *  @return The range of buffered, unconsumed data
+     */
+    span<const uint8_t> packet_reader::buffered() const noexcept
+    {
+        // provide access to the unconsumed part of the buffer
+        return span<const uint8_t>{ _buffer.data() + _begin, _end - _begin };
+    }
+
+    /**
+     *  Ensure a number of bytes is buffered
+     *
+     *  @param  size    The number of bytes we require
+     *  @return Whether the requested number of bytes is available,
+     *          this is only false when the input is exhausted
+     *  @throws std::system_error
+     */
+    bool packet_reader::fill(size_t size)
+    {
+        // keep reading until we have enough data
+        while (_end - _begin < size) {
+            // we cannot read any more data if the source ran dry
+            if (_exhausted) {
+                // not enough data left
+                return false;
+            }
+
+            // is there not enough room left after the buffered data?
+            if (_buffer.size() - _begin < size) {
+                // move the unconsumed data to the front of the buffer
+                std::memmove(_buffer.data(), _buffer.data() + _begin, _end - _begin);
+                _end   -= _begin;
+                _begin  = 0;
+
+                // a single packet may be larger than the buffer
+                if (_buffer.size() < size) {
+                    // grow the buffer to hold the packet
+                    _buffer.resize(size);
+                }
+            }
+
+            // read more data into the free space of the buffer
+            auto count = _source(span<uint8_t>{ _buffer.data() + _end, _buffer.size() - _end });
+
+            // did the source run dry?
+            if (count == 0) {
+                // no more data is coming
+                _exhausted = true;
+            }
+
+            // register the newly read data
+            _end += count;
+        }
+
+        // we have all the data we need
+        return true;
+    }
+
+    /**
+     *  Buffer all remaining data from the input
+     *
+     *  @throws std::system_error
+     */
+    void packet_reader::fill_all()
+    {
+        // keep asking for more data than we have, doubling
+        // the buffer until the input is completely read
+        while (fill(std::max(_buffer.size(), (_end - _begin) * 2))) {}
+    }
+
+}
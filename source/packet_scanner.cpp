@@ -0,0 +1,69 @@
+#include "packet_scanner.h"
+#include "packet_header.h"
+#include "decoder.h"
+#include "util/narrow_cast.h"
+
+
+namespace pgp {
+
+    /**
+     *  Find the location of all the packets in the given data
+     *
+     *  This only decodes the packet headers, the bodies are skipped
+     *  over without being parsed. For bodies using partial lengths,
+     *  the body size includes the lengths of all following chunks.
+     *
+     *  @param  data    The encoded packets to scan
+     *  @return The location of every packet, in order
+     *  @throws std::runtime_error for invalid headers
+     *          and std::out_of_range for truncated data
+     */
+    std::vector<packet_location> scan_packets(span<const uint8_t> data)
+    {
+        // the locations we found and the decoder to read headers with
+        std::vector<packet_location>    result;
+        decoder                         parser{ data };
+
+        // keep going until all data is scanned
+        while (!parser.empty()) {
+            // the offset at which the packet starts
+            uint64_t offset = data.size() - parser.size();
+
+            // decode the packet header
+            packet_header   header{ parser };
+            auto            header_end = data.size() - parser.size();
+
+            // the size of the body, in case it is known
+            auto size = header.size();
+
+            // does the body extend until the end of the data?
+            if (!size) {
+                // skip over all the remaining data
+                parser.extract_blob<uint8_t>(parser.size());
+            } else {
+                // skip over any chunks of a body using partial lengths
+                while (size->is_partial()) {
+                    // skip the chunk and read the length of the next one
+                    parser.extract_blob<uint8_t>(*size);
+                    size = variable_number{ parser };
+                }
+
+                // skip over the (final chunk of the) body
+                parser.extract_blob<uint8_t>(*size);
+            }
+
+            // register the location of the packet
+            result.push_back(packet_location{
+                offset,
+                data.size() - parser.size() - header_end,
+                util::narrow_cast<uint8_t>(header_end - offset),
+                header.tag(),
+                header.format()
+            });
+        }
+
+        // return all the packets we found
+        return result;
+    }
+
+}
@@ -0,0 +1,87 @@
+#include "packet_view.h"
+
+
+namespace pgp {
+
+    /**
+     *  Comparison operators
+     *
+     *  @param  other   The object to compare with
+     */
+    bool packet_view::operator==(const packet_view &other) const noexcept
+    {
+        return tag() == other.tag() && data() == other.data();
+    }
+
+    /**
+     *  Comparison operators
+     *
+     *  @param  other   The object to compare with
+     */
+    bool packet_view::operator!=(const packet_view &other) const noexcept
+    {
+        return !operator==(other);
+    }
+
+    /**
+     *  Retrieve the packet tag
+     *  @return The packet tag, as described in https://tools.ietf.org/html/rfc4880#section-4.3
+     */
+    packet_tag packet_view::tag() const noexcept
+    {
+        // return the tag from the header
+        return _tag;
+    }
+
+    /**
+     *  Retrieve the encoded body data
+     *
+     *  @return The referenced body of the packet
+     */
+    span<const uint8_t> packet_view::data() const noexcept
+    {
+        // return the referenced body
+        return _data;
+    }
+
+    /**
+     *  Retrieve the decoded packet view
+     *
+     *  @return The view on the packet that was parsed
+     */
+    const packet_view::view_variant &packet_view::body() const noexcept
+    {
+        // return the decoded body
+        return _body;
+    }
+
+    /**
+     *  Convert to an owning packet, copying the data
+     *
+     *  @return The packet holding a copy of the data
+     *  @throws std::out_of_range, std::range_error
+     */
+    packet_view::operator packet() const
+    {
+        // packets we cannot decode are copied as raw data
+        if (holds_alternative<unknown_packet>(_body)) {
+            // keep the tag and the body
+            return packet{ in_place_type_t<unknown_packet>{}, _tag, _data };
+        }
+
+        // the decoder for the body data
+        decoder parser{ _data };
+
+        // decode the owning body type matching the tag
+        switch (_tag) {
+            case packet_tag::signature:     return packet{ in_place_type_t<signature>{},        parser };
+            case packet_tag::secret_key:    return packet{ in_place_type_t<secret_key>{},       parser };
+            case packet_tag::public_key:    return packet{ in_place_type_t<public_key>{},       parser };
+            case packet_tag::secret_subkey: return packet{ in_place_type_t<secret_subkey>{},    parser };
+            case packet_tag::user_id:       return packet{ in_place_type_t<user_id>{},          parser };
+            case packet_tag::public_subkey: return packet{ in_place_type_t<public_subkey>{},    parser };
+            default:                        return packet{ in_place_type_t<unknown_packet>{},   _tag, _data };
+        }
+    }
+
+}
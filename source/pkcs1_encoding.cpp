@@ -0,0 +1,80 @@
+#include "pkcs1_encoding.h"
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include "unsupported_algorithm.h"
+
+
+namespace pgp {
+
+    namespace {
+
+        /**
+         *  The DER encoded DigestInfo prefixes for the supported hash algorithms
+         */
+        constexpr std::array<uint8_t, 15> sha1_prefix   { 0x30, 0x21, 0x30, 0x09, 0x06, 0x05, 0x2b, 0x0e, 0x03, 0x02, 0x1a, 0x05, 0x00, 0x04, 0x14 };
+        constexpr std::array<uint8_t, 19> sha224_prefix { 0x30, 0x2d, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x04, 0x05, 0x00, 0x04, 0x1c };
+        constexpr std::array<uint8_t, 19> sha256_prefix { 0x30, 0x31, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x01, 0x05, 0x00, 0x04, 0x20 };
+        constexpr std::array<uint8_t, 19> sha384_prefix { 0x30, 0x41, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x02, 0x05, 0x00, 0x04, 0x30 };
+        constexpr std::array<uint8_t, 19> sha512_prefix { 0x30, 0x51, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x03, 0x05, 0x00, 0x04, 0x40 };
+
+    }
+
+    /**
+     *  Retrieve the DER encoded DigestInfo prefix for a hash algorithm
+     *
+     *  @param  algorithm   The hash algorithm used
+     *  @return The prefix to place before the digest
+     *  @throws pgp::unsupported_algorithm for unsupported hash algorithms
+     */
+    span<const uint8_t> digest_info_prefix(hash_algorithm algorithm)
+    {
+        // check the given algorithm
+        switch (algorithm) {
+            case hash_algorithm::sha1:      return sha1_prefix;
+            case hash_algorithm::sha224:    return sha224_prefix;
+            case hash_algorithm::sha256:    return sha256_prefix;
+            case hash_algorithm::sha384:    return sha384_prefix;
+            case hash_algorithm::sha512:    return sha512_prefix;
+            default:                        break;
+        }
+
+        // we do not know the encoding for this algorithm
+        throw unsupported_algorithm{ "Unsupported hash algorithm for RSA signatures" };
+    }
+
+    /**
+     *  Encode a digest for an RSA signature, as described
+     *  by EMSA-PKCS1-v1_5: 00 01 FF .. FF 00, followed by the
+     *  DigestInfo prefix and the digest itself
+     *
+     *  @param  algorithm   The hash algorithm used for the digest
+     *  @param  digest      The digest to encode
+     *  @param  length      The size of the encoded message, which is the size of the modulus
+     *  @return The encoded message
+     *  @throws pgp::unsupported_algorithm for unsupported hash algorithms
+     *  @throws std::invalid_argument if the message is too short to hold the digest
+     */
+    std::vector<uint8_t> pkcs1_encode(hash_algorithm algorithm, span<const uint8_t> digest, size_t length)
+    {
+        // find the prefix to encode the digest with
+        auto prefix = digest_info_prefix(algorithm);
+
+        // the message must have room for at least eight bytes of padding
+        if (length < prefix.size() + digest.size() + 11) {
+            // the digest does not fit
+            throw std::invalid_argument{ "RSA modulus too small for the digest" };
+        }
+
+        // fill in the padding, followed by the prefix and the digest
+        std::vector<uint8_t> message(length, 0xff);
+        message[0] = 0x00;
+        message[1] = 0x01;
+        message[length - prefix.size() - digest.size() - 1] = 0x00;
+        std::copy(digest.begin(), digest.end(), std::copy(prefix.begin(), prefix.end(), message.end() - prefix.size() - digest.size()));
+
+        // return the encoded message
+        return message;
+    }
+
+}
@@ -0,0 +1,195 @@
+#include "random_generator.h"
+#include <sodium/crypto_generichash.h>
+#include <sodium/randombytes.h>
+#include <sodium/utils.h>
+#include <unistd.h>
+#include <algorithm>
+#include <stdexcept>
+#include "allocator.h"
+
+
+namespace pgp {
+
+    /**
+     *  Retrieve the generator for the current thread
+     *
+     *  @return The random number generator
+     */
+    random_generator &random_generator::instance()
+    {
+        // every thread gets its own generator, seeded on first use
+        thread_local random_generator generator;
+        return generator;
+    }
+
+    /**
+     *  Constructor
+     */
+    random_generator::random_generator() :
+        _state{ std::allocate_shared<state>(allocator<state>{}) }
+    {
+        // start without output and a key from the operating system
+        _state->available = 0;
+        _state->deterministic = false;
+        randombytes_buf(_state->key.data(), _state->key.size());
+        _state->generated = 0;
+        _state->process = getpid();
+    }
+
+    /**
+     *  Fill a buffer with random data
+     *
+     *  @param  output  The buffer to fill
+     *  @param  size    The number of bytes to generate
+     */
+    void random_generator::GenerateBlock(CryptoPP::byte *output, size_t size)
+    {
+        // were we forked off from the process that seeded the generator?
+        if (_state->process != getpid()) {
+            // the parent has the same state, so we need a new seed
+            reseed();
+        }
+
+        // keep going until the output is filled
+        while (size > 0) {
+            // has the generator produced enough output to get a new seed?
+            if (!_state->deterministic && _state->generated >= reseed_interval) {
+                // mix in fresh data from the operating system
+                reseed();
+            }
+
+            // do we need more data in the buffer?
+            if (_state->available == 0) {
+                // refill the buffer
+                refill();
+            }
+
+            // hand out the data in the order it was generated
+            size_t count = std::min(size, _state->available);
+            auto *data = _state->buffer.data() + _state->buffer.size() - _state->available;
+
+            // copy it to the output and erase it from the buffer
+            std::copy(data, data + count, output);
+            sodium_memzero(data, count);
+
+            // update the administration
+            _state->available -= count;
+            _state->generated += count;
+            output += count;
+            size -= count;
+        }
+    }
+
+    /**
+     *  Mix additional data into the generator state
+     *
+     *  @param  input   The data to mix in
+     *  @param  length  The number of bytes to mix in
+     */
+    void random_generator::IncorporateEntropy(const CryptoPP::byte *input, size_t length)
+    {
+        // derive the new key from the old key and the input
+        crypto_generichash(_state->key.data(), _state->key.size(), input, length, _state->key.data(), _state->key.size());
+
+        // output buffered under the old key is discarded
+        sodium_memzero(_state->buffer.data(), _state->buffer.size());
+        _state->available = 0;
+    }
+
+    /**
+     *  Check whether additional data can be mixed in
+     *
+     *  @return Always true
+     */
+    bool random_generator::CanIncorporateEntropy() const
+    {
+        // we mix in any data we are given
+        return true;
+    }
+
+    /**
+     *  Make the output deterministic, for testing
+     *
+     *  @param  seed    The seed to generate output from
+     *  @throws std::invalid_argument if the seed has the wrong size
+     */
+    void random_generator::seed(span<const uint8_t> seed)
+    {
+        // check whether the seed can be used as a key
+        if (seed.size() != seed_size) {
+            // we cannot use this seed
+            throw std::invalid_argument{ "Random generator seed has the wrong size" };
+        }
+
+        // use the seed as the key, discarding all buffered output
+        std::copy(seed.begin(), seed.end(), _state->key.begin());
+        sodium_memzero(_state->buffer.data(), _state->buffer.size());
+        _state->available = 0;
+        _state->generated = 0;
+        _state->deterministic = true;
+        _state->process = getpid();
+    }
+
+    /**
+     *  Reseed the generator from the operating system,
+     *  this also ends deterministic output
+     */
+    void random_generator::reseed() noexcept
+    {
+        // retrieve fresh data from the operating system
+        std::array<uint8_t, seed_size> fresh;
+        randombytes_buf(fresh.data(), fresh.size());
+
+        // a fixed seed is replaced, otherwise the fresh data is mixed in
+        if (_state->deterministic) {
+            // start over from the fresh data
+            std::copy(fresh.begin(), fresh.end(), _state->key.begin());
+            sodium_memzero(_state->buffer.data(), _state->buffer.size());
+            _state->available = 0;
+        } else {
+            // mix the data into the current key
+            IncorporateEntropy(fresh.data(), fresh.size());
+        }
+
+        // the data should not linger on the stack
+        sodium_memzero(fresh.data(), fresh.size());
+
+        // we start counting again, in the current process
+        _state->generated = 0;
+        _state->deterministic = false;
+        _state->process = getpid();
+    }
+
+    /**
+     *  Check whether the output is deterministic
+     *
+     *  @return Whether a fixed seed is in use
+     */
+    bool random_generator::deterministic() const noexcept
+    {
+        // return the stored flag
+        return _state->deterministic;
+    }
+
+    /**
+     *  Refill the output buffer, replacing the key
+     */
+    void random_generator::refill() noexcept
+    {
+        // every key is used only once, so the nonce is fixed
+        constexpr const std::array<uint8_t, crypto_stream_chacha20_ietf_NONCEBYTES> nonce{};
+
+        // the keystream provides the next key followed by the output
+        std::array<uint8_t, seed_size + std::tuple_size_v<decltype(state::buffer)>> stream;
+        crypto_stream_chacha20_ietf(stream.data(), stream.size(), nonce.data(), _state->key.data());
+
+        // split up the keystream
+        std::copy(stream.begin(), stream.begin() + seed_size, _state->key.begin());
+        std::copy(stream.begin() + seed_size, stream.end(), _state->buffer.begin());
+        _state->available = _state->buffer.size();
+
+        // the data should not linger on the stack
+        sodium_memzero(stream.data(), stream.size());
+    }
+
+}
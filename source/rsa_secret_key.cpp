@@ -1,4 +1,5 @@
 #include "rsa_secret_key.h"
+#include <cryptopp/integer.h>
 #include <utility>
 
 
@@ -12,12 +13,15 @@ namespace pgp {
      *  @param  q   The secret prime value q
      *  @param  u   The multiplicative inverse p mod q
      */
-    rsa_secret_key::rsa_secret_key(multiprecision_integer d, multiprecision_integer p, multiprecision_integer q, multiprecision_integer u) noexcept :
+    rsa_secret_key::rsa_secret_key(secret_multiprecision_integer d, secret_multiprecision_integer p, secret_multiprecision_integer q, secret_multiprecision_integer u) noexcept :
         _d{ std::move(d) },
         _p{ std::move(p) },
         _q{ std::move(q) },
         _u{ std::move(u) }
-    {}
+    {
+        // derive the exponents for signing
+        derive_exponents();
+    }
 
     /**
      *  Comparison operators
@@ -54,7 +58,7 @@ namespace pgp {
      *
      *  @return The secret exponent
      */
-    const multiprecision_integer &rsa_secret_key::d() const noexcept
+    const secret_multiprecision_integer &rsa_secret_key::d() const noexcept
     {
         // return the storet exponent
         return _d;
@@ -65,7 +69,7 @@ namespace pgp {
      *
      *  @return The secret prime value p
      */
-    const multiprecision_integer &rsa_secret_key::p() const noexcept
+    const secret_multiprecision_integer &rsa_secret_key::p() const noexcept
     {
         // return the stored prime
         return _p;
@@ -76,7 +80,7 @@ namespace pgp {
      *
      *  @return The secret prime value q
      */
-    const multiprecision_integer &rsa_secret_key::q() const noexcept
+    const secret_multiprecision_integer &rsa_secret_key::q() const noexcept
     {
         // return the stored prime
         return _q;
@@ -87,10 +91,58 @@ namespace pgp {
      *
      *  @return The multiplicative inverse of p mod q
      */
-    const multiprecision_integer &rsa_secret_key::u() const noexcept
+    const secret_multiprecision_integer &rsa_secret_key::u() const noexcept
     {
         // return the stored multiplicative
         return _u;
     }
 
+    /**
+     *  Retrieve the exponent d mod (p - 1), which is
+     *  derived from the key to sign using the CRT
+     *
+     *  @return The derived exponent, empty when p, q and u are inconsistent
+     */
+    const secret_multiprecision_integer &rsa_secret_key::dp() const noexcept
+    {
+        // return the derived exponent
+        return _dp;
+    }
+
+    /**
+     *  Retrieve the exponent d mod (q - 1), which is
+     *  derived from the key to sign using the CRT
+     *
+     *  @return The derived exponent, empty when p, q and u are inconsistent
+     */
+    const secret_multiprecision_integer &rsa_secret_key::dq() const noexcept
+    {
+        // return the derived exponent
+        return _dq;
+    }
+
+    /**
+     *  Derive the exponents for the chinese remainder
+     *  theorem, when the primes allow it
+     */
+    void rsa_secret_key::derive_exponents() noexcept
+    {
+        // the values we derive from
+        auto d = static_cast<CryptoPP::Integer>(_d);
+        auto p = static_cast<CryptoPP::Integer>(_p);
+        auto q = static_cast<CryptoPP::Integer>(_q);
+        auto u = static_cast<CryptoPP::Integer>(_u);
+
+        // the primes must be usable, and u must be the inverse of p
+        // mod q, otherwise we cannot combine the results later on
+        if (p <= CryptoPP::Integer::One() || q <= CryptoPP::Integer::One() || (p * u) % q != CryptoPP::Integer::One()) {
+            // the key can only be used without the CRT
+            return;
+        }
+
+        // reduce the exponent for both primes
+        _dp = secret_multiprecision_integer{ d % (p - CryptoPP::Integer::One()) };
+        _dq = secret_multiprecision_integer{ d % (q - CryptoPP::Integer::One()) };
+    }
+
 }
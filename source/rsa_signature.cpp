@@ -54,4 +54,22 @@ namespace pgp {
         return _s;
     }
 
+    /**
+     *  Verify the signature over a digest
+     *
+     *  The signature is checked against the PKCS #1 v1.5
+     *  encoding of the digest.
+     *
+     *  @param  key         The public key of the signer
+     *  @param  algorithm   The hash algorithm used for the digest
+     *  @param  digest      The digest that was signed
+     *  @return Whether the signature is valid
+     *  @throws std::runtime_error for unsupported hash algorithms
+     */
+    bool rsa_signature::verify(const rsa_public_key &key, hash_algorithm algorithm, span<const uint8_t> digest) const
+    {
+        // verify with a verifier for just this signature
+        return verifier_t{ key }.verify(*this, algorithm, digest);
+    }
+
 }
@@ -0,0 +1,67 @@
+#include "rsa_signature_signer.h"
+#include <cryptopp/integer.h>
+#include "allocator.h"
+#include "hash_algorithm.h"
+#include "pkcs1_encoding.h"
+#include "random_generator.h"
+
+
+namespace pgp {
+
+    /**
+     *  Constructor
+     *
+     *  @param  key     The secret key to sign with
+     */
+    rsa_signature_signer::rsa_signature_signer(const basic_secret_key<rsa_public_key, rsa_secret_key> &key)
+    {
+        // the public values of the key
+        auto n = static_cast<CryptoPP::Integer>(key.n());
+        auto e = static_cast<CryptoPP::Integer>(key.e());
+        auto d = static_cast<CryptoPP::Integer>(key.d());
+
+        // create the key object in secure memory, instead of copying it there from the stack
+        auto prepared = std::allocate_shared<CryptoPP::RSA::PrivateKey>(allocator<CryptoPP::RSA::PrivateKey>{});
+
+        // can we sign using the chinese remainder theorem?
+        if (!key.dp().data().empty() && static_cast<CryptoPP::Integer>(key.p()) * static_cast<CryptoPP::Integer>(key.q()) == n) {
+            // Crypto++ expects the inverse of its second prime mod the first
+            // one, while OpenPGP stores the inverse of p mod q, so the primes
+            // and the exponents derived from them are passed the other way around
+            prepared->Initialize(
+                n, e, d,
+                static_cast<CryptoPP::Integer>(key.q()),
+                static_cast<CryptoPP::Integer>(key.p()),
+                static_cast<CryptoPP::Integer>(key.dq()),
+                static_cast<CryptoPP::Integer>(key.dp()),
+                static_cast<CryptoPP::Integer>(key.u())
+            );
+        } else {
+            // sign with the full exponent instead
+            prepared->Initialize(n, e, d);
+        }
+
+        // the key is no longer modified
+        _key = std::move(prepared);
+    }
+
+    /**
+     *  Sign a SHA-256 digest
+     *
+     *  @param  digest  The digest to sign
+     *  @return The RSA s parameter of the signature
+     *  @throws std::invalid_argument if the key is too small for the digest
+     */
+    multiprecision_integer rsa_signature_signer::sign(span<const uint8_t> digest) const
+    {
+        // encode the digest into a message as long as the modulus
+        auto message = pkcs1_encode(hash_algorithm::sha256, digest, _key->GetModulus().ByteCount());
+
+        // apply the private key operation, which blinds the message
+        auto s = _key->CalculateInverse(random_generator::instance(), CryptoPP::Integer{ message.data(), message.size() });
+
+        // return the signature parameter
+        return multiprecision_integer{ s };
+    }
+
+}
@@ -0,0 +1,61 @@
+#include "rsa_signature_verifier.h"
+#include <vector>
+#include "pkcs1_encoding.h"
+#include "rsa_signature.h"
+
+
+namespace pgp {
+
+    /**
+     *  Constructor
+     *
+     *  @param  key     The public key of the signer
+     */
+    rsa_signature_verifier::rsa_signature_verifier(const rsa_public_key &key)
+    {
+        // parse the modulus and the exponent
+        _key.Initialize(
+            static_cast<CryptoPP::Integer>(key.n()),
+            static_cast<CryptoPP::Integer>(key.e())
+        );
+
+        // the encoded message is as long as the modulus
+        _length = _key.GetModulus().ByteCount();
+    }
+
+    /**
+     *  Verify a signature over a digest
+     *
+     *  The signature is checked against the PKCS #1 v1.5
+     *  encoding of the digest.
+     *
+     *  @param  signature   The signature to verify
+     *  @param  algorithm   The hash algorithm used for the digest
+     *  @param  digest      The digest that was signed
+     *  @return Whether the signature is valid
+     *  @throws pgp::unsupported_algorithm for unsupported hash algorithms
+     */
+    bool rsa_signature_verifier::verify(const rsa_signature &signature, hash_algorithm algorithm, span<const uint8_t> digest) const
+    {
+        // find the prefix to encode the digest with
+        auto prefix = digest_info_prefix(algorithm);
+
+        // retrieve the signature value
+        auto s = static_cast<CryptoPP::Integer>(signature.s());
+
+        // the signature must be smaller than the modulus, and the
+        // modulus large enough for at least eight bytes of padding
+        if (s >= _key.GetModulus() || _length < prefix.size() + digest.size() + 11) {
+            // this cannot be a valid signature
+            return false;
+        }
+
+        // recover the encoded message from the signature
+        std::vector<uint8_t> recovered(_length);
+        _key.ApplyFunction(s).Encode(recovered.data(), recovered.size());
+
+        // the signature is valid if it recovers to the encoded digest
+        return recovered == pkcs1_encode(algorithm, digest, _length);
+    }
+
+}
@@ -0,0 +1,411 @@
+#include "secure_arena.h"
+#include <sodium/utils.h>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <sys/mman.h>
+#include <sys/resource.h>
+
+
+namespace pgp {
+
+    namespace {
+
+        /**
+         *  Determine the limit on locked memory for the process
+         *
+         *  @return The number of bytes the process may lock
+         */
+        size_t memory_lock_limit() noexcept
+        {
+            // retrieve the limit, which may be unrestricted
+            rlimit limit{};
+            if (getrlimit(RLIMIT_MEMLOCK, &limit) != 0 || limit.rlim_cur == RLIM_INFINITY) {
+                // without a known limit we use all we can get
+                return std::numeric_limits<size_t>::max();
+            }
+
+            // use the current limit
+            return static_cast<size_t>(limit.rlim_cur);
+        }
+
+    }
+
+    /**
+     *  Constructor
+     *
+     *  The budget defaults to half the limit on locked memory
+     *  set for the process, leaving the rest for secure objects
+     *  that lock their own memory and for other libraries.
+     */
+    secure_arena::secure_arena() :
+        secure_arena{ memory_lock_limit() / 2 }
+    {}
+
+    /**
+     *  Constructor
+     *
+     *  @param  budget  The maximum number of bytes to lock
+     */
+    secure_arena::secure_arena(size_t budget) noexcept :
+        _budget{ budget }
+    {}
+
+    /**
+     *  Destructor
+     *
+     *  All memory is wiped and unlocked, so no chunks may
+     *  be in use any longer.
+     */
+    secure_arena::~secure_arena()
+    {
+        // release all the regions
+        for (auto &region : _regions) {
+            // wipe and unlock the region before unmapping
+            sodium_munlock(region.start, region_size);
+            ::munmap(region.start, region_size);
+        }
+    }
+
+    /**
+     *  Retrieve the arena used for secure allocations
+     *
+     *  @return The arena shared by the whole process
+     */
+    secure_arena &secure_arena::instance()
+    {
+        // the arena is never destroyed, since secure objects with
+        // static storage may be released after it otherwise, the
+        // memory is reclaimed by the system when the process ends
+        static auto *arena = new secure_arena{};
+        return *arena;
+    }
+
+    /**
+     *  Allocate a wiped chunk of memory
+     *
+     *  @param  size    The number of bytes to allocate
+     *  @return The allocated memory, or nullptr when it
+     *          cannot be served by the arena
+     */
+    void *secure_arena::allocate(size_t size) noexcept
+    {
+        // large allocations are not served by the arena
+        if (size > max_chunk_size) {
+            // let the caller allocate elsewhere
+            return nullptr;
+        }
+
+        // find the chunks of the right size
+        auto index = class_index(size);
+        auto &chunks = _classes[index];
+
+        // prevent concurrent modification
+        std::lock_guard<std::mutex> guard{ _lock };
+
+        // if no chunks are available, try to wipe released ones
+        if (chunks.available.empty()) {
+            // this makes them available again
+            wipe(chunks, alignment << index);
+        }
+
+        // do we have a chunk available?
+        if (!chunks.available.empty()) {
+            // take the last released chunk
+            auto *result = chunks.available.back();
+            chunks.available.pop_back();
+
+            // the region it is part of is in use again
+            ++find(result)->used;
+            return result;
+        }
+
+        // we need a new chunk from a region
+        return carve(index);
+    }
+
+    /**
+     *  Release a chunk of memory
+     *
+     *  @param  address The address of the chunk
+     *  @param  size    The number of bytes that were allocated
+     *  @return Whether the chunk was allocated by this arena
+     */
+    bool secure_arena::deallocate(void *address, size_t size) noexcept
+    {
+        // large allocations are never served by the arena
+        if (address == nullptr || size > max_chunk_size) {
+            // so it cannot be ours
+            return false;
+        }
+
+        // prevent concurrent modification
+        std::lock_guard<std::mutex> guard{ _lock };
+
+        // the chunk may have been allocated elsewhere
+        // when the arena was already over budget
+        auto *owner = find(address);
+        if (owner == nullptr) {
+            // so we cannot take it back
+            return false;
+        }
+
+        // find the chunks of the right size
+        auto index = class_index(size);
+        auto &chunks = _classes[index];
+
+        // the chunk must be wiped before it is used again, we do
+        // so in batches; space for it was reserved when carving
+        chunks.released.push_back(address);
+
+        // do we have a full batch?
+        if (chunks.released.size() >= wipe_batch) {
+            // wipe all of them in one go
+            wipe(chunks, alignment << index);
+        }
+
+        // is the region no longer used, and not the one we carve from?
+        if (--owner->used == 0 && owner->start != _current) {
+            // then give it back to the system
+            release(*owner);
+        }
+
+        // the chunk was ours
+        return true;
+    }
+
+    /**
+     *  Wipe all released chunks now, instead of waiting
+     *  for enough of them to fill a batch
+     */
+    void secure_arena::wipe() noexcept
+    {
+        // prevent concurrent modification
+        std::lock_guard<std::mutex> guard{ _lock };
+
+        // process all the size classes
+        for (size_t index = 0; index < class_count; ++index) {
+            // and wipe the released chunks
+            wipe(_classes[index], alignment << index);
+        }
+    }
+
+    /**
+     *  Retrieve the maximum number of bytes to lock
+     *  @return The budget of locked memory
+     */
+    size_t secure_arena::budget() const noexcept
+    {
+        // the budget never changes
+        return _budget;
+    }
+
+    /**
+     *  Retrieve the number of bytes currently locked
+     *  @return The size of all regions
+     */
+    size_t secure_arena::locked() const noexcept
+    {
+        // prevent concurrent modification
+        std::lock_guard<std::mutex> guard{ _lock };
+
+        // all regions have the same size
+        return _regions.size() * region_size;
+    }
+
+    /**
+     *  Determine the size class to use for an allocation
+     *
+     *  @param  size    The number of bytes to allocate
+     *  @return The index of the size class
+     */
+    size_t secure_arena::class_index(size_t size) noexcept
+    {
+        // find the smallest chunk size that fits
+        size_t index = 0;
+        while ((alignment << index) < size) {
+            // try the next, twice as large, chunk size
+            ++index;
+        }
+
+        // return the found index
+        return index;
+    }
+
+    /**
+     *  Wipe the released chunks in a size class, so
+     *  they become available again
+     *
+     *  @param  chunks  The size class to wipe
+     *  @param  size    The size of the chunks
+     */
+    void secure_arena::wipe(size_class &chunks, size_t size) noexcept
+    {
+        // process all the released chunks
+        for (auto *chunk : chunks.released) {
+            // erase the previous contents
+            sodium_memzero(chunk, size);
+        }
+
+        // the space for this was reserved when the chunks were carved
+        chunks.available.insert(chunks.available.end(), chunks.released.begin(), chunks.released.end());
+        chunks.released.clear();
+    }
+
+    /**
+     *  Carve a new chunk from the current region,
+     *  locking a new region if necessary
+     *
+     *  @param  index   The size class to carve a chunk for
+     *  @return The new chunk, or nullptr when over budget
+     */
+    void *secure_arena::carve(size_t index) noexcept
+    {
+        // the chunks of the requested size
+        auto &chunks = _classes[index];
+        auto size = alignment << index;
+
+        // the chunk may be released at any time, which
+        // may not fail, so we reserve the space up front
+        try {
+            // do we need to grow the administration?
+            if (chunks.available.capacity() <= chunks.carved) {
+                // grow both lists in steps, like a vector would
+                auto capacity = std::max<size_t>(wipe_batch, chunks.carved * 2);
+                chunks.available.reserve(capacity);
+                chunks.released.reserve(capacity);
+            }
+        } catch (const std::bad_alloc&) {
+            // we are out of memory
+            return nullptr;
+        }
+
+        // does the chunk still fit in the current region?
+        if (_current == nullptr || _carved + size > region_size) {
+            // we stop carving from the current region, so when none
+            // of its chunks are in use it is given back right away
+            auto *previous = _current == nullptr ? nullptr : find(_current);
+            if (previous != nullptr && previous->used == 0) {
+                // which also leaves room in the budget for a new one
+                release(*previous);
+                _current = nullptr;
+            }
+
+            // we need a new region, which must fit the budget
+            if ((_regions.size() + 1) * region_size > _budget) {
+                // we cannot lock more memory
+                return nullptr;
+            }
+
+            // map the memory for the new region
+            auto *region = ::mmap(nullptr, region_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+            // check whether we got the memory
+            if (region == MAP_FAILED) {
+                // we are out of memory
+                return nullptr;
+            }
+
+            // lock the region, so it is never paged out
+            if (sodium_mlock(region, region_size) != 0) {
+                // the system limit was reached, give the memory back
+                ::munmap(region, region_size);
+                return nullptr;
+            }
+
+            // keep the regions sorted, so we can find them back
+            try {
+                // add the region in the right place
+                auto *start = static_cast<uint8_t*>(region);
+                _regions.insert(std::upper_bound(_regions.begin(), _regions.end(), start, [](const uint8_t *address, const struct region &other) {
+                    // compare the start addresses
+                    return std::less<const uint8_t*>{}(address, other.start);
+                }), { start, 0 });
+            } catch (const std::bad_alloc&) {
+                // give the region back
+                sodium_munlock(region, region_size);
+                ::munmap(region, region_size);
+                return nullptr;
+            }
+
+            // start carving from the new region
+            _current = static_cast<uint8_t*>(region);
+            _carved = 0;
+        }
+
+        // take the chunk from the region, this memory
+        // was never used before, so it is still zero
+        auto *result = _current + _carved;
+        _carved += size;
+        ++chunks.carved;
+
+        // the region now has another chunk in use
+        ++find(result)->used;
+        return result;
+    }
+
+    /**
+     *  Find the region an address is part of
+     *
+     *  @param  address The address to find
+     *  @return The region holding the address, or nullptr
+     *          if the address does not belong to the arena
+     */
+    secure_arena::region *secure_arena::find(const void *address) noexcept
+    {
+        // find the first region starting beyond the address
+        auto *chunk = static_cast<const uint8_t*>(address);
+        auto iter = std::upper_bound(_regions.begin(), _regions.end(), chunk, [](const uint8_t *address, const region &other) {
+            // compare the start addresses
+            return std::less<const uint8_t*>{}(address, other.start);
+        });
+
+        // the address must be in the region before it
+        if (iter == _regions.begin()) {
+            // the address comes before all regions
+            return nullptr;
+        }
+
+        // check whether it lies within the region
+        --iter;
+        return std::less<const uint8_t*>{}(chunk, iter->start + region_size) ? &*iter : nullptr;
+    }
+
+    /**
+     *  Give a region that is no longer in use back to the system
+     *
+     *  @param  unused  The region to release
+     */
+    void secure_arena::release(region &unused) noexcept
+    {
+        // the start of the region, which is removed below
+        auto *start = unused.start;
+
+        // check whether a chunk lies within the region
+        auto inside = [start](const void *chunk) {
+            // compare against both ends of the region
+            auto *address = static_cast<const uint8_t*>(chunk);
+            return !std::less<const uint8_t*>{}(address, start) && std::less<const uint8_t*>{}(address, start + region_size);
+        };
+
+        // remove the chunks of the region from all size classes
+        for (auto &chunks : _classes) {
+            // erase both the wiped and the released chunks
+            auto available = std::remove_if(chunks.available.begin(), chunks.available.end(), inside);
+            auto released = std::remove_if(chunks.released.begin(), chunks.released.end(), inside);
+
+            // these chunks no longer exist
+            chunks.carved -= static_cast<size_t>(chunks.available.end() - available) + static_cast<size_t>(chunks.released.end() - released);
+            chunks.available.erase(available, chunks.available.end());
+            chunks.released.erase(released, chunks.released.end());
+        }
+
+        // forget about the region
+        _regions.erase(_regions.begin() + (&unused - _regions.data()));
+
+        // wipe and unlock the region before unmapping
+        sodium_munlock(start, region_size);
+        ::munmap(start, region_size);
+    }
+
+}
@@ -1,5 +1,6 @@
 #include "signature.h"
 #include "util/narrow_cast.h"
+#include <stdexcept>
 
 
 namespace pgp {
@@ -19,16 +20,56 @@ namespace pgp {
         _hashed_subpackets{ std::move(hashed_subpackets) },
         _unhashed_subpackets{ std::move(unhashed_subpackets) }
     {
-        visit([&bound_key, &user, this](auto &&key_instance) {
-            // obtain the appropriate types
+        // sign the certification without a prepared key
+        sign_certification(nullptr, bound_key, user);
+    }
+
+    /**
+     *  Constructor
+     *
+     *  @param  context                 The signing context, created for the bound key
+     *  @param  user                    The user id we are binding in the signature
+     *  @param  hashed_subpackets       The subpackets that will be used for generating the hash
+     *  @param  unhashed_subpackets     The subpackets that will not be hashed
+     *  @throws std::invalid_argument if the context was created for a subkey
+     */
+    signature::signature(const signing_context &context, const user_id &user, signature_subpacket_set hashed_subpackets, signature_subpacket_set unhashed_subpackets) :
+        _type{ signature_type::positive_user_id_and_public_key_certification },
+        _key_algorithm{ context.algorithm() },
+        _hash_algorithm{ hash_algorithm::sha256 },
+        _hashed_subpackets{ std::move(hashed_subpackets) },
+        _unhashed_subpackets{ std::move(unhashed_subpackets) }
+    {
+        // user ids are certified by the primary key, was
+        // the context created for a subkey instead?
+        if (!holds_alternative<secret_key>(context.key())) {
+            // subkeys cannot certify user ids
+            throw std::invalid_argument{ "Signing context was created for a subkey, which cannot certify user ids" };
+        }
+
+        // sign the certification with the prepared key
+        sign_certification(&context, get<secret_key>(context.key()), user);
+    }
+
+    /**
+     *  Sign the certification of a user id
+     *
+     *  @param  context     The signing context created for the key, if any
+     *  @param  key         The key we are binding in the signature
+     *  @param  user        The user id we are binding in the signature
+     *  @throws std::runtime_error for unsupported key types
+     */
+    void signature::sign_certification(const signing_context *context, const secret_key &key, const user_id &user)
+    {
+        visit([context, &key, &user, this](auto &&key_instance) {
+            // obtain the appropriate signature type
             using signature_t = typename std::decay_t<decltype(key_instance)>::signature_t;
-            using encoder_t = typename signature_t::encoder_t;
 
             // construct the appropriate signature encoder
-            encoder_t encoder{bound_key};
+            auto encoder = make_encoder<signature_t>(context, key);
 
             // hash the key
-            bound_key.hash(encoder);
+            hash_key(context, key, encoder);
 
             // hash the user id
             encoder.template push<uint8_t>(0xB4);
@@ -46,7 +87,7 @@ namespace pgp {
             // out to be surprisingly hard; so hard that an extra move seems
             // worth the increased code clarity.
             _signature.emplace<signature_t>(util::make_from_tuple<signature_t>(encoder.finalize()));
-        }, bound_key.key());
+        }, key.key());
     }
 
     /**
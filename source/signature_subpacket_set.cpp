@@ -2,6 +2,7 @@
 #include "variable_number.h"
 #include "fixed_number.h"
 #include "signature.h"
+#include <iterator>
 #include <numeric>
 
 
@@ -13,7 +14,8 @@ namespace pgp {
      *  @param  subpackets  The subpackets to keep in the set
      */
     signature_subpacket_set::signature_subpacket_set(std::vector<subpacket_variant> subpackets) noexcept :
-        _subpackets{ std::move(subpackets) }
+        _subpackets( std::make_move_iterator(subpackets.begin()), std::make_move_iterator(subpackets.end()) ),
+        _size{ determine_size() }
     {}
 
     /**
@@ -41,6 +43,16 @@ namespace pgp {
      *  @return The number of bytes used for encoded storage
      */
     size_t signature_subpacket_set::size() const noexcept
+    {
+        // the size was determined when the set was created
+        return _size;
+    }
+
+    /**
+     *  Determine the size used in encoded format
+     *  @return The number of bytes used for encoded storage
+     */
+    size_t signature_subpacket_set::determine_size() const noexcept
     {
         // allocate size for the header and add size for all the packets
         return std::accumulate(_subpackets.begin(), _subpackets.end(), uint16::size(), [](uint16_t a, const subpacket_variant &b) {
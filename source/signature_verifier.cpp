@@ -0,0 +1,43 @@
+#include "signature_verifier.h"
+#include <type_traits>
+#include "unsupported_algorithm.h"
+
+
+namespace pgp {
+
+    /**
+     *  Verify the signature over a digest
+     *
+     *  @param  sig         The signature to verify
+     *  @param  digest      The digest of the signed data
+     *  @return Whether the signature is valid
+     *  @throws pgp::unsupported_algorithm for unsupported algorithms
+     */
+    bool signature_verifier::verify_digest(const signature &sig, span<const uint8_t> digest) const
+    {
+        // verify with the verifier for the key
+        return visit([&sig, &digest](auto &&verifier) -> bool {
+            // determine the verifier type
+            using verifier_t = std::decay_t<decltype(verifier)>;
+
+            // do we support the key algorithm?
+            if constexpr (std::is_same_v<verifier_t, monostate>) {
+                // we cannot verify this signature
+                throw unsupported_algorithm{ "Unsupported key algorithm for verifying signatures" };
+            } else {
+                // the signature type verified by the verifier
+                using signature_t = typename verifier_t::signature_t;
+
+                // the signature must be of the same type
+                if (!holds_alternative<signature_t>(sig.data())) {
+                    // signature does not match the key
+                    return false;
+                }
+
+                // verify the digest
+                return verifier.verify(get<signature_t>(sig.data()), sig.hashing_algorithm(), digest);
+            }
+        }, _verifier);
+    }
+
+}
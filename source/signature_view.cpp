@@ -0,0 +1,177 @@
+#include "signature_view.h"
+#include "decoder.h"
+#include "expected_number.h"
+
+
+namespace pgp {
+
+    /**
+     *  Constructor
+     *
+     *  @param  data    The encoded signature data to refer to
+     *  @throws std::out_of_range, std::range_error
+     */
+    signature_view::signature_view(span<const uint8_t> data) :
+        _data{ data }
+    {
+        // the decoder to parse the fields from
+        decoder parser{ data };
+
+        // check the version and read the base fields
+        expected_number<uint8_t, 4>{ parser };
+        _type           = signature_type{ parser.extract_number<uint8_t>() };
+        _key_algorithm  = key_algorithm{ parser.extract_number<uint8_t>() };
+        _hash_algorithm = hash_algorithm{ parser.extract_number<uint8_t>() };
+
+        // read both subpacket sets, which are prefixed by their size
+        _hashed_subpackets      = parser.extract_blob<uint8_t>(parser.extract_number<uint16_t>());
+        _hashed_data            = data.first(data.size() - parser.size());
+        _unhashed_subpackets    = parser.extract_blob<uint8_t>(parser.extract_number<uint16_t>());
+        _hash_prefix            = parser.extract_number<uint16_t>();
+
+        // the number of integers depends on the algorithm
+        switch (_key_algorithm) {
+            case key_algorithm::rsa_encrypt_or_sign:
+            case key_algorithm::rsa_sign_only:
+                // the signature value s
+                _integer_count = 1;
+                break;
+            case key_algorithm::dsa:
+            case key_algorithm::eddsa:
+            case key_algorithm::ecdsa:
+                // the values r and s
+                _integer_count = 2;
+                break;
+            default:
+                // we do not know the signature format
+                break;
+        }
+
+        // read all the integers
+        for (size_t i = 0; i < _integer_count; ++i) {
+            // read the next integer
+            _integers[i] = mpi_view{ parser };
+        }
+    }
+
+    /**
+     *  Comparison operators
+     *
+     *  @param  other   The object to compare with
+     */
+    bool signature_view::operator==(const signature_view &other) const noexcept
+    {
+        return _data == other._data;
+    }
+
+    /**
+     *  Comparison operators
+     *
+     *  @param  other   The object to compare with
+     */
+    bool signature_view::operator!=(const signature_view &other) const noexcept
+    {
+        return !operator==(other);
+    }
+
+    /**
+     *  Determine the size used in encoded format
+     *  @return The number of bytes used for encoded storage
+     */
+    size_t signature_view::size() const noexcept
+    {
+        // this is the size of the referenced data
+        return _data.size();
+    }
+
+    /**
+     *  Get the signature type
+     *  @return The type of signature
+     */
+    signature_type signature_view::type() const noexcept
+    {
+        // return the signature type
+        return _type;
+    }
+
+    /**
+     *  Get the used key algorithm
+     *
+     *  @return The public key algorithm
+     */
+    key_algorithm signature_view::public_key_algorithm() const noexcept
+    {
+        // return the key algorithm
+        return _key_algorithm;
+    }
+
+    /**
+     *  Get the used hashing algorithm
+     *
+     *  @return The hashing algorithm
+     */
+    hash_algorithm signature_view::hashing_algorithm() const noexcept
+    {
+        // return the hashing algorithm
+        return _hash_algorithm;
+    }
+
+    /**
+     *  Retrieve the encoded hashed subpackets
+     *
+     *  @return The hashed subpacket data
+     */
+    span<const uint8_t> signature_view::hashed_subpackets() const noexcept
+    {
+        // return the referenced subpackets
+        return _hashed_subpackets;
+    }
+
+    /**
+     *  Retrieve the encoded unhashed subpackets
+     *
+     *  @return The unhashed subpacket data
+     */
+    span<const uint8_t> signature_view::unhashed_subpackets() const noexcept
+    {
+        // return the referenced subpackets
+        return _unhashed_subpackets;
+    }
+
+    /**
+     *  Retrieve the 16 most significant bits from the signed hash
+     *
+     *  @return Two bytes of hash data
+     */
+    uint16_t signature_view::hash_prefix() const noexcept
+    {
+        // return the hash prefix
+        return _hash_prefix;
+    }
+
+    /**
+     *  Retrieve the integers making up the signature,
+     *  e.g. s for RSA or r and s for (EC)DSA and EdDSA
+     *
+     *  @return The signature integers
+     */
+    span<const mpi_view> signature_view::integers() const noexcept
+    {
+        // return only the integers that are in use
+        return span<const mpi_view>{ _integers.data(), _integer_count };
+    }
+
+    /**
+     *  Convert to an owning signature, copying the data
+     *
+     *  @return The signature holding a copy of the data
+     *  @throws std::out_of_range, std::range_error
+     */
+    signature_view::operator signature() const
+    {
+        // decode the signature from the referenced data
+        decoder parser{ _data };
+        return signature{ parser };
+    }
+
+}
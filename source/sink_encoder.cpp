@@ -0,0 +1,238 @@
+#include "sink_encoder.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <unistd.h>
+
+
+namespace pgp {
+
+    namespace {
+
+        /**
+         *  Create a sink writing to a file descriptor
+         *
+         *  @param  fd      The file descriptor to write to
+         *  @return The sink writing to the descriptor
+         */
+        sink_encoder::sink_t fd_sink(int fd)
+        {
+            return [fd](span<const uint8_t> data) {
+                // keep going until all data is written
+                while (!data.empty()) {
+                    // write as much as the descriptor accepts
+                    auto result = ::write(fd, data.data(), data.size());
+
+                    // did we write successfully?
+                    if (result >= 0) {
+                        // skip over the written data
+                        data = data.subspan(result);
+                        continue;
+                    }
+
+                    // interrupted calls should simply be retried
+                    if (errno != EINTR) {
+                        // this is a genuine write error
+                        throw std::system_error{ errno, std::generic_category(), "Failed to write packet data" };
+                    }
+                }
+            };
+        }
+
+        /**
+         *  Create a sink writing to an output stream
+         *
+         *  @param  stream  The stream to write to
+         *  @return The sink writing to the stream
+         */
+        sink_encoder::sink_t stream_sink(std::ostream &stream)
+        {
+            return [&stream](span<const uint8_t> data) {
+                // write all data to the stream
+                stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+                // did the stream accept the data?
+                if (!stream) {
+                    // the stream is in an unrecoverable state
+                    throw std::system_error{ std::make_error_code(std::io_errc::stream), "Failed to write packet data" };
+                }
+            };
+        }
+
+    }
+
+    /**
+     *  Constructor
+     *
+     *  @param  sink            The sink to write data to
+     *  @param  buffer_size     The size of the write buffer
+     */
+    sink_encoder::sink_encoder(sink_t sink, size_t buffer_size) :
+        _sink{ std::move(sink) }
+    {
+        // allocate the write buffer, it cannot be empty
+        _buffer.resize(std::max(buffer_size, size_t{ 1 }));
+    }
+
+    /**
+     *  Constructor
+     *
+     *  @param  fd              The file descriptor to write data to
+     *  @param  buffer_size     The size of the write buffer
+     */
+    sink_encoder::sink_encoder(int fd, size_t buffer_size) :
+        sink_encoder{ fd_sink(fd), buffer_size }
+    {}
+
+    /**
+     *  Constructor
+     *
+     *  @param  stream          The stream to write data to
+     *  @param  buffer_size     The size of the write buffer
+     */
+    sink_encoder::sink_encoder(std::ostream &stream, size_t buffer_size) :
+        sink_encoder{ stream_sink(stream), buffer_size }
+    {}
+
+    /**
+     *  Destructor
+     *
+     *  This writes out any buffered data, but errors cannot
+     *  be reported here, call flush() to be informed of them.
+     */
+    sink_encoder::~sink_encoder()
+    {
+        // write out whatever is still buffered
+        try {
+            // this may fail if the sink is broken
+            flush();
+        } catch (...) {
+            // there is nobody to report the error to
+        }
+    }
+
+    /**
+     *  Flush the encoder, so any partial-written bytes and
+     *  all buffered data are written out to the sink. Note
+     *  that after this operation, bitwise operations start
+     *  at the beginning again.
+     *
+     *  @throws Forwards exceptions from the sink
+     */
+    void sink_encoder::flush()
+    {
+        // do we have any partially-filled bytes?
+        if (_skip_bits > 0) {
+            // write out the current byte
+            auto current = _current;
+            _current = 0;
+            _skip_bits = 0;
+            write(span<const uint8_t>{ &current, 1 });
+        }
+
+        // and write out the buffer
+        drain();
+    }
+
+    /**
+     *  Retrieve the number of encoded bytes
+     *  @return The number of bytes written and buffered
+     */
+    size_t sink_encoder::size() const noexcept
+    {
+        // count both the written and the buffered data
+        return _written + _buffered;
+    }
+
+    /**
+     *  Insert one or more bits
+     *
+     *  @param  count   The number of bits to insert
+     *  @param  value   The value to store in the bits
+     *  @return self, for chaining
+     *  @throws std::out_of_range, std::range_error
+     */
+    sink_encoder &sink_encoder::insert_bits(size_t count, uint8_t value)
+    {
+        // check whether the number fits within the given bit-size
+        if (value > (1U << count) - 1U) {
+            // the value is too large to encode
+            throw std::range_error{ "Cannot encode value, too large for given bit-size" };
+        }
+
+        // the write may not cross a byte boundary
+        if (count + _skip_bits > 8) {
+            // cannot encode the value, does not fit within byte
+            throw std::out_of_range{ "Cannot encode value, bit-wise operation may not cross byte boundaries" };
+        }
+
+        // shift the data so it fits with the existing data and add it
+        _current |= static_cast<uint8_t>(value << static_cast<uint8_t>(8U - _skip_bits - count));
+
+        // do we move on to the next byte?
+        if (count + _skip_bits == 8) {
+            // store the byte now
+            auto current = _current;
+            _current = 0;
+            _skip_bits = 0;
+            write(span<const uint8_t>{ &current, 1 });
+        } else {
+            // just increment the bits to skip
+            _skip_bits += count;
+        }
+
+        // allow chaining
+        return *this;
+    }
+
+    /**
+     *  Write whole bytes of data
+     *
+     *  @param  data    The data to write
+     *  @throws Forwards exceptions from the sink
+     */
+    void sink_encoder::write(span<const uint8_t> data)
+    {
+        // does the data not fit in the remainder of the buffer?
+        if (static_cast<size_t>(data.size()) > _buffer.size() - _buffered) {
+            // make room by writing out the buffer
+            drain();
+
+            // data that does not fit in the buffer at all
+            // is written out directly, without copying it
+            if (static_cast<size_t>(data.size()) >= _buffer.size()) {
+                // write straight to the sink
+                _sink(data);
+                _written += data.size();
+                return;
+            }
+        }
+
+        // add the data to the buffer
+        std::memcpy(_buffer.data() + _buffered, data.data(), data.size());
+        _buffered += data.size();
+    }
+
+    /**
+     *  Write all buffered data out to the sink
+     *
+     *  @throws Forwards exceptions from the sink
+     */
+    void sink_encoder::drain()
+    {
+        // is there anything to write?
+        if (_buffered == 0) {
+            // nothing to do
+            return;
+        }
+
+        // write out the buffered data
+        _sink(span<const uint8_t>{ _buffer.data(), _buffered });
+
+        // the data is now written
+        _written += _buffered;
+        _buffered = 0;
+    }
+
+}
@@ -0,0 +1,107 @@
+#include "thread_pool.h"
+#include <algorithm>
+
+
+namespace pgp {
+
+    /**
+     *  Constructor
+     *
+     *  @param  size    The number of worker threads to start,
+     *                  by default one for every hardware thread
+     */
+    thread_pool::thread_pool(size_t size)
+    {
+        // the hardware concurrency may not be known, so use at least one thread
+        size = std::max<size_t>(size, 1);
+
+        // start all the workers
+        _workers.reserve(size);
+        while (_workers.size() < size) {
+            // add a worker running the tasks
+            _workers.emplace_back([this]() { run(); });
+        }
+    }
+
+    /**
+     *  Destructor
+     *
+     *  This waits for all submitted tasks to complete.
+     */
+    thread_pool::~thread_pool()
+    {
+        // tell the workers to stop once the queue is empty
+        {
+            std::lock_guard<std::mutex> lock{ _mutex };
+            _stopped = true;
+        }
+
+        // wake up all the workers and wait for them to finish
+        _condition.notify_all();
+        for (auto &worker : _workers) {
+            // wait for the worker
+            worker.join();
+        }
+    }
+
+    /**
+     *  Retrieve the number of worker threads
+     *
+     *  @return The number of threads in the pool
+     */
+    size_t thread_pool::size() const noexcept
+    {
+        // return the number of workers
+        return _workers.size();
+    }
+
+    /**
+     *  Submit a task to be executed on one of the workers,
+     *  the task should not throw any exceptions
+     *
+     *  @param  task    The task to execute
+     */
+    void thread_pool::execute(std::function<void()> task)
+    {
+        // add the task to the queue
+        {
+            std::lock_guard<std::mutex> lock{ _mutex };
+            _tasks.push_back(std::move(task));
+        }
+
+        // and wake up a worker to run it
+        _condition.notify_one();
+    }
+
+    /**
+     *  Run tasks until the pool is stopped
+     */
+    void thread_pool::run()
+    {
+        // keep running tasks
+        while (true) {
+            // the task to run
+            std::function<void()> task;
+
+            // wait for a task to become available
+            {
+                std::unique_lock<std::mutex> lock{ _mutex };
+                _condition.wait(lock, [this]() { return _stopped || !_tasks.empty(); });
+
+                // are we done with all the work?
+                if (_tasks.empty()) {
+                    // the pool is stopped
+                    return;
+                }
+
+                // take the first task from the queue
+                task = std::move(_tasks.front());
+                _tasks.pop_front();
+            }
+
+            // run the task outside of the lock
+            task();
+        }
+    }
+
+}
@@ -0,0 +1,58 @@
+#include "unknown_key.h"
+
+
+namespace pgp {
+
+    /**
+     *  Constructor
+     *
+     *  @param  data    The raw key material
+     */
+    unknown_key::unknown_key(span<const uint8_t> data)
+    {
+        // copy over the key material
+        _data.assign(data.begin(), data.end());
+    }
+
+    /**
+     *  Comparison operators
+     *
+     *  @param  other   The object to compare with
+     */
+    bool unknown_key::operator==(const unknown_key &other) const noexcept
+    {
+        return _data == other._data;
+    }
+
+    /**
+     *  Comparison operators
+     *
+     *  @param  other   The object to compare with
+     */
+    bool unknown_key::operator!=(const unknown_key &other) const noexcept
+    {
+        return !operator==(other);
+    }
+
+    /**
+     *  Determine the size used in encoded format
+     *  @return The number of bytes used for encoded storage
+     */
+    size_t unknown_key::size() const noexcept
+    {
+        // we store the key material as-is
+        return _data.size();
+    }
+
+    /**
+     *  Retrieve the raw key material
+     *
+     *  @return The data following the key algorithm
+     */
+    span<const uint8_t> unknown_key::data() const noexcept
+    {
+        // provide access to the stored key material
+        return span<const uint8_t>{ _data.data(), _data.size() };
+    }
+
+}
@@ -0,0 +1,69 @@
+#include "unknown_packet.h"
+
+
+namespace pgp {
+
+    /**
+     *  Constructor
+     *
+     *  @param  tag     The tag of the packet
+     *  @param  data    The raw body data
+     */
+    unknown_packet::unknown_packet(packet_tag tag, span<const uint8_t> data) :
+        _tag{ tag },
+        _data{ data.begin(), data.end() }
+    {}
+
+    /**
+     *  Comparison operators
+     *
+     *  @param  other   The object to compare with
+     */
+    bool unknown_packet::operator==(const unknown_packet &other) const noexcept
+    {
+        return tag() == other.tag() && _data == other._data;
+    }
+
+    /**
+     *  Comparison operators
+     *
+     *  @param  other   The object to compare with
+     */
+    bool unknown_packet::operator!=(const unknown_packet &other) const noexcept
+    {
+        return !operator==(other);
+    }
+
+    /**
+     *  Retrieve the packet tag used for this
+     *  packet type
+     *  @return The packet type to use
+     */
+    packet_tag unknown_packet::tag() const noexcept
+    {
+        // return the tag we were decoded with
+        return _tag;
+    }
+
+    /**
+     *  Determine the size used in encoded format
+     *  @return The number of bytes used for encoded storage
+     */
+    size_t unknown_packet::size() const noexcept
+    {
+        // we store the body as-is
+        return _data.size();
+    }
+
+    /**
+     *  Retrieve the raw body data
+     *
+     *  @return The body of the packet
+     */
+    span<const uint8_t> unknown_packet::data() const noexcept
+    {
+        // provide access to the stored body
+        return _data;
+    }
+
+}
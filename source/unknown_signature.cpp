@@ -0,0 +1,56 @@
+#include "unknown_signature.h"
+
+
+namespace pgp {
+
+    /**
+     *  Constructor
+     *
+     *  @param  data    The raw signature data
+     */
+    unknown_signature::unknown_signature(span<const uint8_t> data) :
+        _data{ data.begin(), data.end() }
+    {}
+
+    /**
+     *  Comparison operators
+     *
+     *  @param  other   The object to compare with
+     */
+    bool unknown_signature::operator==(const unknown_signature &other) const noexcept
+    {
+        return _data == other._data;
+    }
+
+    /**
+     *  Comparison operators
+     *
+     *  @param  other   The object to compare with
+     */
+    bool unknown_signature::operator!=(const unknown_signature &other) const noexcept
+    {
+        return !operator==(other);
+    }
+
+    /**
+     *  Determine the size used in encoded format
+     *  @return The number of bytes used for encoded storage
+     */
+    size_t unknown_signature::size() const noexcept
+    {
+        // we store the signature data as-is
+        return _data.size();
+    }
+
+    /**
+     *  Retrieve the raw signature data
+     *
+     *  @return The data following the hash prefix
+     */
+    span<const uint8_t> unknown_signature::data() const noexcept
+    {
+        // provide access to the stored signature data
+        return _data;
+    }
+
+}
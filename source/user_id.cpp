@@ -8,8 +8,9 @@ namespace pgp {
      *  Constructor
      *
      *  @param  id      The user id to use
+     *  @throws std::bad_alloc
      */
-    user_id::user_id(span<const char> id) noexcept :
+    user_id::user_id(span<const char> id) :
         _id{ id.data(), static_cast<std::size_t>(id.size()) }
     {}
 
@@ -0,0 +1,66 @@
+#include "user_id_view.h"
+
+
+namespace pgp {
+
+    /**
+     *  Constructor
+     *
+     *  @param  id      The user id to refer to
+     */
+    user_id_view::user_id_view(span<const char> id) noexcept :
+        _id{ id }
+    {}
+
+    /**
+     *  Comparison operators
+     *
+     *  @param  other   The object to compare with
+     */
+    bool user_id_view::operator==(const user_id_view &other) const noexcept
+    {
+        return id() == other.id();
+    }
+
+    /**
+     *  Comparison operators
+     *
+     *  @param  other   The object to compare with
+     */
+    bool user_id_view::operator!=(const user_id_view &other) const noexcept
+    {
+        return !operator==(other);
+    }
+
+    /**
+     *  Determine the size used in encoded format
+     *  @return The number of bytes used for encoded storage
+     */
+    size_t user_id_view::size() const noexcept
+    {
+        // retrieve the size of the id
+        return _id.size();
+    }
+
+    /**
+     *  Retrieve the user id
+     *
+     *  @return The user id
+     */
+    span<const char> user_id_view::id() const noexcept
+    {
+        // return the referenced id
+        return _id;
+    }
+
+    /**
+     *  Convert to an owning user id, copying the data
+     *  @return The user id holding a copy of the data
+     */
+    user_id_view::operator user_id() const
+    {
+        // copy the id into a new user id
+        return user_id{ _id };
+    }
+
+}
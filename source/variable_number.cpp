@@ -12,6 +12,29 @@ namespace pgp {
         _value{ value }
     {}
 
+    /**
+     *  Create a partial body length
+     *
+     *  @param  value   The size of the chunk, a power of two up to 2^30
+     *  @return The partial body length
+     *  @throws std::range_error
+     */
+    variable_number variable_number::partial(uint32_t value)
+    {
+        // partial lengths can only encode powers of two, up to 2^30
+        if (value == 0 || (value & (value - 1)) != 0 || value > (1U << 30)) {
+            // this cannot be encoded as a partial length
+            throw std::range_error{ "Partial body length must be a power of two no larger than 2^30" };
+        }
+
+        // create the number and mark it as partial
+        variable_number result{ value };
+        result._partial = true;
+
+        // return the partial length
+        return result;
+    }
+
     /**
      *  Assignment operator
      *
@@ -20,13 +43,26 @@ namespace pgp {
      */            
     variable_number &variable_number::operator=(uint32_t value) noexcept
     {              
-        // update value
-        _value = value;
+        // update value, which is a regular length
+        _value      = value;
+        _partial    = false;
 
         // allow chaining
         return *this;
     }
 
+    /**
+     *  Check whether this is a partial body length, meaning that
+     *  more chunks of body data follow after this one
+     *
+     *  @return Whether the length is partial
+     */
+    bool variable_number::is_partial() const noexcept
+    {
+        // return whether the length is partial
+        return _partial;
+    }
+
     /**
      *  Determine the size used in encoded format
      *
@@ -35,7 +71,10 @@ namespace pgp {
     size_t variable_number::size() const noexcept
     {
         // size depends on the stored value
-        if (_value < 192) {
+        if (_partial) {
+            // partial lengths always use a single octet
+            return 1;
+        } else if (_value < 192) {
             // this can be done in a single octet
             return 1;
         } else if (_value < 8384) {
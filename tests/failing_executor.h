@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include "thread_pool.h"
+
+
+namespace tests {
+
+    /**
+     *  An executor that accepts a limited number of tasks,
+     *  after which it fails to accept any more
+     *
+     *  Accepted tasks are delayed a little before they are started,
+     *  so that a caller not waiting for them is likely to return
+     *  before they start, which shows up in the started counter.
+     */
+    class failing_executor
+    {
+        public:
+            /**
+             *  Constructor
+             *
+             *  @param  limit   The number of tasks to accept
+             */
+            explicit failing_executor(size_t limit) :
+                _limit{ limit }
+            {}
+
+            /**
+             *  Submit a task to be executed
+             *
+             *  @param  task    The task to execute
+             *  @throws std::runtime_error when the limit is reached
+             */
+            void execute(std::function<void()> task)
+            {
+                // are we still accepting tasks?
+                if (accepted == _limit) {
+                    // the queue is full
+                    throw std::runtime_error{ "Executor does not accept more tasks" };
+                }
+
+                // run the task after a short delay
+                ++accepted;
+                _pool.execute([this, task = std::move(task)]() {
+                    std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+                    ++started;
+                    task();
+                });
+            }
+
+            size_t              accepted    { 0 };  // the number of tasks accepted
+            std::atomic<size_t> started     { 0 };  // the number of tasks started
+        private:
+            size_t              _limit;             // the number of tasks to accept
+            pgp::thread_pool    _pool       { 2 };  // the pool running the tasks
+    };
+
+}
@@ -1,4 +1,5 @@
 #include <sodium/randombytes.h>
+#include "range_encoder.h"
 #include "generate.h"
 
 
@@ -66,6 +67,61 @@ namespace tests::generate {
         });
     }
 
+    std::vector<pgp::packet> packets()
+    {
+        using namespace std::literals;
+
+        std::vector<pgp::packet> packets;
+        auto [key, public_data, secret_data] = eddsa::key();
+        pgp::user_id user{ "Anne Onymous <anonymous@example.org>"s };
+
+        pgp::signature_subpacket_set hashed{{
+            pgp::signature_subpacket::signature_creation_time{ 1234 },
+            pgp::signature_subpacket::key_flags{ 0x03 }
+        }};
+        pgp::signature_subpacket_set unhashed{{
+            pgp::signature_subpacket::issuer{{ 1, 2, 3, 4, 5, 6, 7, 8 }}
+        }};
+
+        packets.emplace_back(pgp::in_place_type_t<pgp::secret_key>{}, key);
+        packets.emplace_back(pgp::in_place_type_t<pgp::user_id>{}, user);
+        packets.emplace_back(pgp::in_place_type_t<pgp::signature>{}, key, user, hashed, unhashed);
+        packets.emplace_back(pgp::in_place_type_t<pgp::public_subkey>{},
+            1234, pgp::key_algorithm::rsa_encrypt_or_sign, pgp::in_place_type_t<pgp::public_subkey::rsa_key_t>{},
+            mpi(), mpi()
+        );
+        packets.emplace_back(pgp::in_place_type_t<pgp::public_key>{},
+            5678, pgp::key_algorithm::dsa, pgp::in_place_type_t<pgp::public_key::dsa_key_t>{},
+            mpi(), mpi(), mpi(), mpi()
+        );
+        packets.emplace_back(pgp::in_place_type_t<pgp::public_subkey>{},
+            9012, pgp::key_algorithm::ecdh, pgp::in_place_type_t<pgp::public_subkey::ecdh_key_t>{},
+            pgp::curve_oid::curve_25519(), mpi(), pgp::hash_algorithm::sha256, pgp::symmetric_key_algorithm::aes128
+        );
+        packets.emplace_back(pgp::in_place_type_t<pgp::user_id>{}, std::string(300, 'b'));
+        packets.emplace_back(pgp::in_place_type_t<pgp::user_id>{}, ""s);
+
+        return packets;
+    }
+
+    std::vector<uint8_t> encode_packets(const std::vector<pgp::packet> &packets)
+    {
+        // determine the size of the buffer
+        size_t size = 0;
+        for (auto &packet : packets) {
+            size += packet.size();
+        }
+
+        // and encode the packets into it
+        std::vector<uint8_t> data(size);
+        pgp::range_encoder encoder{ data };
+        for (auto &packet : packets) {
+            packet.encode(encoder);
+        }
+
+        return data;
+    }
+
     namespace eddsa {
         std::tuple<
             pgp::secret_key,
@@ -102,7 +158,7 @@ namespace tests::generate {
                     pgp::curve_oid::ed25519(),
                     pgp::multiprecision_integer(pubkey)
                 ),
-                std::make_tuple(pgp::multiprecision_integer(seckey))
+                std::make_tuple(pgp::secret_multiprecision_integer(seckey))
             };
 
             return std::make_tuple(sk, pubkey, seckey);
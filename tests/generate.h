@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cryptopp/eccrypto.h>
+#include <cryptopp/oids.h>
+#include <cryptopp/osrng.h>
+#include <cryptopp/rsa.h>
 #include "symmetric_key_algorithm.h"
 #include "multiprecision_integer.h"
 #include "device_random_engine.h"
@@ -7,8 +11,12 @@
 #include "hash_algorithm.h"
 #include "secret_key.h"
 #include "curve_oid.h"
+#include "null_hash.h"
+#include "packet.h"
+#include <algorithm>
 #include <vector>
 #include <random>
+#include <tuple>
 
 
 namespace tests::generate {
@@ -31,6 +39,22 @@ namespace tests::generate {
 
     pgp::symmetric_key_algorithm keyalgo();
 
+    /**
+     *  Create a keyring of varying packet types and sizes,
+     *  starting with a secret key, its user id and signature
+     *
+     *  @return The packets in the keyring
+     */
+    std::vector<pgp::packet> packets();
+
+    /**
+     *  Encode all packets into a single buffer
+     *
+     *  @param  packets The packets to encode
+     *  @return The encoded packets
+     */
+    std::vector<uint8_t> encode_packets(const std::vector<pgp::packet> &packets);
+
     namespace eddsa {
         constexpr const std::array<uint8_t, 1> public_key_tag{0x40};
         constexpr const size_t public_key_size = public_key_tag.size() + crypto_sign_PUBLICKEYBYTES;
@@ -47,4 +71,92 @@ namespace tests::generate {
             std::array<uint8_t, secret_key_size>
         > key();
     }
+
+    /**
+     *  Generate an EDDSA key on the ed25519 curve.
+     *
+     *  @tparam  Key The key type to generate, public or secret
+     *  @return The generated key
+     */
+    template <typename Key = pgp::secret_key>
+    Key eddsa_key()
+    {
+        // generate the key pair
+        std::array<uint8_t, crypto_sign_PUBLICKEYBYTES> pubkey;
+        std::array<uint8_t, crypto_sign_SECRETKEYBYTES> seckey;
+        crypto_sign_keypair(pubkey.data(), seckey.data());
+
+        // the public key is prefixed with a tag byte
+        std::array<uint8_t, crypto_sign_PUBLICKEYBYTES + 1> Q{ 0x40 };
+        std::copy(pubkey.begin(), pubkey.end(), Q.begin() + 1);
+
+        return Key{
+            1554106568,
+            pgp::key_algorithm::eddsa,
+            pgp::in_place_type_t<typename Key::eddsa_key_t>(),
+            std::make_tuple(pgp::curve_oid::ed25519(), pgp::multiprecision_integer{ Q }),
+            std::make_tuple(pgp::secret_multiprecision_integer{ pgp::span<const uint8_t>{ seckey.data(), 32 } })
+        };
+    }
+
+    /**
+     *  Generate an ECDSA key on the NIST P-256 curve.
+     *
+     *  @tparam  Key The key type to generate, public or secret
+     *  @return The generated key
+     */
+    template <typename Key = pgp::secret_key>
+    Key ecdsa_key()
+    {
+        CryptoPP::AutoSeededRandomPool prng;
+
+        // generate the key pair
+        CryptoPP::ECDSA<CryptoPP::ECP, pgp::NullHash<32>>::PrivateKey private_key;
+        CryptoPP::ECDSA<CryptoPP::ECP, pgp::NullHash<32>>::PublicKey public_key;
+        private_key.Initialize(prng, CryptoPP::ASN1::secp256r1());
+        private_key.MakePublicKey(public_key);
+
+        // encode the public key as an uncompressed point
+        std::array<uint8_t, 65> Q{ 0x04 };
+        public_key.GetPublicElement().x.Encode(Q.data() + 1, 32);
+        public_key.GetPublicElement().y.Encode(Q.data() + 33, 32);
+
+        return Key{
+            1554106568,
+            pgp::key_algorithm::ecdsa,
+            pgp::in_place_type_t<typename Key::ecdsa_key_t>(),
+            std::make_tuple(pgp::curve_oid::ecdsa(), pgp::multiprecision_integer{ Q }),
+            std::make_tuple(pgp::secret_multiprecision_integer{ private_key.GetPrivateExponent() })
+        };
+    }
+
+    /**
+     *  Generate a 2048-bit RSA key.
+     *
+     *  @tparam  Key The key type to generate, public or secret
+     *  @return The generated key
+     */
+    template <typename Key = pgp::secret_key>
+    Key rsa_key()
+    {
+        CryptoPP::AutoSeededRandomPool prng;
+
+        CryptoPP::RSA::PrivateKey private_key;
+        private_key.GenerateRandomWithKeySize(prng, 2048);
+
+        pgp::multiprecision_integer n{ private_key.GetModulus()         };
+        pgp::multiprecision_integer e{ private_key.GetPublicExponent()  };
+
+        pgp::secret_multiprecision_integer d{ private_key.GetPrivateExponent()                          };
+        pgp::secret_multiprecision_integer p{ private_key.GetPrime2()                                   };
+        pgp::secret_multiprecision_integer q{ private_key.GetPrime1()                                   };
+        pgp::secret_multiprecision_integer u{ private_key.GetMultiplicativeInverseOfPrime2ModPrime1()   };
+
+        return Key{
+            1554106568,
+            pgp::key_algorithm::rsa_encrypt_or_sign,
+            pgp::in_place_type_t<typename Key::rsa_key_t>(),
+            std::make_tuple(n, e), std::make_tuple(d, p, q, u)
+        };
+    }
 }
@@ -209,12 +209,19 @@ namespace tests {
             { return output_project_type((instance.*member_function)()); }
         };
 
+        template <typename>
+        struct member_result;
+
+        template <typename R, typename C>
+        struct member_result<R (C::*)() const noexcept> { using type = std::decay_t<R>; };
+
         template <auto member_function>
         struct mpi {
-            using Type = pgp::multiprecision_integer;
+            // public or secret integer, depending on the member
+            using Type = typename member_result<decltype(member_function)>::type;
 
             static Type generate()
-            { return generate::mpi(); }
+            { return Type{ generate::mpi() }; }
 
             static pgp::span<const uint8_t> eq_project_type(const Type &value)
             { return value.data(); }
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include "certify.h"
+#include "verify.h"
+#include "../generate.h"
+
+
+namespace {
+
+    pgp::signature_subpacket_set subpackets(uint8_t flags)
+    {
+        return pgp::signature_subpacket_set{{
+            pgp::signature_subpacket::signature_creation_time{ 1554106568 },
+            pgp::signature_subpacket::key_flags{ flags }
+        }};
+    }
+
+}
+
+TEST(certify, key_hash)
+{
+    // only a context for a primary key keeps the hashed key
+    ASSERT_NE(pgp::signing_context{ tests::generate::eddsa_key() }.key_hash(), nullptr);
+    ASSERT_EQ(pgp::signing_context{ tests::generate::eddsa_key<pgp::secret_subkey>() }.key_hash(), nullptr);
+}
+
+TEST(certify, certify_all)
+{
+    using namespace std::literals;
+
+    auto key = tests::generate::eddsa_key();
+    std::vector<pgp::user_id> user_ids{
+        pgp::user_id{ "Alice <alice@example.com>"s },
+        pgp::user_id{ "Alice <alice@example.org>"s },
+        pgp::user_id{ "Alice <alice@example.net>"s }
+    };
+    std::vector<pgp::secret_subkey> subkeys{
+        tests::generate::eddsa_key<pgp::secret_subkey>(),
+        tests::generate::eddsa_key<pgp::secret_subkey>()
+    };
+
+    auto signatures = pgp::certify_all(key, user_ids, subkeys, subpackets(0x03), subpackets(0x0c));
+    ASSERT_EQ(signatures.size(), user_ids.size() + subkeys.size());
+
+    // the certifications come first
+    for (size_t i = 0; i < user_ids.size(); ++i) {
+        ASSERT_EQ(signatures[i].type(), pgp::signature_type::positive_user_id_and_public_key_certification);
+        ASSERT_TRUE(pgp::verify(signatures[i], key, pgp::user_id_certification{ key, user_ids[i] }));
+
+        // and are the same as those made one at a time
+        ASSERT_EQ(signatures[i], (pgp::signature{ key, user_ids[i], subpackets(0x03), {} }));
+    }
+
+    // followed by the subkey bindings
+    for (size_t i = 0; i < subkeys.size(); ++i) {
+        auto &binding = signatures[user_ids.size() + i];
+
+        ASSERT_EQ(binding.type(), pgp::signature_type::subkey_binding);
+        ASSERT_TRUE(pgp::verify(binding, key, pgp::key_binding{ key, subkeys[i] }));
+        ASSERT_EQ(binding, (pgp::signature{ key, subkeys[i], subpackets(0x0c), {} }));
+    }
+}
+
+TEST(certify, user_ids_only)
+{
+    using namespace std::literals;
+
+    auto key = tests::generate::eddsa_key();
+    std::vector<pgp::user_id> user_ids{ pgp::user_id{ "Alice <alice@example.com>"s } };
+
+    auto signatures = pgp::certify_all(key, user_ids, {}, subpackets(0x03), {});
+    ASSERT_EQ(signatures.size(), 1);
+    ASSERT_TRUE(pgp::verify(signatures[0], key, pgp::user_id_certification{ key, user_ids[0] }));
+}
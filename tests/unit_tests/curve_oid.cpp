@@ -2,9 +2,11 @@
 #include <cstddef>
 #include <array>
 #include <cstdint>
+#include <stdexcept>
 #include <vector>
 #include "curve_oid.h"
 #include "decoder.h"
+#include "range_encoder.h"
 #include "util/narrow_cast.h"
 
 
@@ -54,3 +56,59 @@ TEST(curve_oid, other_data)
     pgp::curve_oid oid2{data};
     ASSERT_EQ(pgp::span<const uint8_t>(data), oid2.data());
 }
+
+TEST(curve_oid, known_curves)
+{
+    ASSERT_EQ(pgp::curve_oid::ed25519().id(), pgp::curve_id::ed25519);
+    ASSERT_EQ(pgp::curve_oid::curve_25519().id(), pgp::curve_id::curve_25519);
+    ASSERT_EQ(pgp::curve_oid::ecdsa().id(), pgp::curve_id::nist_p256);
+
+    for (auto &known : pgp::known_curves) {
+        std::vector<uint8_t> data{ known.size };
+        data.insert(data.end(), known.data.begin(), known.data.begin() + known.size);
+
+        pgp::decoder decoder{data};
+        pgp::curve_oid oid{decoder};
+        ASSERT_EQ(oid.id(), known.id);
+        ASSERT_EQ(oid, pgp::curve_oid{ known.id });
+        ASSERT_EQ(oid.size(), data.size());
+    }
+
+    pgp::curve_oid unknown{{ 1, 2, 3, 4 }};
+    ASSERT_EQ(unknown.id(), pgp::curve_id::unknown);
+    ASSERT_EQ(pgp::curve_oid{}.id(), pgp::curve_id::unknown);
+
+    // a prefix of a known curve is not that curve
+    pgp::curve_oid prefix{{ 0x2b, 0x06, 0x01, 0x04, 0x01, 0xda, 0x47, 0x0f }};
+    ASSERT_EQ(prefix.id(), pgp::curve_id::unknown);
+    ASSERT_NE(prefix, pgp::curve_oid::ed25519());
+}
+
+TEST(curve_oid, long_identifier)
+{
+    std::vector<uint8_t> data(pgp::curve_oid::inline_size + 2, 1);
+    data[0] = util::narrow_cast<uint8_t>(pgp::curve_oid::inline_size + 1);
+
+    // a long identifier is kept, but it is not a curve we know
+    pgp::decoder decoder{data};
+    pgp::curve_oid oid{decoder};
+    ASSERT_EQ(oid.id(), pgp::curve_id::unknown);
+    ASSERT_EQ(oid.size(), data.size());
+    ASSERT_EQ(oid.data(), pgp::span<const uint8_t>(data.data() + 1, data.size() - 1));
+    ASSERT_EQ(oid, pgp::curve_oid{oid.data()});
+    ASSERT_NE(oid, pgp::curve_oid{pgp::span<const uint8_t>(data.data(), data.size() - 1)});
+
+    // copies keep their own data
+    pgp::curve_oid copy{oid};
+    ASSERT_EQ(copy, oid);
+    ASSERT_NE(copy.data().data(), oid.data().data());
+
+    // it is encoded exactly as it was read
+    std::vector<uint8_t> encoded(oid.size());
+    oid.encode(pgp::range_encoder{encoded});
+    ASSERT_EQ(encoded, data);
+
+    // but identifiers that do not fit the size header cannot be stored
+    std::vector<uint8_t> huge(256, 1);
+    ASSERT_THROW(pgp::curve_oid{pgp::span<const uint8_t>{huge}}, std::range_error);
+}
@@ -110,3 +110,61 @@ TEST(decoder, splice)
     ASSERT_EQ(decoder.extract_number<uint8_t>(), 0x78);
     ASSERT_TRUE(decoder.empty());
 }
+
+TEST(decoder, offset)
+{
+    const std::array<uint8_t, 6> data{ 0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc };
+
+    pgp::decoder decoder{data};
+    ASSERT_EQ(decoder.offset(), 0);
+
+    decoder.extract_bits(4);
+    ASSERT_EQ(decoder.offset(), 0);
+    decoder.extract_bits(4);
+    ASSERT_EQ(decoder.offset(), 1);
+
+    decoder.extract_number<uint16_t>();
+    ASSERT_EQ(decoder.offset(), 3);
+
+    auto subdec = decoder.splice(2);
+    ASSERT_EQ(subdec.offset(), 3);
+    ASSERT_EQ(decoder.offset(), 5);
+
+    subdec.extract_blob<uint8_t>(1);
+    ASSERT_EQ(subdec.offset(), 4);
+}
+
+TEST(decoder, report_error)
+{
+    const std::array<uint8_t, 4> data{ 0x12, 0x34, 0x56, 0x78 };
+
+    pgp::decode_error error;
+    pgp::decoder decoder{data, error};
+
+    ASSERT_EQ(decoder.extract_number<uint16_t>(), 0x1234);
+    ASSERT_FALSE(error);
+
+    // reading too much reports the error and discards the remaining data
+    ASSERT_EQ(decoder.extract_number<uint32_t>(), 0);
+    ASSERT_EQ(error, pgp::decode_error(pgp::decode_error_kind::truncated, 2));
+    ASSERT_TRUE(decoder.empty());
+
+    // later errors do not overwrite the first one
+    ASSERT_NO_THROW(decoder.extract_bits(1));
+    ASSERT_NO_THROW(decoder.fail(pgp::decode_error_kind::unexpected_value, "unexpected"));
+    ASSERT_EQ(error.kind(), pgp::decode_error_kind::truncated);
+
+    // spliced decoders report to the same error
+    pgp::decode_error splice_error;
+    pgp::decoder splice_decoder{data, splice_error};
+    auto subdec = splice_decoder.splice(2);
+    ASSERT_TRUE(subdec.extract_blob<uint8_t>(3).empty());
+    ASSERT_EQ(splice_error, pgp::decode_error(pgp::decode_error_kind::truncated, 0));
+    ASSERT_EQ(splice_decoder.extract_number<uint16_t>(), 0x5678);
+
+    // without an error to report to, exceptions are raised
+    pgp::decoder throwing{data};
+    ASSERT_THROW(throwing.fail(pgp::decode_error_kind::truncated, "truncated"), std::out_of_range);
+    ASSERT_THROW(throwing.fail(pgp::decode_error_kind::unexpected_value, "unexpected"), std::range_error);
+    ASSERT_THROW(throwing.fail(pgp::decode_error_kind::invalid_header, "invalid"), std::runtime_error);
+}
@@ -68,7 +68,7 @@ namespace {
             pgp::key_algorithm::ecdsa,
             pgp::in_place_type_t<pgp::secret_key::ecdsa_key_t>(),
             std::make_tuple(pgp::curve_oid::ed25519(), pgp::multiprecision_integer(inps.pubkey)),
-            std::make_tuple(pgp::multiprecision_integer(inps.seckey))
+            std::make_tuple(pgp::secret_multiprecision_integer(inps.seckey))
         };
 
         pgp::ecdsa_signature::encoder_t sig_encoder{sk};
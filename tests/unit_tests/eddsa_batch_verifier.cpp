@@ -0,0 +1,481 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <string>
+#include <vector>
+#include <sodium/crypto_core_ed25519.h>
+#include <sodium/crypto_hash_sha512.h>
+#include <sodium/crypto_scalarmult_ed25519.h>
+#include <sodium/crypto_sign.h>
+#include <sodium/randombytes.h>
+#include "eddsa_batch_verifier.h"
+#include "eddsa_signature.h"
+#include "eddsa_signature_verifier.h"
+#include "unsupported_algorithm.h"
+
+
+namespace {
+
+    struct signer
+    {
+        pgp::eddsa_public_key                               key;
+        std::array<uint8_t, crypto_sign_SECRETKEYBYTES>     seckey;
+    };
+
+    struct signed_digest
+    {
+        const signer               *by;
+        pgp::eddsa_signature        sig;
+        std::array<uint8_t, 32>     digest;
+    };
+
+    signer make_signer()
+    {
+        // generate the key pair
+        std::array<uint8_t, crypto_sign_PUBLICKEYBYTES> pubkey;
+        std::array<uint8_t, crypto_sign_SECRETKEYBYTES> seckey;
+        crypto_sign_keypair(pubkey.data(), seckey.data());
+
+        // the public key is prefixed with a tag byte
+        std::array<uint8_t, crypto_sign_PUBLICKEYBYTES + 1> Q{ 0x40 };
+        std::copy(pubkey.begin(), pubkey.end(), Q.begin() + 1);
+
+        return signer{ pgp::eddsa_public_key{ pgp::curve_oid::ed25519(), pgp::multiprecision_integer{ Q } }, seckey };
+    }
+
+    pgp::eddsa_signature make_signature(const std::array<uint8_t, 64> &data)
+    {
+        // split the signature in r and s
+        return pgp::eddsa_signature{
+            pgp::multiprecision_integer{ pgp::span<const uint8_t>{ data.data(), 32 } },
+            pgp::multiprecision_integer{ pgp::span<const uint8_t>{ data.data() + 32, 32 } }
+        };
+    }
+
+    signed_digest sign(const signer &by)
+    {
+        // sign a random digest
+        std::array<uint8_t, 32> digest;
+        std::array<uint8_t, crypto_sign_BYTES> data;
+        randombytes_buf(digest.data(), digest.size());
+        crypto_sign_detached(data.data(), nullptr, digest.data(), digest.size(), by.seckey.data());
+
+        return signed_digest{ &by, make_signature(data), digest };
+    }
+
+    std::array<uint8_t, 64> signature_data(const pgp::eddsa_signature &sig)
+    {
+        // r and s may have lost their leading zeroes
+        std::array<uint8_t, 64> data{};
+        auto r = sig.r().data();
+        auto s = sig.s().data();
+        std::copy(r.begin(), r.end(), data.begin() + 32 - r.size());
+        std::copy(s.begin(), s.end(), data.end() - s.size());
+        return data;
+    }
+
+    std::vector<bool> verify_batch(const std::vector<signed_digest> &signatures)
+    {
+        pgp::eddsa_batch_verifier verifier;
+        for (auto &current : signatures) {
+            verifier.add(current.by->key, current.sig, current.digest);
+        }
+
+        EXPECT_EQ(verifier.size(), signatures.size());
+        return verifier.verify();
+    }
+
+    pgp::eddsa_public_key make_key(const std::array<uint8_t, 32> &pubkey)
+    {
+        // the public key is prefixed with a tag byte
+        std::array<uint8_t, 33> Q{ 0x40 };
+        std::copy(pubkey.begin(), pubkey.end(), Q.begin() + 1);
+
+        return pgp::eddsa_public_key{ pgp::curve_oid::ed25519(), pgp::multiprecision_integer{ Q } };
+    }
+
+    std::vector<uint8_t> from_hex(const std::string &hex)
+    {
+        std::vector<uint8_t> result;
+        for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+            result.push_back(static_cast<uint8_t>(std::stoul(hex.substr(i, 2), nullptr, 16)));
+        }
+        return result;
+    }
+
+    template <size_t size>
+    std::array<uint8_t, size> from_hex_array(const std::string &hex)
+    {
+        auto data = from_hex(hex);
+        std::array<uint8_t, size> result{};
+        std::copy(data.begin(), data.end(), result.begin());
+        return result;
+    }
+
+    // a raw signature over a message, as used by libsodium
+    struct raw_signature
+    {
+        std::array<uint8_t, 32>     key;
+        std::array<uint8_t, 64>     sig;
+        std::vector<uint8_t>        message;
+    };
+
+    std::vector<bool> verify_batch(const std::vector<raw_signature> &signatures)
+    {
+        std::vector<pgp::eddsa_public_key> keys;
+        for (auto &current : signatures) {
+            keys.push_back(make_key(current.key));
+        }
+
+        pgp::eddsa_batch_verifier verifier;
+        for (size_t i = 0; i < signatures.size(); ++i) {
+            verifier.add(keys[i], make_signature(signatures[i].sig), signatures[i].message);
+        }
+        return verifier.verify();
+    }
+
+    std::vector<bool> verify_sodium(const std::vector<raw_signature> &signatures)
+    {
+        std::vector<bool> results;
+        for (auto &current : signatures) {
+            results.push_back(crypto_sign_verify_detached(current.sig.data(), current.message.data(), current.message.size(), current.key.data()) == 0);
+        }
+        return results;
+    }
+
+    // the points of order 8, encoded
+    const std::array<std::array<uint8_t, 32>, 2> order_8_points{{
+        { 0x26, 0xe8, 0x95, 0x8f, 0xc2, 0xb2, 0x27, 0xb0, 0x45, 0xc3, 0xf4, 0x89, 0xf2, 0xef, 0x98, 0xf0,
+          0xd5, 0xdf, 0xac, 0x05, 0xd3, 0xc6, 0x33, 0x39, 0xb1, 0x38, 0x02, 0x88, 0x6d, 0x53, 0xfc, 0x05 },
+        { 0xc7, 0x17, 0x6a, 0x70, 0x3d, 0x4d, 0xd8, 0x4f, 0xba, 0x3c, 0x0b, 0x76, 0x0d, 0x10, 0x67, 0x0f,
+          0x2a, 0x20, 0x53, 0xfa, 0x2c, 0x39, 0xcc, 0xc6, 0x4e, 0xc7, 0xfd, 0x77, 0x92, 0xac, 0x03, 0x7a }
+    }};
+
+    // sign with a secret scalar, using r and a public key that need not match it
+    std::array<uint8_t, 64> sign_raw(const std::array<uint8_t, 32> &a, const std::array<uint8_t, 32> &r, const std::array<uint8_t, 32> &R, const std::array<uint8_t, 32> &A, const std::vector<uint8_t> &message, std::array<uint8_t, 32> &h)
+    {
+        // h = H(R || A || M)
+        std::array<uint8_t, 64> hash;
+        crypto_hash_sha512_state state;
+        crypto_hash_sha512_init(&state);
+        crypto_hash_sha512_update(&state, R.data(), R.size());
+        crypto_hash_sha512_update(&state, A.data(), A.size());
+        crypto_hash_sha512_update(&state, message.data(), message.size());
+        crypto_hash_sha512_final(&state, hash.data());
+        crypto_core_ed25519_scalar_reduce(h.data(), hash.data());
+
+        // s = r + h * a
+        std::array<uint8_t, 64> sig;
+        std::copy(R.begin(), R.end(), sig.begin());
+        crypto_core_ed25519_scalar_mul(sig.data() + 32, h.data(), a.data());
+        crypto_core_ed25519_scalar_add(sig.data() + 32, sig.data() + 32, r.data());
+        return sig;
+    }
+
+    std::vector<bool> verify_single(const std::vector<signed_digest> &signatures)
+    {
+        std::vector<bool> results;
+        for (auto &current : signatures) {
+            pgp::eddsa_signature_verifier verifier{ current.by->key };
+            results.push_back(verifier.verify(current.sig, pgp::hash_algorithm::sha256, current.digest));
+        }
+        return results;
+    }
+
+}
+
+TEST(eddsa_batch_verifier, valid)
+{
+    // a few keys, making a lot of signatures each
+    std::vector<signer> signers;
+    for (size_t i = 0; i < 5; ++i) {
+        signers.push_back(make_signer());
+    }
+
+    std::vector<signed_digest> signatures;
+    for (size_t i = 0; i < 135; ++i) {
+        signatures.push_back(sign(signers[i % signers.size()]));
+    }
+
+    auto results = verify_batch(signatures);
+    ASSERT_EQ(results, std::vector<bool>(signatures.size(), true));
+    ASSERT_EQ(results, verify_single(signatures));
+
+    // an empty batch is fine too
+    ASSERT_TRUE(pgp::eddsa_batch_verifier{}.verify().empty());
+}
+
+TEST(eddsa_batch_verifier, invalid)
+{
+    std::vector<signer> signers;
+    for (size_t i = 0; i < 3; ++i) {
+        signers.push_back(make_signer());
+    }
+
+    std::vector<signed_digest> signatures;
+    for (size_t i = 0; i < 84; ++i) {
+        signatures.push_back(sign(signers[i % signers.size()]));
+    }
+
+    // a signature over another digest
+    signatures[3].digest[0] ^= 0x01;
+
+    // a signature attributed to the wrong key
+    signatures[10].by = &signers[(signatures[10].by - signers.data() + 1) % signers.size()];
+
+    // a damaged r
+    auto data = signature_data(signatures[17].sig);
+    data[5] ^= 0x20;
+    signatures[17].sig = make_signature(data);
+
+    // s increased by the group order, which is not accepted
+    data = signature_data(signatures[25].sig);
+    constexpr std::array<uint8_t, 32> order{
+        0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58,
+        0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10
+    };
+    unsigned carry = 0;
+    for (size_t i = 0; i < order.size(); ++i) {
+        carry += data[32 + i] + order[i];
+        data[32 + i] = static_cast<uint8_t>(carry);
+        carry >>= 8;
+    }
+    signatures[25].sig = make_signature(data);
+
+    // r is the neutral element, which has a small order
+    data = signature_data(signatures[40].sig);
+    std::fill(data.begin(), data.begin() + 32, 0);
+    data[0] = 0x01;
+    signatures[40].sig = make_signature(data);
+
+    // a signature near the end
+    signatures[66].digest[31] ^= 0x80;
+
+    // every bad signature is found, and only those
+    auto results = verify_batch(signatures);
+    auto expected = std::vector<bool>(signatures.size(), true);
+    for (size_t index : { size_t{ 3 }, size_t{ 10 }, size_t{ 17 }, size_t{ 25 }, size_t{ 40 }, size_t{ 66 } }) {
+        expected[index] = false;
+    }
+
+    ASSERT_EQ(results, expected);
+    ASSERT_EQ(results, verify_single(signatures));
+}
+
+TEST(eddsa_batch_verifier, invalid_key)
+{
+    auto good = make_signer();
+    auto data = sign(good);
+
+    // a key without the prefix byte
+    std::array<uint8_t, 33> Q{ 0x41 };
+    auto public_data = good.key.Q().data();
+    std::copy(public_data.begin() + 1, public_data.end(), Q.begin() + 1);
+    signer bad{ pgp::eddsa_public_key{ pgp::curve_oid::ed25519(), pgp::multiprecision_integer{ Q } }, good.seckey };
+
+    // a key of small order
+    std::array<uint8_t, 33> identity{ 0x40, 0x01 };
+    signer small{ pgp::eddsa_public_key{ pgp::curve_oid::ed25519(), pgp::multiprecision_integer{ identity } }, good.seckey };
+
+    std::vector<signed_digest> signatures{
+        data,
+        signed_digest{ &bad, data.sig, data.digest },
+        signed_digest{ &small, data.sig, data.digest }
+    };
+
+    ASSERT_EQ(verify_batch(signatures), (std::vector<bool>{ true, false, false }));
+    ASSERT_EQ(verify_batch(signatures), verify_single(signatures));
+
+    // also when the keys made enough signatures to get a table
+    for (size_t i = 0; i < 3; ++i) {
+        signatures.insert(signatures.end(), { signatures[0], signatures[1], signatures[2] });
+    }
+    ASSERT_EQ(verify_batch(signatures), verify_single(signatures));
+}
+
+TEST(eddsa_batch_verifier, unsupported)
+{
+    auto good = make_signer();
+    auto data = sign(good);
+
+    // a key on a curve we don't support
+    pgp::eddsa_public_key key{ pgp::curve_oid::ecdsa(), good.key.Q() };
+
+    pgp::eddsa_batch_verifier verifier;
+    ASSERT_THROW(verifier.add(key, data.sig, data.digest), pgp::unsupported_algorithm);
+}
+
+TEST(eddsa_batch_verifier, rfc8032)
+{
+    // the test vectors from RFC 8032, section 7.1
+    struct vector
+    {
+        const char *secret;
+        const char *key;
+        const char *message;
+        const char *signature;
+    };
+
+    std::array<vector, 3> vectors{{
+        {
+            "9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60",
+            "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+            "",
+            "e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e065224901555fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b"
+        }, {
+            "4ccd089b28ff96da9db6c346ec114e0f5b8a319f35aba624da8cf6ed4fb8a6fb",
+            "3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c",
+            "72",
+            "92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da085ac1e43e15996e458f3613d0f11d8c387b2eaeb4302aeeb00d291612bb0c00"
+        }, {
+            "c5aa8df43f9f837bedb7442f31dcb7b166d38535076f094b85ce3a2e0b4458f7",
+            "fc51cd8e6218a1a38da47ed00230f0580816ed13ba3303ac5deb911548908025",
+            "af82",
+            "6291d657deec24024827e69c3abe01a30ce548a284743a445e3680d7db5ac3ac18ff9b538d16f290ae67f760984dc6594a7c15e9716ed28dc027beceea1ec40a"
+        }
+    }};
+
+    std::vector<raw_signature> signatures;
+    for (auto &current : vectors) {
+        raw_signature raw{ from_hex_array<32>(current.key), from_hex_array<64>(current.signature), from_hex(current.message) };
+
+        // libsodium derives the same key and signature
+        auto seed = from_hex_array<32>(current.secret);
+        std::array<uint8_t, crypto_sign_PUBLICKEYBYTES> pubkey;
+        std::array<uint8_t, crypto_sign_SECRETKEYBYTES> seckey;
+        std::array<uint8_t, crypto_sign_BYTES> sig;
+        crypto_sign_seed_keypair(pubkey.data(), seckey.data(), seed.data());
+        crypto_sign_detached(sig.data(), nullptr, raw.message.data(), raw.message.size(), seckey.data());
+        ASSERT_EQ(pubkey, raw.key);
+        ASSERT_EQ(sig, raw.sig);
+
+        signatures.push_back(raw);
+    }
+
+    // all of them are valid, in a batch and on their own
+    ASSERT_EQ(verify_batch(signatures), std::vector<bool>(signatures.size(), true));
+    ASSERT_EQ(verify_sodium(signatures), std::vector<bool>(signatures.size(), true));
+
+    // and are rejected for another message
+    for (auto &current : signatures) {
+        current.message.push_back(0x00);
+    }
+    ASSERT_EQ(verify_batch(signatures), std::vector<bool>(signatures.size(), false));
+    ASSERT_EQ(verify_batch(signatures), verify_sodium(signatures));
+}
+
+TEST(eddsa_batch_verifier, small_order)
+{
+    // the points we use really have order 8
+    for (auto &point : order_8_points) {
+        std::array<uint8_t, 32> multiple = point;
+        for (size_t i = 0; i < 3; ++i) {
+            ASSERT_NE(multiple, (std::array<uint8_t, 32>{ 0x01 }));
+            ASSERT_EQ(crypto_core_ed25519_add(multiple.data(), multiple.data(), multiple.data()), 0);
+        }
+        ASSERT_EQ(multiple, (std::array<uint8_t, 32>{ 0x01 }));
+    }
+
+    auto good = make_signer();
+    auto data = sign(good);
+    std::array<uint8_t, 32> pubkey;
+    std::copy(good.key.Q().data().begin() + 1, good.key.Q().data().end(), pubkey.begin());
+
+    raw_signature valid{ pubkey, signature_data(data.sig), { data.digest.begin(), data.digest.end() } };
+    std::vector<raw_signature> signatures{ valid };
+
+    // a point of small order as r, or as the key, is never accepted
+    for (auto &point : order_8_points) {
+        auto small_r = valid;
+        std::copy(point.begin(), point.end(), small_r.sig.begin());
+        signatures.push_back(small_r);
+
+        auto small_key = valid;
+        small_key.key = point;
+        signatures.push_back(small_key);
+    }
+
+    auto expected = std::vector<bool>(signatures.size(), false);
+    expected[0] = true;
+    ASSERT_EQ(verify_batch(signatures), expected);
+    ASSERT_EQ(verify_batch(signatures), verify_sodium(signatures));
+}
+
+TEST(eddsa_batch_verifier, mixed_torsion)
+{
+    // a secret scalar and its public key
+    std::array<uint8_t, 32> a;
+    std::array<uint8_t, 32> A;
+    crypto_core_ed25519_scalar_random(a.data());
+    ASSERT_EQ(crypto_scalarmult_ed25519_base_noclamp(A.data(), a.data()), 0);
+
+    // the same key, with a component of order 8 added
+    std::array<uint8_t, 32> mixed_A;
+    ASSERT_EQ(crypto_core_ed25519_add(mixed_A.data(), A.data(), order_8_points[0].data()), 0);
+
+    // a random nonce for every signature
+    auto nonce = [](std::array<uint8_t, 32> &r, std::array<uint8_t, 32> &R) {
+        crypto_core_ed25519_scalar_random(r.data());
+        return crypto_scalarmult_ed25519_base_noclamp(R.data(), r.data()) == 0;
+    };
+
+    std::array<uint8_t, 32> r;
+    std::array<uint8_t, 32> R;
+    std::array<uint8_t, 32> h;
+
+    // sign for the mixed key, until the torsion component does not cancel out
+    raw_signature mixed_key{ mixed_A, {}, { 0x00 } };
+    do {
+        ++mixed_key.message[0];
+        ASSERT_TRUE(nonce(r, R));
+        mixed_key.sig = sign_raw(a, r, R, mixed_A, mixed_key.message, h);
+    } while (h[0] % 8 == 0);
+
+    // sign with a component of order 8 added to r
+    raw_signature mixed_r{ A, {}, { 0x01 } };
+    std::array<uint8_t, 32> mixed_R;
+    ASSERT_TRUE(nonce(r, R));
+    ASSERT_EQ(crypto_core_ed25519_add(mixed_R.data(), R.data(), order_8_points[1].data()), 0);
+    mixed_r.sig = sign_raw(a, r, mixed_R, A, mixed_r.message, h);
+
+    // and a plain signature
+    raw_signature plain{ A, {}, { 0x02 } };
+    ASSERT_TRUE(nonce(r, R));
+    plain.sig = sign_raw(a, r, R, A, plain.message, h);
+
+    std::vector<raw_signature> signatures{ mixed_key, mixed_r, plain };
+
+    // libsodium rejects the mixed signatures, even though the cofactored equation holds
+    ASSERT_EQ(verify_sodium(signatures), (std::vector<bool>{ false, false, true }));
+    ASSERT_EQ(verify_batch(signatures), verify_sodium(signatures));
+
+    // sign for the mixed key again, until the torsion component does cancel out
+    raw_signature cancelled{ mixed_A, {}, { 0x03 } };
+    do {
+        ++cancelled.message[0];
+        ASSERT_TRUE(nonce(r, R));
+        cancelled.sig = sign_raw(a, r, R, mixed_A, cancelled.message, h);
+    } while (h[0] % 8 != 0);
+    signatures.push_back(cancelled);
+
+    // a damaged signature
+    auto damaged = plain;
+    damaged.message.push_back(0x00);
+    signatures.push_back(damaged);
+    ASSERT_EQ(verify_batch(signatures), verify_sodium(signatures));
+
+    // the same goes for keys that made enough signatures to get a table
+    for (uint8_t i = 0; i < 8; ++i) {
+        raw_signature valid{ A, {}, { 0x04, i } };
+        ASSERT_TRUE(nonce(r, R));
+        valid.sig = sign_raw(a, r, R, A, valid.message, h);
+        signatures.push_back(valid);
+
+        raw_signature mixed{ mixed_A, {}, { 0x05, i } };
+        ASSERT_TRUE(nonce(r, R));
+        mixed.sig = sign_raw(a, r, R, mixed_A, mixed.message, h);
+        signatures.push_back(mixed);
+    }
+    ASSERT_EQ(verify_batch(signatures), verify_sodium(signatures));
+}
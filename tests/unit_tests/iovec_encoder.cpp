@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <array>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "iovec_encoder.h"
+#include "vector_encoder.h"
+#include "packet.h"
+#include "../generate.h"
+
+
+namespace {
+
+    /**
+     *  Concatenate the data referred to by the buffers
+     */
+    std::vector<uint8_t> concatenate(const std::vector<iovec> &buffers)
+    {
+        std::vector<uint8_t> result;
+        for (auto &buffer : buffers) {
+            auto *data = static_cast<const uint8_t*>(buffer.iov_base);
+            result.insert(result.end(), data, data + buffer.iov_len);
+        }
+
+        return result;
+    }
+
+}
+
+TEST(iovec_encoder, bits_and_numbers)
+{
+    std::array<uint8_t, 4> blob{ 1, 2, 3, 4 };
+    pgp::iovec_encoder encoder{ 3 };
+
+    encoder.insert_bits(1, 1);
+    encoder.insert_bits(3, 0);
+    ASSERT_EQ(encoder.size(), 0);
+    encoder.push(uint8_t{ 0x0a });
+    encoder.push(uint16_t{ 0x1234 });
+    encoder.insert_blob(pgp::span<const uint8_t>{ blob });
+    encoder.insert_blob(pgp::span<const uint8_t>{ blob.data(), 2 });
+    encoder.insert_bits(2, 3);
+    encoder.flush();
+
+    ASSERT_EQ(encoder.size(), 10);
+
+    // the tail of the first blob is referenced, the rest is staged
+    auto buffers = encoder.buffers();
+    ASSERT_EQ(buffers.size(), 3);
+    ASSERT_EQ(buffers[1].iov_base, blob.data() + 1);
+    ASSERT_EQ(buffers[1].iov_len, 3);
+    ASSERT_EQ(concatenate(buffers), (std::vector<uint8_t>{ 0x8a, 0x12, 0x34, 1, 2, 3, 4, 1, 2, 0xc0 }));
+
+    encoder.insert_bits(4, 0xf);
+    ASSERT_THROW(encoder.push(uint8_t{ 0xff }), std::range_error);
+    ASSERT_THROW(encoder.insert_bits(5, 0), std::out_of_range);
+}
+
+TEST(iovec_encoder, packets)
+{
+    using namespace std::literals;
+
+    auto [key, public_data, secret_data] = tests::generate::eddsa::key();
+    pgp::user_id user{ "Anne Onymous <anonymous@example.org>"s };
+    pgp::user_id large{ std::string(70000, 'a') };
+
+    std::vector<pgp::packet> packets;
+    packets.emplace_back(pgp::in_place_type_t<pgp::secret_key>{}, key);
+    packets.emplace_back(pgp::in_place_type_t<pgp::user_id>{}, user);
+    packets.emplace_back(pgp::in_place_type_t<pgp::signature>{}, key, user, pgp::signature_subpacket_set{}, pgp::signature_subpacket_set{});
+    packets.emplace_back(pgp::in_place_type_t<pgp::user_id>{}, large);
+
+    pgp::iovec_encoder encoder;
+    std::vector<uint8_t> expected;
+    pgp::vector_encoder reference{ expected };
+    for (auto &packet : packets) {
+        packet.encode(encoder);
+        packet.encode(reference);
+    }
+
+    // the large user id is not copied
+    auto buffers = encoder.buffers();
+    auto &id = pgp::get<pgp::user_id>(packets.back().body()).id();
+    ASSERT_EQ(buffers.back().iov_base, id.data() + 1);
+
+    ASSERT_EQ(encoder.size(), expected.size());
+    ASSERT_EQ(concatenate(buffers), expected);
+
+    // write the buffers to a file in one go
+    auto *file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    auto written = writev(fileno(file), buffers.data(), static_cast<int>(buffers.size()));
+    ASSERT_EQ(static_cast<size_t>(written), expected.size());
+
+    std::vector<uint8_t> received(expected.size());
+    ASSERT_EQ(pread(fileno(file), received.data(), received.size(), 0), written);
+    ASSERT_EQ(received, expected);
+
+    std::fclose(file);
+}
+
+TEST(iovec_encoder, partial_body)
+{
+    std::vector<uint8_t> body(70000, 'a');
+    pgp::packet packet{ pgp::in_place_type_t<pgp::unknown_packet>{}, pgp::packet_tag::literal_data, body };
+
+    for (size_t chunk_size : { 512, 1024, 65536 }) {
+        pgp::iovec_encoder encoder;
+        std::vector<uint8_t> expected;
+        pgp::vector_encoder reference{ expected };
+
+        // a large body is written directly, only the final chunk is buffered
+        packet.encode(encoder, chunk_size);
+        packet.encode(reference, chunk_size);
+
+        // many small pieces, so whole chunks are collected in a buffer
+        pgp::partial_body_encoder<pgp::iovec_encoder> body_writer{ encoder, pgp::packet_tag::literal_data, chunk_size };
+        pgp::partial_body_encoder<decltype(reference)> body_reference{ reference, pgp::packet_tag::literal_data, chunk_size };
+        for (uint16_t i = 0; i < 3000; ++i) {
+            body_writer.push(i);
+            body_reference.push(i);
+        }
+        body_writer.flush();
+        body_reference.flush();
+
+        // the buffered chunks must not refer to reused memory
+        ASSERT_EQ(encoder.size(), expected.size());
+        ASSERT_EQ(concatenate(encoder.buffers()), expected);
+    }
+}
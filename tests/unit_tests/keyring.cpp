@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "keyring.h"
+#include "thread_pool.h"
+#include "range_encoder.h"
+#include "packet.h"
+#include "../failing_executor.h"
+#include "../generate.h"
+
+
+namespace {
+
+    /**
+     *  Create an encoded keyring with many packets
+     */
+    std::vector<uint8_t> create_keyring()
+    {
+        std::vector<pgp::packet> packets;
+        for (size_t i = 0; i < 50; ++i) {
+            auto [key, public_data, secret_data] = tests::generate::eddsa::key();
+            pgp::user_id user{ "user " + std::to_string(i) + " <user" + std::to_string(i) + "@example.org>" };
+
+            packets.emplace_back(pgp::in_place_type_t<pgp::secret_key>{}, key);
+            packets.emplace_back(pgp::in_place_type_t<pgp::user_id>{}, user);
+            packets.emplace_back(pgp::in_place_type_t<pgp::signature>{}, key, user, pgp::signature_subpacket_set{{
+                pgp::signature_subpacket::signature_creation_time{ 1234 },
+                pgp::signature_subpacket::key_flags{ 0x03 }
+            }}, pgp::signature_subpacket_set{});
+        }
+
+        size_t size = 0;
+        for (auto &packet : packets) {
+            size += packet.size();
+        }
+
+        std::vector<uint8_t> data(size);
+        pgp::range_encoder encoder{ data };
+        for (auto &packet : packets) {
+            packet.encode(encoder);
+        }
+
+        return data;
+    }
+
+#ifdef PGP_HAS_MEMORY_RESOURCE
+
+    /**
+     *  A resource keeping track of the memory in use
+     */
+    class counting_resource : public std::pmr::memory_resource
+    {
+        public:
+            size_t allocations  { 0 };
+            size_t in_use       { 0 };
+        private:
+            void *do_allocate(size_t bytes, size_t alignment) override
+            {
+                ++allocations;
+                in_use += bytes;
+                return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+            }
+
+            void do_deallocate(void *address, size_t bytes, size_t alignment) override
+            {
+                in_use -= bytes;
+                std::pmr::new_delete_resource()->deallocate(address, bytes, alignment);
+            }
+
+            bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+            {
+                return this == &other;
+            }
+    };
+
+#endif
+
+}
+
+TEST(keyring, decode_parallel)
+{
+    auto data = create_keyring();
+    auto expected = pgp::decode_keyring(data);
+    ASSERT_EQ(expected.size(), 150);
+
+    pgp::thread_pool pool{ 4 };
+    for (size_t batch_size : { 1, 100, 1000, 1000000 }) {
+        ASSERT_EQ(pgp::decode_keyring_parallel(data, pool, batch_size), expected);
+    }
+
+    ASSERT_TRUE(pgp::decode_keyring_parallel({}, pool).empty());
+}
+
+TEST(keyring, decode_parallel_errors)
+{
+    auto data = create_keyring();
+    pgp::thread_pool pool{ 4 };
+
+    // a truncated keyring fails to scan
+    auto truncated = data;
+    truncated.resize(truncated.size() - 1);
+    ASSERT_THROW(pgp::decode_keyring(truncated), std::out_of_range);
+    ASSERT_THROW(pgp::decode_keyring_parallel(truncated, pool, 100), std::out_of_range);
+
+    // an oversized curve identifier fails while decoding a body
+    auto invalid = data;
+    auto location = pgp::scan_packets(data)[3];
+    invalid[location.offset + location.header_size + 6] = 0xff;
+    ASSERT_THROW(pgp::decode_keyring(invalid), std::out_of_range);
+    ASSERT_THROW(pgp::decode_keyring_parallel(invalid, pool, 100), std::out_of_range);
+}
+
+TEST(keyring, decode_parallel_executor_error)
+{
+    auto data = create_keyring();
+
+    // the executor fails after accepting a few batches
+    tests::failing_executor executor{ 3 };
+    ASSERT_THROW(pgp::decode_keyring_parallel(data, executor, 100), std::runtime_error);
+
+    // the accepted batches were run before the error was raised
+    ASSERT_EQ(executor.accepted, 3);
+    ASSERT_EQ(executor.started, 3);
+}
+
+#ifdef PGP_HAS_MEMORY_RESOURCE
+
+TEST(keyring, decode_resource)
+{
+    auto data = create_keyring();
+    auto expected = pgp::decode_keyring(data);
+
+    counting_resource resource;
+    std::vector<pgp::packet> copied;
+
+    {
+        auto packets = pgp::decode_keyring(data, resource);
+        ASSERT_TRUE(std::equal(packets.begin(), packets.end(), expected.begin(), expected.end()));
+        ASSERT_GT(resource.allocations, 0);
+        ASSERT_GT(resource.in_use, 0);
+
+        // copies are made with the default resource again
+        auto in_use = resource.in_use;
+        copied.assign(packets.begin(), packets.end());
+        ASSERT_EQ(resource.in_use, in_use);
+
+        auto result = pgp::try_decode_keyring(data, resource);
+        ASSERT_TRUE(result);
+        ASSERT_TRUE(std::equal(result->begin(), result->end(), expected.begin(), expected.end()));
+    }
+
+    // all memory was given back to the resource
+    ASSERT_EQ(resource.in_use, 0);
+    ASSERT_EQ(copied, expected);
+
+    // nothing is allocated from the resource outside of decoding it
+    auto allocations = resource.allocations;
+    pgp::user_id user{ std::string(100, 'a') };
+    ASSERT_EQ(pgp::decode_keyring(data), expected);
+    ASSERT_EQ(resource.allocations, allocations);
+
+    // a monotonic resource releases everything at once
+    std::pmr::monotonic_buffer_resource arena{ &resource };
+    auto packets = pgp::decode_keyring(data, arena);
+    ASSERT_TRUE(std::equal(packets.begin(), packets.end(), expected.begin(), expected.end()));
+    ASSERT_GT(resource.in_use, 0);
+}
+
+#endif
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "mapped_keyring.h"
+#include "packet_view.h"
+#include "range_encoder.h"
+#include "packet.h"
+
+
+namespace {
+
+    /**
+     *  Write data to a temporary file
+     */
+    std::FILE *create_file(const std::vector<uint8_t> &data)
+    {
+        auto *file = std::tmpfile();
+        std::fwrite(data.data(), 1, data.size(), file);
+        std::fflush(file);
+        return file;
+    }
+
+}
+
+TEST(mapped_keyring, decode)
+{
+    using namespace std::literals;
+
+    std::vector<pgp::packet> packets;
+    packets.emplace_back(pgp::in_place_type_t<pgp::user_id>{}, "first user"s);
+    packets.emplace_back(pgp::in_place_type_t<pgp::user_id>{}, std::string(5000, 'x'));
+
+    std::vector<uint8_t> data(packets[0].size() + packets[1].size());
+    pgp::range_encoder encoder{ data };
+    packets[0].encode(encoder);
+    packets[1].encode(encoder);
+
+    auto *file = create_file(data);
+    ASSERT_NE(file, nullptr);
+
+    pgp::mapped_keyring keyring{ fileno(file), pgp::mapped_keyring::access_pattern::random };
+    std::fclose(file);
+
+    ASSERT_EQ(keyring.size(), data.size());
+    ASSERT_EQ(keyring.data(), pgp::span<const uint8_t>{ data });
+
+    // decode owning packets
+    auto parser = keyring.parser();
+    ASSERT_EQ(pgp::packet{ parser }, packets[0]);
+    ASSERT_EQ(pgp::packet{ parser }, packets[1]);
+    ASSERT_TRUE(parser.empty());
+
+    // views borrow from the mapping, also after moving it
+    pgp::mapped_keyring moved{ std::move(keyring) };
+    moved.advise(pgp::mapped_keyring::access_pattern::sequential);
+
+    auto view_parser = moved.parser();
+    pgp::packet_view view{ view_parser };
+    ASSERT_EQ(view.data().data(), moved.data().data() + 2);
+    ASSERT_EQ(static_cast<pgp::packet>(view), packets[0]);
+    ASSERT_EQ(keyring.size(), 0);
+}
+
+TEST(mapped_keyring, empty)
+{
+    auto *file = create_file({});
+    ASSERT_NE(file, nullptr);
+
+    pgp::mapped_keyring keyring{ fileno(file) };
+    std::fclose(file);
+
+    ASSERT_EQ(keyring.size(), 0);
+    ASSERT_TRUE(keyring.parser().empty());
+}
+
+TEST(mapped_keyring, missing_file)
+{
+    ASSERT_THROW(pgp::mapped_keyring{ std::string{ "/nonexistent/keyring.gpg" } }, std::system_error);
+}
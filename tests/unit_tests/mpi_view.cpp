@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include "mpi_view.h"
+#include "multiprecision_integer.h"
+#include "range_encoder.h"
+#include "decoder.h"
+#include "../generate.h"
+
+
+TEST(mpi_view, decode)
+{
+    const std::array<uint8_t, 5> data{ 0, 21, 0x1f, 0x13, 0x37 };
+
+    pgp::decoder decoder{ data };
+    pgp::mpi_view view{ decoder };
+
+    ASSERT_TRUE(decoder.empty());
+    ASSERT_EQ(view.size(), data.size());
+    ASSERT_EQ(view.data().data(), data.data() + 2);
+    ASSERT_EQ(static_cast<pgp::multiprecision_integer>(view), pgp::multiprecision_integer{ pgp::span(data.data() + 2, 3) });
+}
+
+TEST(mpi_view, encode_decode)
+{
+    auto integer = tests::generate::mpi();
+
+    std::vector<uint8_t> data(integer.size());
+    pgp::range_encoder encoder{ data };
+    integer.encode(encoder);
+
+    pgp::decoder decoder{ data };
+    pgp::mpi_view view{ decoder };
+    ASSERT_EQ(view.data(), integer.data());
+
+    std::vector<uint8_t> data2(view.size());
+    pgp::range_encoder encoder2{ data2 };
+    view.encode(encoder2);
+    ASSERT_EQ(data, data2);
+}
+
+TEST(mpi_view, truncated)
+{
+    const std::array<uint8_t, 4> data{ 0, 21, 0x1f, 0x13 };
+
+    pgp::decoder decoder{ data };
+    ASSERT_THROW(pgp::mpi_view{ decoder }, std::out_of_range);
+}
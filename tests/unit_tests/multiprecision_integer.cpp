@@ -1,4 +1,7 @@
 #include <algorithm>
+#include <array>
+#include <functional>
+#include <type_traits>
 #include <gtest/gtest.h>
 #include "util/vector.h"
 #include "multiprecision_integer.h"
@@ -62,8 +65,8 @@ TEST(multiprecision_integer, vector_constructor)
         auto nonzero_it = std::find_if(data.begin(), data.end(), [](uint8_t x) { return x != 0; });
         size_t zero_bytes = std::distance(data.begin(), nonzero_it);
 
-        pgp::multiprecision_integer mi{data};
-        ASSERT_EQ(mi, pgp::multiprecision_integer{pgp::span<const uint8_t>{data}});
+        pgp::secret_multiprecision_integer mi{data};
+        ASSERT_EQ(mi, pgp::secret_multiprecision_integer{pgp::span<const uint8_t>{data}});
         // 2 for size prefix; zero bytes should be stripped
         ASSERT_EQ(mi.size(), 2 + data.size() - zero_bytes);
     };
@@ -74,6 +77,29 @@ TEST(multiprecision_integer, vector_constructor)
     test_for_vector(pgp::vector<uint8_t>{std::initializer_list<uint8_t>{0, 0, 0xff, 4, 5 ,6, 7}});
 }
 
+TEST(multiprecision_integer, storage_conversion)
+{
+    static_assert(!std::is_convertible_v<pgp::secret_multiprecision_integer, pgp::multiprecision_integer>);
+    static_assert(std::is_constructible_v<pgp::multiprecision_integer, pgp::secret_multiprecision_integer>);
+    static_assert(std::is_convertible_v<pgp::multiprecision_integer, pgp::secret_multiprecision_integer>);
+
+    // a decoded integer keeps its bit count when converted
+    std::array<uint8_t, 5> data{0, 20, 1, 2, 3};
+    pgp::decoder decoder{data};
+    pgp::multiprecision_integer decoded{decoder};
+
+    pgp::secret_multiprecision_integer secret = decoded;
+    pgp::multiprecision_integer converted{secret};
+
+    ASSERT_EQ(secret.data(), decoded.data());
+    ASSERT_EQ(converted, decoded);
+
+    std::array<uint8_t, 5> encoded{};
+    pgp::range_encoder encoder{encoded};
+    secret.encode(encoder);
+    ASSERT_EQ(encoded, data);
+}
+
 TEST(multiprecision_integer, computed_bits)
 {
     std::array<uint8_t, 3> data;
@@ -114,3 +140,46 @@ TEST(multiprecision_integer, zero_stripping)
         ASSERT_EQ(pgp::uint16{decoder}, 8 * (data.size() - i));
     }
 }
+
+namespace {
+
+    template <class integer_t>
+    bool stored_inline(const integer_t &integer)
+    {
+        auto *begin = reinterpret_cast<const uint8_t*>(&integer);
+        return std::less_equal<const uint8_t*>{}(begin, integer.data().data()) &&
+               std::less<const uint8_t*>{}(integer.data().data(), begin + sizeof(integer));
+    }
+
+    template <class integer_t>
+    void test_storage(bool inline_storage)
+    {
+        std::array<uint8_t, pgp::multiprecision_inline_size> small{};
+        std::array<uint8_t, 512> large{};
+        small.fill(0x5a);
+        large.fill(0xa5);
+
+        integer_t point{ pgp::span<const uint8_t>{ small } };
+        integer_t modulus{ pgp::span<const uint8_t>{ large } };
+
+        ASSERT_EQ(stored_inline(point), inline_storage);
+        ASSERT_FALSE(stored_inline(modulus));
+        ASSERT_TRUE(std::equal(small.begin(), small.end(), point.data().begin(), point.data().end()));
+        ASSERT_TRUE(std::equal(large.begin(), large.end(), modulus.data().begin(), modulus.data().end()));
+
+        integer_t moved{ std::move(point) };
+        ASSERT_EQ(stored_inline(moved), inline_storage);
+        ASSERT_EQ(moved.size(), small.size() + 2);
+    }
+
+}
+
+TEST(multiprecision_integer, inline_storage)
+{
+    // secret data is only ever kept in the secure arena, so
+    // the integer itself is not locked or unlocked per object
+    static_assert(pgp::uses_secure_allocator<std::vector<uint8_t, pgp::allocator<uint8_t>>>::value);
+
+    test_storage<pgp::multiprecision_integer>(true);
+    test_storage<pgp::secret_multiprecision_integer>(false);
+}
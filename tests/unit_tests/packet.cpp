@@ -62,6 +62,55 @@ TEST(packet, decode_fail)
     ASSERT_THROW(pgp::packet{decoder}, std::runtime_error);
 }
 
+TEST(packet, unknown_passthrough)
+{
+    const std::vector<uint8_t> data{
+        0xb0, 0x02, 0x01, 0x02,                                 // trust packet
+        0xd1, 0x03, 0x01, 0x02, 0x03,                           // user attribute packet
+        0x98, 0x04, 0x05, 0x01, 0x02, 0x03,                     // version 5 public key
+        0x98, 0x08, 0x04, 0x00, 0x00, 0x00, 0x01, 0x63,         // public key with an unknown algorithm
+        0xaa, 0xbb,
+        0x88, 0x03, 0x03, 0x01, 0x02,                           // version 3 signature
+        0x88, 0x0d, 0x04, 0x13, 0x63, 0x08, 0x00, 0x00,         // signature with an unknown algorithm
+        0x00, 0x00, 0x12, 0x34, 0x01, 0x02, 0x03
+    };
+
+    std::vector<pgp::packet> packets;
+    pgp::decoder decoder{data};
+    while (!decoder.empty()) {
+        packets.emplace_back(decoder);
+    }
+
+    ASSERT_EQ(packets.size(), 6);
+    ASSERT_EQ(packets[0].tag(), pgp::packet_tag::trust_packet);
+    ASSERT_EQ(packets[1].tag(), pgp::packet_tag::user_attribute);
+    ASSERT_EQ(packets[2].tag(), pgp::packet_tag::public_key);
+    ASSERT_EQ(packets[4].tag(), pgp::packet_tag::signature);
+
+    for (size_t i : { 0, 1, 2, 4 }) {
+        ASSERT_TRUE(pgp::holds_alternative<pgp::unknown_packet>(packets[i].body()));
+    }
+
+    auto &key = pgp::get<pgp::public_key>(packets[3].body());
+    ASSERT_EQ(pgp::get<pgp::unknown_key>(key.key()).size(), 2);
+
+    auto &sig = pgp::get<pgp::signature>(packets[5].body());
+    ASSERT_EQ(pgp::get<pgp::unknown_signature>(sig.data()).size(), 3);
+
+    size_t size = 0;
+    for (auto &packet : packets) {
+        size += packet.size();
+    }
+    ASSERT_EQ(size, data.size());
+
+    std::vector<uint8_t> encoded(size);
+    pgp::range_encoder encoder{encoded};
+    for (auto &packet : packets) {
+        packet.encode(encoder);
+    }
+    ASSERT_EQ(encoded, data);
+}
+
 TEST(packet, equality)
 {
     using namespace std::literals;
@@ -74,3 +123,67 @@ TEST(packet, equality)
     ASSERT_NE(p1, p2);
     ASSERT_NE(p1, p3);
 }
+
+TEST(packet, partial_body_length)
+{
+    auto test_for_size = [](size_t size, size_t chunk_size) {
+        std::vector<uint8_t> body(size, 'a');
+        pgp::packet packet{pgp::in_place_type_t<pgp::unknown_packet>(), pgp::packet_tag::literal_data, body};
+
+        // every chunk needs a length octet, plus the header and final length
+        std::vector<uint8_t> data(size + size / chunk_size + 6);
+        pgp::range_encoder encoder{data};
+        packet.encode(encoder, chunk_size);
+        data.resize(encoder.size());
+
+        pgp::decoder decoder{data};
+        pgp::packet packet2{decoder};
+
+        ASSERT_TRUE(decoder.empty());
+        ASSERT_EQ(packet, packet2);
+    };
+
+    for (size_t chunk_size : { 512, 4096, 65536 }) {
+        test_for_size(0, chunk_size);
+        test_for_size(chunk_size - 1, chunk_size);
+        test_for_size(chunk_size, chunk_size);
+        test_for_size(chunk_size + 1, chunk_size);
+        test_for_size(chunk_size * 5 + 17, chunk_size);
+    }
+
+    std::vector<uint8_t> body(10, 'a');
+    pgp::packet packet{pgp::in_place_type_t<pgp::unknown_packet>(), pgp::packet_tag::literal_data, body};
+    std::vector<uint8_t> data(32);
+
+    for (size_t chunk_size : std::array<size_t, 4>{ 0, 256, 1000, size_t{ 1 } << 31 }) {
+        pgp::range_encoder encoder{data};
+        ASSERT_THROW(packet.encode(encoder, chunk_size), std::range_error);
+    }
+
+    // only data packets may be split up in chunks
+    pgp::packet user{pgp::in_place_type_t<pgp::user_id>(), std::string(10, 'a')};
+    pgp::range_encoder encoder{data};
+    ASSERT_THROW(user.encode(encoder, 512), std::invalid_argument);
+}
+
+TEST(packet, partial_body_length_decode)
+{
+    // literal data split in chunks of two, one and three bytes
+    std::array<uint8_t, 10> data{ 0xcb, 0xe1, 'a', 'b', 0xe0, 'c', 0x03, 'd', 'e', 'f' };
+    pgp::decoder decoder{data};
+    pgp::packet packet{decoder};
+
+    ASSERT_TRUE(decoder.empty());
+    ASSERT_EQ(packet.tag(), pgp::packet_tag::literal_data);
+    auto body = pgp::get<pgp::unknown_packet>(packet.body()).data();
+    ASSERT_EQ(std::string(body.begin(), body.end()), "abcdef");
+
+    // the final chunk is missing data
+    pgp::decoder truncated{pgp::span<const uint8_t>{data}.first(9)};
+    ASSERT_THROW(pgp::packet{truncated}, std::out_of_range);
+
+    // a user id may not be split up in chunks
+    data[0] = 0xcd;
+    pgp::decoder user{data};
+    ASSERT_THROW(pgp::packet{user}, std::runtime_error);
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "packet_reader.h"
+#include "range_encoder.h"
+#include "decoder.h"
+#include "packet.h"
+#include "../generate.h"
+
+
+namespace {
+
+    /**
+     *  Read all packets from a reader
+     */
+    std::vector<pgp::packet> read_packets(pgp::packet_reader &reader)
+    {
+        std::vector<pgp::packet> result;
+        while (auto packet = reader.next()) {
+            result.push_back(std::move(*packet));
+        }
+        return result;
+    }
+
+}
+
+TEST(packet_reader, callback_source)
+{
+    auto packets = tests::generate::packets();
+
+    // add a packet larger than most buffers
+    packets.emplace_back(pgp::in_place_type_t<pgp::user_id>{}, std::string(70000, 'c'));
+
+    auto data = tests::generate::encode_packets(packets);
+
+    // try a number of chunk and buffer sizes, so packets straddle the buffer boundaries
+    for (size_t chunk_size : { 1, 3, 64, 4096 }) {
+        for (size_t buffer_size : { 1, 16, 1000, 200000 }) {
+            size_t offset = 0;
+            pgp::packet_reader reader{ [&](pgp::span<uint8_t> buffer) {
+                size_t count = std::min({ chunk_size, buffer.size(), data.size() - offset });
+                std::copy_n(data.begin() + offset, count, buffer.begin());
+                offset += count;
+                return count;
+            }, buffer_size };
+
+            ASSERT_EQ(read_packets(reader), packets);
+            ASSERT_FALSE(reader.next());
+        }
+    }
+}
+
+TEST(packet_reader, bounded_buffer)
+{
+    using namespace std::literals;
+
+    // many small packets should never grow the buffer
+    std::vector<pgp::packet> packets;
+    for (size_t i = 0; i < 1000; ++i) {
+        packets.emplace_back(pgp::in_place_type_t<pgp::user_id>{}, "user "s + std::to_string(i));
+    }
+
+    std::istringstream stream{ [&packets]() {
+        auto data = tests::generate::encode_packets(packets);
+        return std::string(data.begin(), data.end());
+    }() };
+
+    pgp::packet_reader reader{ stream, 64 };
+    ASSERT_EQ(read_packets(reader), packets);
+    ASSERT_EQ(reader.buffer_size(), 64);
+}
+
+TEST(packet_reader, stream_source)
+{
+    auto packets = tests::generate::packets();
+    auto data = tests::generate::encode_packets(packets);
+
+    std::istringstream stream{ std::string(data.begin(), data.end()) };
+    pgp::packet_reader reader{ stream, 1024 };
+
+    ASSERT_EQ(read_packets(reader), packets);
+}
+
+TEST(packet_reader, fd_source)
+{
+    auto packets = tests::generate::packets();
+    auto data = tests::generate::encode_packets(packets);
+
+    auto *file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(std::fwrite(data.data(), 1, data.size(), file), data.size());
+    std::fflush(file);
+    std::rewind(file);
+
+    pgp::packet_reader reader{ fileno(file), 4096 };
+    ASSERT_EQ(read_packets(reader), packets);
+
+    std::fclose(file);
+}
+
+TEST(packet_reader, partial_body_length)
+{
+    auto packets = tests::generate::packets();
+    packets.emplace_back(pgp::in_place_type_t<pgp::unknown_packet>{}, pgp::packet_tag::literal_data, std::vector<uint8_t>(70000, 'd'));
+
+    // encode the data packets with their bodies split in small chunks
+    std::vector<uint8_t> data(tests::generate::encode_packets(packets).size() * 2);
+    pgp::range_encoder encoder{ data };
+    for (auto &packet : packets) {
+        // only data packets may be split up in chunks
+        if (pgp::packet_tag_allows_partial_length(packet.tag())) {
+            packet.encode(encoder, 512);
+        } else {
+            packet.encode(encoder);
+        }
+    }
+    data.resize(encoder.size());
+
+    for (size_t buffer_size : { 1, 600, 200000 }) {
+        std::istringstream stream{ std::string(data.begin(), data.end()) };
+        pgp::packet_reader reader{ stream, buffer_size };
+
+        ASSERT_EQ(read_packets(reader), packets);
+    }
+
+    // cut the input off in the middle of a chunk
+    data.resize(data.size() - 1000);
+    std::istringstream stream{ std::string(data.begin(), data.end()) };
+    pgp::packet_reader reader{ stream, 1024 };
+
+    ASSERT_THROW(read_packets(reader), std::out_of_range);
+}
+
+TEST(packet_reader, truncated)
+{
+    auto packets = tests::generate::packets();
+    auto data = tests::generate::encode_packets(packets);
+    data.resize(data.size() - 1);
+
+    std::istringstream stream{ std::string(data.begin(), data.end()) };
+    pgp::packet_reader reader{ stream, 1024 };
+
+    for (size_t i = 0; i + 1 < packets.size(); ++i) {
+        ASSERT_EQ(*reader.next(), packets[i]);
+    }
+
+    ASSERT_THROW(reader.next(), std::out_of_range);
+}
+
+TEST(packet_reader, empty)
+{
+    std::istringstream stream;
+    pgp::packet_reader reader{ stream };
+
+    ASSERT_FALSE(reader.next());
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "packet_scanner.h"
+#include "range_encoder.h"
+#include "decoder.h"
+#include "packet.h"
+#include "../generate.h"
+
+
+TEST(packet_scanner, locations)
+{
+    using namespace std::literals;
+
+    auto [key, public_data, secret_data] = tests::generate::eddsa::key();
+    pgp::user_id user{ "Anne Onymous <anonymous@example.org>"s };
+
+    std::vector<pgp::packet> packets;
+    packets.emplace_back(pgp::in_place_type_t<pgp::secret_key>{}, key);
+    packets.emplace_back(pgp::in_place_type_t<pgp::user_id>{}, user);
+    packets.emplace_back(pgp::in_place_type_t<pgp::signature>{}, key, user, pgp::signature_subpacket_set{}, pgp::signature_subpacket_set{});
+    packets.emplace_back(pgp::in_place_type_t<pgp::user_id>{}, std::string(70000, 'a'));
+    packets.emplace_back(pgp::in_place_type_t<pgp::unknown_packet>{}, pgp::packet_tag::literal_data, std::vector<uint8_t>(3000, 'b'));
+
+    // encode the last (data) packet using partial body lengths
+    std::vector<uint8_t> data(80000);
+    pgp::range_encoder encoder{ data };
+    for (size_t i = 0; i + 1 < packets.size(); ++i) {
+        packets[i].encode(encoder);
+    }
+    packets.back().encode(encoder, 512);
+    data.resize(encoder.size());
+
+    auto locations = pgp::scan_packets(data);
+    ASSERT_EQ(locations.size(), packets.size());
+
+    uint64_t offset = 0;
+    for (size_t i = 0; i < packets.size(); ++i) {
+        ASSERT_EQ(locations[i].offset, offset);
+        ASSERT_EQ(locations[i].tag, packets[i].tag());
+        offset += locations[i].size();
+
+        // each location can be decoded by itself
+        pgp::decoder decoder{ pgp::span<const uint8_t>{ data }.subspan(locations[i].offset, locations[i].size()) };
+        ASSERT_EQ(pgp::packet{ decoder }, packets[i]);
+        ASSERT_TRUE(decoder.empty());
+    }
+    ASSERT_EQ(offset, data.size());
+
+    // the old-format packets know their exact size
+    ASSERT_EQ(locations[1].format, pgp::packet_format::old_format);
+    ASSERT_EQ(locations[1].header_size, 2);
+    ASSERT_EQ(locations[1].body_size, user.size());
+    ASSERT_EQ(locations[3].header_size, 5);
+
+    // the body of the partial packet includes the chunk lengths
+    ASSERT_EQ(locations[4].format, pgp::packet_format::new_format);
+    ASSERT_EQ(locations[4].header_size, 2);
+    ASSERT_GT(locations[4].body_size, 3000);
+}
+
+TEST(packet_scanner, indeterminate_length)
+{
+    // an old-format user id without a length, extending to the end
+    std::array<uint8_t, 4> data{ 0xb7, 'a', 'b', 'c' };
+
+    auto locations = pgp::scan_packets(data);
+    ASSERT_EQ(locations.size(), 1);
+    ASSERT_EQ(locations[0].header_size, 1);
+    ASSERT_EQ(locations[0].body_size, 3);
+    ASSERT_EQ(locations[0].tag, pgp::packet_tag::user_id);
+}
+
+TEST(packet_scanner, invalid)
+{
+    std::array<uint8_t, 4> truncated{ 0xb4, 0x05, 'a', 'b' };
+    ASSERT_THROW(pgp::scan_packets(truncated), std::out_of_range);
+
+    std::array<uint8_t, 2> invalid{ 0x34, 0x00 };
+    ASSERT_THROW(pgp::scan_packets(invalid), std::runtime_error);
+
+    ASSERT_TRUE(pgp::scan_packets({}).empty());
+}
+
+TEST(packet_scanner, format_description)
+{
+    ASSERT_EQ(pgp::packet_format_description(pgp::packet_format::old_format), "old packet format");
+    ASSERT_EQ(pgp::packet_format_description(pgp::packet_format::new_format), "new packet format");
+    ASSERT_EQ(pgp::packet_format_description(static_cast<pgp::packet_format>(2)), "unknown packet format");
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "packet_view.h"
+#include "decoder.h"
+#include "packet.h"
+#include "../generate.h"
+
+
+TEST(packet_view, convert)
+{
+    auto packets = tests::generate::packets();
+    auto data = tests::generate::encode_packets(packets);
+
+    pgp::decoder decoder{ data };
+    for (auto &packet : packets) {
+        pgp::packet_view view{ decoder };
+
+        ASSERT_EQ(view.tag(), packet.tag());
+        ASSERT_EQ(static_cast<pgp::packet>(view), packet);
+    }
+
+    ASSERT_TRUE(decoder.empty());
+}
+
+TEST(packet_view, borrows_data)
+{
+    auto packets = tests::generate::packets();
+    auto data = tests::generate::encode_packets(packets);
+
+    pgp::decoder decoder{ data };
+    while (!decoder.empty()) {
+        pgp::packet_view view{ decoder };
+
+        // the body must point into the original buffer
+        ASSERT_GE(view.data().data(), data.data());
+        ASSERT_LE(view.data().data() + view.data().size(), data.data() + data.size());
+    }
+}
+
+TEST(packet_view, key_view)
+{
+    auto packets = tests::generate::packets();
+    auto data = tests::generate::encode_packets(packets);
+
+    pgp::decoder decoder{ data };
+    for (auto &packet : packets) {
+        pgp::packet_view view{ decoder };
+
+        pgp::visit([&view](auto &key) {
+            using key_t = std::decay_t<decltype(key)>;
+
+            if constexpr (std::is_same_v<key_t, pgp::secret_key> || std::is_same_v<key_t, pgp::public_key> || std::is_same_v<key_t, pgp::public_subkey>) {
+                auto &key_view = pgp::get<pgp::key_view>(view.body());
+
+                ASSERT_EQ(key_view.tag(), key.tag());
+                ASSERT_EQ(key_view.creation_time(), key.creation_time());
+                ASSERT_EQ(key_view.algorithm(), key.algorithm());
+                ASSERT_EQ(key_view.fingerprint(), key.fingerprint());
+                ASSERT_EQ(key_view.key_id(), key.key_id());
+                ASSERT_EQ(static_cast<key_t>(key_view), key);
+                ASSERT_EQ(key_view.secret_data().empty(), (!std::is_same_v<key_t, pgp::secret_key>));
+            }
+        }, packet.body());
+    }
+}
+
+TEST(packet_view, field_views)
+{
+    using namespace std::literals;
+
+    auto packets = tests::generate::packets();
+    auto data = tests::generate::encode_packets(packets);
+
+    pgp::decoder decoder{ data };
+    pgp::packet_view secret_key{ decoder };
+    pgp::packet_view user_id{ decoder };
+    pgp::packet_view signature{ decoder };
+    pgp::packet_view rsa_key{ decoder };
+
+    // the secret key is an eddsa key with a curve and point
+    auto &eddsa_view = pgp::get<pgp::key_view>(secret_key.body());
+    auto &eddsa_key = pgp::get<pgp::secret_key::eddsa_key_t>(pgp::get<pgp::secret_key>(packets[0].body()).key());
+    ASSERT_EQ(eddsa_view.curve(), eddsa_key.curve().data());
+    ASSERT_EQ(eddsa_view.integers().size(), 1);
+    ASSERT_EQ(eddsa_view.integers()[0].data(), eddsa_key.Q().data());
+
+    // the user id refers to the encoded string
+    auto &id_view = pgp::get<pgp::user_id_view>(user_id.body());
+    ASSERT_EQ(std::string(id_view.id().data(), id_view.id().size()), "Anne Onymous <anonymous@example.org>"s);
+    ASSERT_EQ(static_cast<pgp::user_id>(id_view), pgp::get<pgp::user_id>(packets[1].body()));
+
+    // the signature has the eddsa r and s values
+    auto &sig_view = pgp::get<pgp::signature_view>(signature.body());
+    auto &sig = pgp::get<pgp::signature>(packets[2].body());
+    ASSERT_EQ(sig_view.type(), sig.type());
+    ASSERT_EQ(sig_view.public_key_algorithm(), sig.public_key_algorithm());
+    ASSERT_EQ(sig_view.hashing_algorithm(), sig.hashing_algorithm());
+    ASSERT_EQ(sig_view.hash_prefix(), sig.hash_prefix());
+    ASSERT_EQ(sig_view.integers().size(), 2);
+    ASSERT_EQ(static_cast<pgp::multiprecision_integer>(sig_view.integers()[0]), pgp::get<pgp::eddsa_signature>(sig.data()).r());
+    ASSERT_EQ(static_cast<pgp::signature>(sig_view), sig);
+
+    // the rsa key has n and e
+    auto &rsa_view = pgp::get<pgp::key_view>(rsa_key.body());
+    ASSERT_TRUE(rsa_view.curve().empty());
+    ASSERT_EQ(rsa_view.integers().size(), 2);
+}
+
+TEST(packet_view, truncated)
+{
+    auto packets = tests::generate::packets();
+    auto data = tests::generate::encode_packets(packets);
+    data.resize(data.size() - 1);
+
+    pgp::decoder decoder{ data };
+    for (size_t i = 0; i + 1 < packets.size(); ++i) {
+        pgp::packet_view view{ decoder };
+    }
+
+    ASSERT_THROW(pgp::packet_view{ decoder }, std::out_of_range);
+}
+
+TEST(packet_view, partial_body_length)
+{
+    std::array<uint8_t, 10> data{ 0xcb, 0xe1, 'a', 'b', 0xe0, 'c', 0x03, 'd', 'e', 'f' };
+    pgp::decoder decoder{ data };
+
+    ASSERT_THROW(pgp::packet_view{ decoder }, std::runtime_error);
+}
+
+TEST(packet_view, unknown_key_algorithm)
+{
+    // version 4, creation time, algorithm 99 and some raw key material
+    const std::vector<uint8_t> data{ 0x04, 0x00, 0x00, 0x00, 0x01, 0x63, 0xaa, 0xbb };
+
+    pgp::key_view public_view{ pgp::packet_tag::public_key, data };
+    pgp::key_view secret_view{ pgp::packet_tag::secret_key, data };
+
+    // the public key matches its owning counterpart
+    pgp::decoder decoder{ data };
+    ASSERT_EQ(public_view.fingerprint(), pgp::public_key{ decoder }.fingerprint());
+
+    // the secret data cannot be separated, so it is not hashed
+    ASSERT_THROW(secret_view.fingerprint(), std::runtime_error);
+    ASSERT_THROW(secret_view.key_id(), std::runtime_error);
+}
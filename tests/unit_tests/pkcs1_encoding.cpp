@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <vector>
+#include "pkcs1_encoding.h"
+#include "unsupported_algorithm.h"
+
+
+TEST(pkcs1_encoding, encode)
+{
+    std::array<uint8_t, 32> digest;
+    digest.fill(0xaa);
+
+    auto prefix = pgp::digest_info_prefix(pgp::hash_algorithm::sha256);
+    auto message = pgp::pkcs1_encode(pgp::hash_algorithm::sha256, digest, 128);
+
+    // the padding comes first
+    ASSERT_EQ(message.size(), 128);
+    ASSERT_EQ(message[0], 0x00);
+    ASSERT_EQ(message[1], 0x01);
+    ASSERT_EQ(std::count(message.begin() + 2, message.end() - digest.size() - prefix.size() - 1, 0xff), 128 - digest.size() - prefix.size() - 3);
+    ASSERT_EQ(message[128 - digest.size() - prefix.size() - 1], 0x00);
+
+    // followed by the prefix and the digest
+    ASSERT_TRUE(std::equal(prefix.begin(), prefix.end(), message.end() - digest.size() - prefix.size()));
+    ASSERT_TRUE(std::equal(digest.begin(), digest.end(), message.end() - digest.size()));
+}
+
+TEST(pkcs1_encoding, too_short)
+{
+    std::array<uint8_t, 32> digest{};
+
+    // there must be at least eight bytes of padding
+    ASSERT_NO_THROW(pgp::pkcs1_encode(pgp::hash_algorithm::sha256, digest, 19 + 32 + 11));
+    ASSERT_THROW(pgp::pkcs1_encode(pgp::hash_algorithm::sha256, digest, 19 + 32 + 10), std::invalid_argument);
+}
+
+TEST(pkcs1_encoding, unsupported)
+{
+    std::array<uint8_t, 16> digest{};
+
+    ASSERT_THROW(pgp::digest_info_prefix(pgp::hash_algorithm::md5), pgp::unsupported_algorithm);
+    ASSERT_THROW(pgp::pkcs1_encode(pgp::hash_algorithm::md5, digest, 128), pgp::unsupported_algorithm);
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+#include "random_generator.h"
+
+
+namespace {
+
+    std::vector<uint8_t> generate(size_t size)
+    {
+        std::vector<uint8_t> result(size);
+        pgp::random_generator::instance().GenerateBlock(result.data(), result.size());
+        return result;
+    }
+
+}
+
+TEST(random_generator, per_thread)
+{
+    auto &generator = pgp::random_generator::instance();
+    pgp::random_generator *other = nullptr;
+
+    // every thread gets its own generator
+    std::thread{ [&other]() { other = &pgp::random_generator::instance(); } }.join();
+
+    ASSERT_EQ(&generator, &pgp::random_generator::instance());
+    ASSERT_NE(&generator, other);
+    ASSERT_FALSE(generator.deterministic());
+    ASSERT_TRUE(generator.CanIncorporateEntropy());
+}
+
+TEST(random_generator, output)
+{
+    // consecutive output differs, also across refills and reseeds
+    auto first = generate(1000);
+    auto second = generate(pgp::random_generator::reseed_interval + 1000);
+
+    ASSERT_NE(first, std::vector<uint8_t>(first.size()));
+    ASSERT_NE(std::vector<uint8_t>(second.begin(), second.begin() + first.size()), first);
+    ASSERT_NE(std::vector<uint8_t>(second.end() - first.size(), second.end()), first);
+}
+
+TEST(random_generator, deterministic)
+{
+    auto &generator = pgp::random_generator::instance();
+    std::array<uint8_t, pgp::random_generator::seed_size> seed{ 1, 2, 3 };
+
+    // generate data from a fixed seed
+    generator.seed(seed);
+    ASSERT_TRUE(generator.deterministic());
+    auto first = generate(100);
+    auto more = generate(pgp::random_generator::reseed_interval + 1000);
+
+    // the same seed gives the same output, regardless of how it is requested
+    generator.seed(seed);
+    auto second = generate(40);
+    auto rest = generate(60);
+    second.insert(second.end(), rest.begin(), rest.end());
+    ASSERT_EQ(first, second);
+
+    // mixing in data changes the output deterministically
+    generator.seed(seed);
+    generator.IncorporateEntropy(seed.data(), seed.size());
+    auto mixed = generate(100);
+    ASSERT_NE(first, mixed);
+    generator.seed(seed);
+    generator.IncorporateEntropy(seed.data(), seed.size());
+    ASSERT_EQ(mixed, generate(100));
+
+    // a deterministic generator is not reseeded automatically
+    generator.seed(seed);
+    generate(100);
+    ASSERT_EQ(more, generate(more.size()));
+
+    // until it is asked to
+    generator.seed(seed);
+    generator.reseed();
+    ASSERT_FALSE(generator.deterministic());
+    ASSERT_NE(first, generate(100));
+}
+
+TEST(random_generator, invalid_seed)
+{
+    std::array<uint8_t, pgp::random_generator::seed_size - 1> seed{};
+    ASSERT_THROW(pgp::random_generator::instance().seed(seed), std::invalid_argument);
+    ASSERT_FALSE(pgp::random_generator::instance().deterministic());
+}
+
+TEST(random_generator, fork)
+{
+    // make sure the generator is seeded before forking
+    generate(32);
+
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+
+    // generate data in a child process
+    auto child = fork();
+    ASSERT_NE(child, -1);
+    if (child == 0) {
+        auto data = generate(32);
+        auto written = write(fds[1], data.data(), data.size());
+        _exit(written == static_cast<ssize_t>(data.size()) ? 0 : 1);
+    }
+
+    // and the same amount in the parent
+    auto parent_data = generate(32);
+    std::vector<uint8_t> child_data(32);
+    ASSERT_EQ(read(fds[0], child_data.data(), child_data.size()), static_cast<ssize_t>(child_data.size()));
+
+    int status;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    close(fds[0]);
+    close(fds[1]);
+
+    // the child must not repeat the output of its parent
+    ASSERT_NE(parent_data, child_data);
+}
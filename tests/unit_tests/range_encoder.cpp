@@ -1,5 +1,8 @@
 #include <limits>
 #include <array>
+#include <list>
+#include <string>
+#include <vector>
 #include <stdexcept>
 #include <gtest/gtest.h>
 #include "range_encoder.h"
@@ -95,6 +98,40 @@ TEST(range_encoder, push_iterators)
     ASSERT_THROW(encoder.push(input.begin(), input.begin() + 2), std::out_of_range);
 }
 
+TEST(range_encoder, push_contiguous)
+{
+    static_assert(util::is_contiguous_byte_iterator_v<const uint8_t*>);
+    static_assert(util::is_contiguous_byte_iterator_v<std::vector<uint8_t>::const_iterator>);
+    static_assert(util::is_contiguous_byte_iterator_v<pgp::vector<uint8_t>::iterator>);
+    static_assert(util::is_contiguous_byte_iterator_v<std::string::iterator>);
+    static_assert(!util::is_contiguous_byte_iterator_v<std::vector<uint16_t>::iterator>);
+    static_assert(!util::is_contiguous_byte_iterator_v<std::vector<bool>::iterator>);
+    static_assert(!util::is_contiguous_byte_iterator_v<std::list<uint8_t>::iterator>);
+
+    std::vector<uint8_t> bytes{ 1, 2, 3 };
+    std::string characters{ "abc" };
+    std::list<uint8_t> list{ 4, 5 };
+    std::vector<uint16_t> numbers{ 0x0607 };
+    std::array<uint8_t, 10> data{};
+
+    // both the contiguous and the element-wise ranges encode the same
+    pgp::range_encoder encoder{ data };
+    encoder.push(bytes.begin(), bytes.end());
+    encoder.push(characters.begin(), characters.end());
+    encoder.push(list.begin(), list.end());
+    encoder.push(numbers.begin(), numbers.end());
+    ASSERT_EQ(encoder.size(), 10);
+    ASSERT_EQ(data, (std::array<uint8_t, 10>{ 1, 2, 3, 'a', 'b', 'c', 4, 5, 6, 7 }));
+
+    // queued bits are merged into the first byte
+    std::array<uint8_t, 2> merged{};
+    pgp::range_encoder bits{ merged };
+    bits.insert_bits(4, 0xf);
+    ASSERT_THROW(bits.push(bytes.begin(), bytes.end()), std::out_of_range);
+    bits.push(bytes.begin(), bytes.begin() + 2);
+    ASSERT_EQ(merged, (std::array<uint8_t, 2>{ 0xf1, 2 }));
+}
+
 TEST(range_encoder, insert_blob)
 {
     std::array<uint8_t, 4> input{10, 20, 30, 50};
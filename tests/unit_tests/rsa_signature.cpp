@@ -26,10 +26,10 @@ namespace {
                 pgp::multiprecision_integer{ private_key.GetPublicExponent()    }
             },
             seckey{
-                pgp::multiprecision_integer{ private_key.GetPrivateExponent()                           },
-                pgp::multiprecision_integer{ private_key.GetPrime1()                                    },
-                pgp::multiprecision_integer{ private_key.GetPrime2()                                    },
-                pgp::multiprecision_integer{ private_key.GetMultiplicativeInverseOfPrime2ModPrime1()    }
+                pgp::secret_multiprecision_integer{ private_key.GetPrivateExponent()                           },
+                pgp::secret_multiprecision_integer{ private_key.GetPrime2()                                    },
+                pgp::secret_multiprecision_integer{ private_key.GetPrime1()                                    },
+                pgp::secret_multiprecision_integer{ private_key.GetMultiplicativeInverseOfPrime2ModPrime1()    }
             }
         {}
     };
@@ -78,6 +78,38 @@ TEST(rsa_signature, test)
     ));
 }
 
+TEST(rsa_signature, crt)
+{
+    inputs inps{generate_inputs(2048)};
+
+    // the exponents for the chinese remainder theorem are derived from the key
+    auto d = static_cast<CryptoPP::Integer>(inps.seckey.d());
+    auto p = static_cast<CryptoPP::Integer>(inps.seckey.p());
+    auto q = static_cast<CryptoPP::Integer>(inps.seckey.q());
+    ASSERT_EQ(static_cast<CryptoPP::Integer>(inps.seckey.dp()), d % (p - CryptoPP::Integer::One()));
+    ASSERT_EQ(static_cast<CryptoPP::Integer>(inps.seckey.dq()), d % (q - CryptoPP::Integer::One()));
+
+    // a key where u is not the inverse of p mod q, so the CRT cannot be used
+    pgp::rsa_secret_key swapped{ inps.seckey.d(), inps.seckey.q(), inps.seckey.p(), inps.seckey.u() };
+    ASSERT_TRUE(swapped.dp().data().empty());
+    ASSERT_TRUE(swapped.dq().data().empty());
+
+    pgp::secret_key sk{
+        1554106568,
+        pgp::key_algorithm::rsa_encrypt_or_sign,
+        pgp::in_place_type_t<pgp::secret_key::rsa_key_t>(),
+        std::make_tuple(inps.pubkey),
+        std::make_tuple(swapped)
+    };
+
+    // it still makes the same signature, just without the CRT
+    pgp::rsa_signature::encoder_t sig_encoder{sk};
+    sig_encoder.insert_blob(pgp::span<const uint8_t>{inps.message});
+    pgp::rsa_signature sig{util::make_from_tuple<pgp::rsa_signature>(sig_encoder.finalize())};
+
+    ASSERT_EQ(sig, *inps.sig);
+}
+
 TEST(rsa_signature, encode_decode)
 {
     inputs inps{generate_inputs(2048)};
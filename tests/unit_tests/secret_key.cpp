@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "../key_template.h"
 #include "secret_key.h"
+#include "public_key.h"
+#include "signing_context.h"
 #include "range_encoder.h"
 #include "decoder.h"
 
@@ -9,10 +11,10 @@ TEST(secret_key, constructor)
 {
     auto n = tests::generate::mpi();
     auto e = tests::generate::mpi();
-    auto d = tests::generate::mpi();
-    auto p = tests::generate::mpi();
-    auto q = tests::generate::mpi();
-    auto u = tests::generate::mpi();
+    pgp::secret_multiprecision_integer d{ tests::generate::mpi() };
+    pgp::secret_multiprecision_integer p{ tests::generate::mpi() };
+    pgp::secret_multiprecision_integer q{ tests::generate::mpi() };
+    pgp::secret_multiprecision_integer u{ tests::generate::mpi() };
 
     pgp::secret_key k{
         1234,
@@ -39,7 +41,7 @@ TEST(secret_key, encode_decode)
     auto q = tests::generate::mpi();
     auto g = tests::generate::mpi();
     auto y = tests::generate::mpi();
-    auto x = tests::generate::mpi();
+    pgp::secret_multiprecision_integer x{ tests::generate::mpi() };
 
     pgp::secret_key k{
         5678,
@@ -65,10 +67,10 @@ TEST(secret_key, equality)
 {
     auto n = tests::generate::mpi();
     auto e = tests::generate::mpi();
-    auto d = tests::generate::mpi();
-    auto p = tests::generate::mpi();
-    auto q = tests::generate::mpi();
-    auto u = tests::generate::mpi();
+    pgp::secret_multiprecision_integer d{ tests::generate::mpi() };
+    pgp::secret_multiprecision_integer p{ tests::generate::mpi() };
+    pgp::secret_multiprecision_integer q{ tests::generate::mpi() };
+    pgp::secret_multiprecision_integer u{ tests::generate::mpi() };
 
     pgp::secret_key k{
         1234,
@@ -117,7 +119,7 @@ TEST(secret_key, fingerprint)
     pgp::multiprecision_integer  Q        {qdata};
     pgp::hash_algorithm          hashalgo {pgp::hash_algorithm::sha1};
     pgp::symmetric_key_algorithm keyalgo  {pgp::symmetric_key_algorithm::aes256};
-    pgp::multiprecision_integer  kparam   {kdata};
+    pgp::secret_multiprecision_integer kparam{kdata};
 
     pgp::secret_key k{
         1554103729,
@@ -129,3 +131,27 @@ TEST(secret_key, fingerprint)
     std::array<uint8_t, 8> expected = {0x1b, 0x98, 0x5c, 0x78, 0x29, 0xa5, 0xcc, 0x81};
     ASSERT_EQ(k.key_id(), expected);
 }
+
+TEST(secret_key, unknown_algorithm)
+{
+    // version 4, creation time, algorithm 99 and some raw key material
+    const std::vector<uint8_t> data{ 0x04, 0x00, 0x00, 0x00, 0x01, 0x63, 0xaa, 0xbb };
+
+    pgp::decoder public_decoder{ data };
+    pgp::public_key public_key{ public_decoder };
+    pgp::decoder secret_decoder{ data };
+    pgp::secret_key secret_key{ secret_decoder };
+
+    ASSERT_TRUE(pgp::holds_alternative<pgp::unknown_key>(secret_key.key()));
+
+    // the public key only holds public data, so it can be fingerprinted
+    ASSERT_NO_THROW(public_key.fingerprint());
+
+    // but the secret key may hold secret data in the same blob
+    ASSERT_THROW(secret_key.fingerprint(), std::runtime_error);
+    ASSERT_THROW(secret_key.key_id(), std::runtime_error);
+
+    // and cannot be used for signing either
+    pgp::signing_context context{ secret_key };
+    ASSERT_EQ(context.key_hash(), nullptr);
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <vector>
+#include <sys/resource.h>
+#include "secure_arena.h"
+#include "util/vector.h"
+
+
+TEST(secure_arena, reuse)
+{
+    pgp::secure_arena arena{ pgp::secure_arena::region_size };
+    ASSERT_EQ(arena.locked(), 0);
+
+    // chunks are zero-initialized
+    auto *chunk = static_cast<uint8_t*>(arena.allocate(32));
+    ASSERT_NE(chunk, nullptr);
+    ASSERT_EQ(arena.locked(), pgp::secure_arena::region_size);
+    ASSERT_TRUE(std::all_of(chunk, chunk + 32, [](uint8_t value) { return value == 0; }));
+
+    // a released chunk is wiped before it is handed out again
+    std::memset(chunk, 0xff, 32);
+    ASSERT_TRUE(arena.deallocate(chunk, 32));
+    arena.wipe();
+    ASSERT_TRUE(std::all_of(chunk, chunk + 32, [](uint8_t value) { return value == 0; }));
+
+    auto *reused = arena.allocate(20);
+    ASSERT_EQ(reused, chunk);
+    ASSERT_TRUE(arena.deallocate(reused, 20));
+
+    // batches are wiped without asking for it
+    std::vector<void*> chunks;
+    for (size_t i = 0; i < pgp::secure_arena::wipe_batch * 2; ++i) {
+        chunks.push_back(arena.allocate(64));
+        std::memset(chunks.back(), 0xff, 64);
+    }
+    for (auto *chunk : chunks) {
+        ASSERT_TRUE(arena.deallocate(chunk, 64));
+    }
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        auto *chunk = static_cast<uint8_t*>(arena.allocate(64));
+        ASSERT_TRUE(std::all_of(chunk, chunk + 64, [](uint8_t value) { return value == 0; }));
+    }
+
+    // memory of another allocator is not taken back
+    uint8_t other[16];
+    ASSERT_FALSE(arena.deallocate(other, sizeof other));
+}
+
+TEST(secure_arena, budget)
+{
+    pgp::secure_arena arena{ pgp::secure_arena::region_size * 2 };
+    ASSERT_EQ(arena.budget(), pgp::secure_arena::region_size * 2);
+
+    // large allocations are not served
+    ASSERT_EQ(arena.allocate(pgp::secure_arena::max_chunk_size + 1), nullptr);
+
+    // all chunks are distinct, until the budget runs out
+    std::set<void*> chunks;
+    while (auto *chunk = arena.allocate(pgp::secure_arena::max_chunk_size)) {
+        ASSERT_TRUE(chunks.insert(chunk).second);
+    }
+
+    ASSERT_EQ(chunks.size(), pgp::secure_arena::region_size * 2 / pgp::secure_arena::max_chunk_size);
+    ASSERT_EQ(arena.locked(), arena.budget());
+
+    // smaller chunks cannot be carved either
+    ASSERT_EQ(arena.allocate(16), nullptr);
+}
+
+TEST(secure_arena, release)
+{
+    constexpr size_t per_region = pgp::secure_arena::region_size / pgp::secure_arena::max_chunk_size;
+    pgp::secure_arena arena{ pgp::secure_arena::region_size * 3 };
+
+    // fill up all three regions
+    std::vector<void*> chunks;
+    while (auto *chunk = arena.allocate(pgp::secure_arena::max_chunk_size)) {
+        chunks.push_back(chunk);
+    }
+    ASSERT_EQ(chunks.size(), per_region * 3);
+    ASSERT_EQ(arena.locked(), arena.budget());
+
+    // releasing part of the first region keeps it
+    ASSERT_TRUE(arena.deallocate(chunks[0], pgp::secure_arena::max_chunk_size));
+    ASSERT_EQ(arena.locked(), arena.budget());
+
+    // but once it is no longer used, it is unlocked
+    for (size_t i = 1; i < per_region; ++i) {
+        ASSERT_TRUE(arena.deallocate(chunks[i], pgp::secure_arena::max_chunk_size));
+    }
+    ASSERT_EQ(arena.locked(), pgp::secure_arena::region_size * 2);
+
+    // so there is room for another region
+    for (size_t i = 0; i < per_region; ++i) {
+        auto *chunk = static_cast<uint8_t*>(arena.allocate(pgp::secure_arena::max_chunk_size));
+        ASSERT_NE(chunk, nullptr);
+        ASSERT_TRUE(std::all_of(chunk, chunk + pgp::secure_arena::max_chunk_size, [](uint8_t value) { return value == 0; }));
+        chunks[i] = chunk;
+    }
+    ASSERT_EQ(arena.locked(), arena.budget());
+    ASSERT_EQ(arena.allocate(16), nullptr);
+
+    // the region being carved from is kept, even when unused
+    for (auto *chunk : chunks) {
+        ASSERT_TRUE(arena.deallocate(chunk, pgp::secure_arena::max_chunk_size));
+    }
+    ASSERT_EQ(arena.locked(), pgp::secure_arena::region_size);
+}
+
+TEST(secure_arena, release_current)
+{
+    constexpr size_t per_region = pgp::secure_arena::region_size / pgp::secure_arena::max_chunk_size;
+    pgp::secure_arena arena{ pgp::secure_arena::region_size };
+
+    // fill up the region, and stop using all of it
+    std::vector<void*> chunks;
+    for (size_t i = 0; i < per_region; ++i) {
+        chunks.push_back(arena.allocate(pgp::secure_arena::max_chunk_size));
+        ASSERT_NE(chunks.back(), nullptr);
+    }
+    for (auto *chunk : chunks) {
+        ASSERT_TRUE(arena.deallocate(chunk, pgp::secure_arena::max_chunk_size));
+    }
+    ASSERT_EQ(arena.locked(), pgp::secure_arena::region_size);
+
+    // a chunk of another size needs a new region, the unused
+    // one is given back first, so it fits within the budget
+    auto *chunk = arena.allocate(16);
+    ASSERT_NE(chunk, nullptr);
+    ASSERT_EQ(arena.locked(), pgp::secure_arena::region_size);
+    ASSERT_TRUE(arena.deallocate(chunk, 16));
+}
+
+TEST(secure_arena, default_budget)
+{
+    // leave room for memory locked outside of the arena
+    rlimit limit{};
+    ASSERT_EQ(getrlimit(RLIMIT_MEMLOCK, &limit), 0);
+    if (limit.rlim_cur != RLIM_INFINITY) {
+        ASSERT_LE(pgp::secure_arena{}.budget(), limit.rlim_cur / 2);
+    }
+}
+
+TEST(secure_arena, allocator)
+{
+    // secure vectors work regardless of where the memory comes from
+    pgp::vector<uint8_t> small;
+    pgp::vector<uint8_t> large;
+    small.resize(100, 0x12);
+    large.resize(100000, 0x34);
+
+    ASSERT_TRUE(std::all_of(small.begin(), small.end(), [](uint8_t value) { return value == 0x12; }));
+    ASSERT_TRUE(std::all_of(large.begin(), large.end(), [](uint8_t value) { return value == 0x34; }));
+
+    small = large;
+    ASSERT_EQ(small, large);
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <cryptopp/osrng.h>
 #include <cryptopp/rsa.h>
 #include "signature.h"
 #include "../device_random_engine.h"
@@ -12,7 +13,7 @@ namespace {
     {
         auto curve = pgp::curve_oid::ed25519();
         auto Q = pgp::multiprecision_integer{std::array<uint8_t, 8>{97, 34, 135, 227, 159, 215, 93, 229}};
-        auto k = pgp::multiprecision_integer{std::array<uint8_t, 8>{228, 159, 246, 23, 20, 155, 206, 156}};
+        auto k = pgp::secret_multiprecision_integer{std::array<uint8_t, 8>{228, 159, 246, 23, 20, 155, 206, 156}};
 
         return Key{
             12345678,
@@ -27,7 +28,7 @@ namespace {
     {
         auto curve = pgp::curve_oid::curve_25519();
         auto Q = pgp::multiprecision_integer{std::array<uint8_t, 8>{205, 117, 106, 55, 92, 162, 221, 6}};
-        auto k = pgp::multiprecision_integer{std::array<uint8_t, 8>{225, 138, 163, 90, 177, 224, 61, 100}};
+        auto k = pgp::secret_multiprecision_integer{std::array<uint8_t, 8>{225, 138, 163, 90, 177, 224, 61, 100}};
 
         return Key{
             987654321,
@@ -48,10 +49,10 @@ namespace {
         pgp::multiprecision_integer n{ private_key.GetModulus()         };
         pgp::multiprecision_integer e{ private_key.GetPublicExponent()  };
 
-        pgp::multiprecision_integer d{ private_key.GetPrivateExponent()                         };
-        pgp::multiprecision_integer p{ private_key.GetPrime1()                                  };
-        pgp::multiprecision_integer q{ private_key.GetPrime2()                                  };
-        pgp::multiprecision_integer u{ private_key.GetMultiplicativeInverseOfPrime2ModPrime1()  };
+        pgp::secret_multiprecision_integer d{ private_key.GetPrivateExponent()                          };
+        pgp::secret_multiprecision_integer p{ private_key.GetPrime2()                                   };
+        pgp::secret_multiprecision_integer q{ private_key.GetPrime1()                                   };
+        pgp::secret_multiprecision_integer u{ private_key.GetMultiplicativeInverseOfPrime2ModPrime1()   };
 
         return Key{
             987654321,
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include "signing_context.h"
+#include "verify.h"
+#include "../generate.h"
+
+
+namespace {
+
+    pgp::signature_subpacket_set subpackets()
+    {
+        return pgp::signature_subpacket_set{{
+            pgp::signature_subpacket::signature_creation_time{ 1554106568 },
+            pgp::signature_subpacket::key_flags{ 0x03 }
+        }};
+    }
+
+    void certification_test(const pgp::secret_key &key, bool deterministic)
+    {
+        using namespace std::literals;
+
+        pgp::signing_context context{ key };
+        ASSERT_EQ(context.algorithm(), key.algorithm());
+
+        // certify a number of user ids with the same context
+        for (size_t i = 0; i < 5; ++i) {
+            pgp::user_id user{ "User " + std::to_string(i) + " <user@example.com>" };
+            pgp::signature sig{ context, user, subpackets(), {} };
+
+            ASSERT_TRUE(pgp::verify(sig, key, pgp::user_id_certification{ key, user }));
+
+            // the signature is the same as one made without the context
+            if (deterministic) {
+                ASSERT_EQ(sig, (pgp::signature{ key, user, subpackets(), {} }));
+            }
+        }
+    }
+}
+
+TEST(signing_context, certification)
+{
+    certification_test(tests::generate::eddsa_key(), true);
+    certification_test(tests::generate::ecdsa_key(), false);
+    certification_test(tests::generate::rsa_key(), true);
+}
+
+TEST(signing_context, key_binding)
+{
+    auto primary = tests::generate::rsa_key();
+    auto subkey = tests::generate::eddsa_key<pgp::secret_subkey>();
+
+    pgp::signing_context primary_context{ primary };
+    pgp::signing_context subkey_context{ subkey };
+
+    pgp::signature subkey_binding{ primary_context, subkey, subpackets(), {} };
+    pgp::signature primary_binding{ subkey_context, primary, subpackets(), {} };
+
+    ASSERT_TRUE(pgp::verify(subkey_binding, primary, pgp::key_binding{ primary, subkey }));
+    ASSERT_TRUE(pgp::verify(primary_binding, subkey, pgp::key_binding{ primary, subkey }));
+}
+
+TEST(signing_context, threads)
+{
+    using namespace std::literals;
+
+    auto key = tests::generate::ecdsa_key();
+    pgp::signing_context context{ key };
+    pgp::user_id user{ "Alice <alice@example.com>"s };
+
+    // sign from a few threads at once, using copies of the context
+    std::vector<std::thread> threads;
+    std::vector<uint8_t> results(4);
+    for (size_t i = 0; i < results.size(); ++i) {
+        threads.emplace_back([context, &key, &user, &result = results[i]]() {
+            result = true;
+            for (size_t j = 0; j < 10; ++j) {
+                pgp::signature sig{ context, user, subpackets(), {} };
+                result &= pgp::verify(sig, key, pgp::user_id_certification{ key, user });
+            }
+        });
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(results, std::vector<uint8_t>(results.size(), true));
+}
+
+TEST(signing_context, own_key)
+{
+    using namespace std::literals;
+
+    pgp::user_id user{ "Alice <alice@example.com>"s };
+    auto subkey = tests::generate::eddsa_key<pgp::secret_subkey>();
+
+    // the context keeps its own copy of the key
+    auto key = std::make_unique<pgp::secret_key>(tests::generate::eddsa_key());
+    pgp::signing_context context{ *key };
+    auto expected = *key;
+    key.reset();
+
+    ASSERT_TRUE(pgp::holds_alternative<pgp::secret_key>(context.key()));
+    ASSERT_EQ(pgp::get<pgp::secret_key>(context.key()), expected);
+
+    // and signs with it
+    pgp::signature certification{ context, user, subpackets(), {} };
+    pgp::signature binding{ context, subkey, subpackets(), {} };
+    ASSERT_TRUE(pgp::verify(certification, expected, pgp::user_id_certification{ expected, user }));
+    ASSERT_TRUE(pgp::verify(binding, expected, pgp::key_binding{ expected, subkey }));
+
+    // a subkey cannot certify user ids
+    pgp::signing_context subkey_context{ subkey };
+    ASSERT_THROW((pgp::signature{ subkey_context, user, subpackets(), {} }), std::invalid_argument);
+}
+
+TEST(signing_context, unsupported)
+{
+    using namespace std::literals;
+
+    pgp::secret_key key{
+        1554106568,
+        pgp::key_algorithm::elgamal_encrypt_only,
+        pgp::in_place_type_t<pgp::secret_key::elgamal_key_t>(),
+        std::make_tuple(
+            pgp::multiprecision_integer{ std::array<uint8_t, 3>{ 1, 2, 3 } },
+            pgp::multiprecision_integer{ std::array<uint8_t, 3>{ 4, 5, 6 } },
+            pgp::multiprecision_integer{ std::array<uint8_t, 3>{ 7, 8, 9 } }
+        ),
+        std::make_tuple(pgp::secret_multiprecision_integer{ std::array<uint8_t, 3>{ 1, 2, 3 } })
+    };
+    pgp::user_id user{ "Alice <alice@example.com>"s };
+
+    // the context can be made, but we cannot sign with it
+    pgp::signing_context context{ key };
+    ASSERT_THROW((pgp::signature{ context, user, subpackets(), {} }), std::runtime_error);
+}
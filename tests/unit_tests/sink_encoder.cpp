@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "sink_encoder.h"
+#include "packet.h"
+#include "../generate.h"
+
+
+TEST(sink_encoder, callback_sink)
+{
+    auto packets = tests::generate::packets();
+
+    // add a packet larger than most buffers
+    packets.emplace_back(pgp::in_place_type_t<pgp::user_id>{}, std::string(70000, 'c'));
+
+    auto expected = tests::generate::encode_packets(packets);
+
+    // try a number of buffer sizes, so data straddles the buffer boundaries
+    for (size_t buffer_size : { 1, 7, 1000, 200000 }) {
+        std::vector<uint8_t> data;
+        size_t writes = 0;
+
+        {
+            pgp::sink_encoder encoder{ [&](pgp::span<const uint8_t> chunk) {
+                data.insert(data.end(), chunk.begin(), chunk.end());
+                ++writes;
+            }, buffer_size };
+
+            for (auto &packet : packets) {
+                packet.encode(encoder);
+            }
+
+            ASSERT_EQ(encoder.size(), expected.size());
+            encoder.flush();
+        }
+
+        ASSERT_EQ(data, expected);
+
+        // a buffer holding everything needs just a single write
+        if (buffer_size > expected.size()) {
+            ASSERT_EQ(writes, 1);
+        }
+    }
+}
+
+TEST(sink_encoder, stream_sink)
+{
+    auto packets = tests::generate::packets();
+    auto expected = tests::generate::encode_packets(packets);
+
+    std::ostringstream stream;
+    {
+        // the destructor flushes the data
+        pgp::sink_encoder encoder{ stream, 1024 };
+        for (auto &packet : packets) {
+            packet.encode(encoder);
+        }
+    }
+
+    ASSERT_EQ(stream.str(), std::string(expected.begin(), expected.end()));
+}
+
+TEST(sink_encoder, fd_sink)
+{
+    auto packets = tests::generate::packets();
+    auto expected = tests::generate::encode_packets(packets);
+
+    auto *file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+
+    pgp::sink_encoder encoder{ fileno(file), 4096 };
+    for (auto &packet : packets) {
+        packet.encode(encoder);
+    }
+    encoder.flush();
+
+    std::vector<uint8_t> data(expected.size() + 1);
+    std::rewind(file);
+    ASSERT_EQ(std::fread(data.data(), 1, data.size(), file), expected.size());
+    data.resize(expected.size());
+    ASSERT_EQ(data, expected);
+
+    std::fclose(file);
+}
+
+TEST(sink_encoder, partial_bits)
+{
+    std::vector<uint8_t> data;
+    pgp::sink_encoder encoder{ [&](pgp::span<const uint8_t> chunk) {
+        data.insert(data.end(), chunk.begin(), chunk.end());
+    }, 2 };
+
+    encoder.insert_bits(1, 1);
+    encoder.insert_bits(3, 0);
+    encoder.push(uint8_t{ 0x0a });
+    encoder.push(uint16_t{ 0x1234 });
+    encoder.insert_bits(2, 3);
+    ASSERT_THROW(encoder.push(uint8_t{ 0xff }), std::range_error);
+    encoder.flush();
+
+    ASSERT_EQ(encoder.size(), 4);
+    ASSERT_EQ(data, (std::vector<uint8_t>{ 0x8a, 0x12, 0x34, 0xc0 }));
+}
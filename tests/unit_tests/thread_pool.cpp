@@ -0,0 +1,27 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include "thread_pool.h"
+
+
+TEST(thread_pool, execute)
+{
+    std::atomic<size_t> counter{ 0 };
+
+    {
+        pgp::thread_pool pool{ 3 };
+        ASSERT_EQ(pool.size(), 3);
+
+        for (size_t i = 0; i < 1000; ++i) {
+            pool.execute([&counter]() { ++counter; });
+        }
+    }
+
+    // the destructor waits for all tasks
+    ASSERT_EQ(counter, 1000);
+}
+
+TEST(thread_pool, minimum_size)
+{
+    pgp::thread_pool pool{ 0 };
+    ASSERT_EQ(pool.size(), 1);
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "try_decode.h"
+#include "keyring.h"
+#include "range_encoder.h"
+#include "expected_number.h"
+#include "packet.h"
+#include "../generate.h"
+
+
+namespace {
+
+    /**
+     *  Check that decoding with and without exceptions agrees
+     */
+    void check_consistent(const std::vector<uint8_t> &data)
+    {
+        auto result = pgp::try_decode_keyring(data);
+
+        try {
+            auto packets = pgp::decode_keyring(data);
+            ASSERT_TRUE(result);
+            ASSERT_EQ(*result, packets);
+        } catch (const std::out_of_range&) {
+            ASSERT_FALSE(result);
+            ASSERT_EQ(result.error().kind(), pgp::decode_error_kind::truncated);
+        } catch (const std::range_error&) {
+            ASSERT_FALSE(result);
+            ASSERT_EQ(result.error().kind(), pgp::decode_error_kind::unexpected_value);
+        } catch (const std::runtime_error&) {
+            ASSERT_FALSE(result);
+            ASSERT_NE(result.error().kind(), pgp::decode_error_kind::truncated);
+            ASSERT_NE(result.error().kind(), pgp::decode_error_kind::unexpected_value);
+        }
+    }
+
+}
+
+TEST(try_decode, packet)
+{
+    auto packets = tests::generate::packets();
+    auto data = tests::generate::encode_packets(packets);
+
+    pgp::decoder parser{ data };
+    for (auto &packet : packets) {
+        auto result = pgp::try_decode<pgp::packet>(parser);
+        ASSERT_TRUE(result);
+        ASSERT_EQ(*result, packet);
+    }
+
+    ASSERT_TRUE(parser.empty());
+}
+
+TEST(try_decode, errors)
+{
+    auto packets = tests::generate::packets();
+    auto data = tests::generate::encode_packets(packets);
+
+    // a failed decode leaves the parser untouched
+    {
+        std::vector<uint8_t> truncated{ data.begin(), data.begin() + packets[0].size() - 1 };
+        pgp::decoder parser{ truncated };
+
+        auto result = pgp::try_decode<pgp::packet>(parser);
+        ASSERT_FALSE(result);
+        ASSERT_EQ(result.error().kind(), pgp::decode_error_kind::truncated);
+        ASSERT_EQ(parser.size(), truncated.size());
+    }
+
+    // a header without the required bit
+    {
+        auto invalid = data;
+        invalid[0] &= 0x7f;
+        ASSERT_EQ(pgp::try_decode_keyring(invalid).error(), pgp::decode_error(pgp::decode_error_kind::invalid_header, 0));
+    }
+
+    // an unexpected fixed number
+    {
+        std::array<uint8_t, 2> invalid{ 4, 3 };
+        pgp::decoder parser{ invalid };
+        ASSERT_TRUE((pgp::try_decode<pgp::expected_number<uint8_t, 4>>(parser)));
+
+        auto result = pgp::try_decode<pgp::expected_number<uint8_t, 4>>(parser);
+        ASSERT_EQ(result.error(), pgp::decode_error(pgp::decode_error_kind::unexpected_value, 1));
+    }
+
+    // the offset points into the right packet
+    {
+        std::vector<uint8_t> truncated{ data.begin(), data.end() - 1 };
+        auto result = pgp::try_decode_keyring(truncated);
+        ASSERT_FALSE(result);
+        ASSERT_GE(result.error().offset(), packets[0].size() + packets[1].size());
+    }
+}
+
+TEST(try_decode, consistent)
+{
+    auto data = tests::generate::encode_packets(tests::generate::packets());
+    check_consistent(data);
+
+    // every truncated keyring
+    for (size_t size = 0; size < data.size(); ++size) {
+        check_consistent({ data.begin(), data.begin() + size });
+    }
+
+    // every single corrupted octet
+    for (size_t i = 0; i < data.size(); ++i) {
+        for (uint8_t mask : { 0x01, 0x40, 0x80, 0xff }) {
+            auto corrupted = data;
+            corrupted[i] ^= mask;
+            check_consistent(corrupted);
+        }
+    }
+}
+
+TEST(try_decode, partial_body_length)
+{
+    auto packets = tests::generate::packets();
+    packets.emplace_back(pgp::in_place_type_t<pgp::unknown_packet>{}, pgp::packet_tag::literal_data, std::vector<uint8_t>(2000, 'a'));
+
+    std::vector<uint8_t> data(tests::generate::encode_packets(packets).size() * 2);
+    pgp::range_encoder encoder{ data };
+    for (auto &packet : packets) {
+        // only data packets may be split up in chunks
+        if (pgp::packet_tag_allows_partial_length(packet.tag())) {
+            packet.encode(encoder, 512);
+        } else {
+            packet.encode(encoder);
+        }
+    }
+    data.resize(encoder.size());
+
+    auto result = pgp::try_decode_keyring(data);
+    ASSERT_TRUE(result);
+    ASSERT_EQ(*result, packets);
+
+    data.resize(data.size() - 100);
+    result = pgp::try_decode_keyring(data);
+    ASSERT_FALSE(result);
+    ASSERT_EQ(result.error().kind(), pgp::decode_error_kind::truncated);
+}
+
+TEST(try_decode, error_description)
+{
+    ASSERT_EQ(pgp::decode_error_kind_description(pgp::decode_error_kind::none), "no error");
+    ASSERT_EQ(pgp::decode_error_kind_description(pgp::decode_error_kind::truncated), "not enough data available");
+    ASSERT_EQ(pgp::decode_error_kind_description(pgp::decode_error_kind::unsupported), "unsupported encoding");
+    ASSERT_EQ(pgp::decode_error_kind_description(static_cast<pgp::decode_error_kind>(6)), "unknown decode error");
+}
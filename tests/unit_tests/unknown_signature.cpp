@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <array>
 #include <vector>
 #include "unknown_signature.h"
 #include "range_encoder.h"
@@ -8,18 +9,37 @@
 TEST(unknown_signature, test)
 {
     pgp::unknown_signature sig;
-    ASSERT_THROW(sig.size(), std::runtime_error);
+    ASSERT_EQ(sig.size(), 0);
 
     std::vector<uint8_t> v;
     pgp::range_encoder encoder{v};
-    ASSERT_THROW(sig.encode(encoder), std::runtime_error);
+    sig.encode(encoder);
+    ASSERT_EQ(encoder.size(), 0);
 
     pgp::decoder decoder{v};
     pgp::unknown_signature sig2{decoder};
+    ASSERT_EQ(sig, sig2);
+}
+
+TEST(unknown_signature, raw_data)
+{
+    std::array<uint8_t, 5> data{ 0x00, 0x08, 0xff, 0x12, 0x34 };
+    pgp::decoder decoder{data};
+    pgp::unknown_signature sig{decoder};
+    ASSERT_TRUE(decoder.empty());
+    ASSERT_EQ(sig.size(), data.size());
+
+    std::vector<uint8_t> encoded(sig.size());
+    pgp::range_encoder encoder{encoded};
+    sig.encode(encoder);
+    ASSERT_TRUE(std::equal(data.begin(), data.end(), encoded.begin(), encoded.end()));
 }
 
 TEST(unknown_signature, equality)
 {
+    std::array<uint8_t, 2> data{ 0x01, 0x02 };
+
     ASSERT_EQ(pgp::unknown_signature{}, pgp::unknown_signature{});
     ASSERT_FALSE(pgp::unknown_signature{} != pgp::unknown_signature{});
+    ASSERT_NE(pgp::unknown_signature{}, pgp::unknown_signature{data});
 }
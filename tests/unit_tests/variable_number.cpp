@@ -32,3 +32,30 @@ TEST(variable_number, assignment)
 		ASSERT_EQ(varnum, n);
 	}
 }
+
+TEST(variable_number, partial)
+{
+    for (uint32_t exponent = 0; exponent <= 30; exponent++) {
+        auto varnum = pgp::variable_number::partial(1U << exponent);
+        ASSERT_TRUE(varnum.is_partial());
+        ASSERT_EQ(varnum.size(), 1);
+
+        std::vector<uint8_t> data(1);
+        pgp::range_encoder encoder{data};
+        varnum.encode(encoder);
+        ASSERT_EQ(data[0], 224 + exponent);
+
+        pgp::decoder decoder{data};
+        pgp::variable_number result{decoder};
+        ASSERT_TRUE(result.is_partial());
+        ASSERT_EQ(result, 1U << exponent);
+
+        // assigning a value makes it a regular length again
+        result = 5;
+        ASSERT_FALSE(result.is_partial());
+    }
+
+    ASSERT_THROW(pgp::variable_number::partial(0), std::range_error);
+    ASSERT_THROW(pgp::variable_number::partial(3), std::range_error);
+    ASSERT_THROW(pgp::variable_number::partial(1U << 31), std::range_error);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "vector_encoder.h"
+#include "range_encoder.h"
+#include "packet.h"
+#include "util/vector.h"
+#include "../generate.h"
+
+
+TEST(vector_encoder, bits_and_numbers)
+{
+    std::vector<uint8_t> data{ 0xff };
+    pgp::vector_encoder encoder{ data };
+
+    encoder.insert_bits(1, 1);
+    encoder.insert_bits(3, 0);
+    ASSERT_EQ(encoder.size(), 0);
+    encoder.push(uint8_t{ 0x0a });
+    encoder.push(uint16_t{ 0x1234 });
+    encoder.insert_blob(pgp::span<const uint8_t>{ std::array<uint8_t, 3>{ 1, 2, 3 } });
+    encoder.insert_bits(2, 3);
+    encoder.flush();
+
+    ASSERT_EQ(encoder.size(), 7);
+    ASSERT_EQ(data, (std::vector<uint8_t>{ 0xff, 0x8a, 0x12, 0x34, 1, 2, 3, 0xc0 }));
+
+    // a failed push leaves the vector untouched
+    encoder.insert_bits(4, 0xf);
+    std::array<uint8_t, 2> values{ 0xff, 0x01 };
+    ASSERT_THROW(encoder.push(values.begin(), values.end()), std::range_error);
+    ASSERT_EQ(encoder.size(), 7);
+    ASSERT_THROW(encoder.insert_bits(5, 0), std::out_of_range);
+}
+
+TEST(vector_encoder, packets)
+{
+    using namespace std::literals;
+
+    auto [key, public_data, secret_data] = tests::generate::eddsa::key();
+    pgp::user_id user{ "Anne Onymous <anonymous@example.org>"s };
+
+    std::vector<pgp::packet> packets;
+    packets.emplace_back(pgp::in_place_type_t<pgp::secret_key>{}, key);
+    packets.emplace_back(pgp::in_place_type_t<pgp::user_id>{}, user);
+    packets.emplace_back(pgp::in_place_type_t<pgp::signature>{}, key, user, pgp::signature_subpacket_set{}, pgp::signature_subpacket_set{});
+    packets.emplace_back(pgp::in_place_type_t<pgp::user_id>{}, std::string(70000, 'a'));
+
+    // encode the packets without knowing the size up front
+    pgp::vector<uint8_t> data;
+    pgp::vector_encoder encoder{ data };
+    for (auto &packet : packets) {
+        packet.encode(encoder);
+    }
+
+    // it should match the data encoded in a pre-sized range
+    size_t size = 0;
+    for (auto &packet : packets) {
+        size += packet.size();
+    }
+
+    std::vector<uint8_t> expected(size);
+    pgp::range_encoder range{ expected };
+    for (auto &packet : packets) {
+        packet.encode(range);
+    }
+
+    ASSERT_EQ(encoder.size(), size);
+    ASSERT_TRUE(std::equal(data.begin(), data.end(), expected.begin(), expected.end()));
+}
@@ -0,0 +1,316 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include "public_key.h"
+#include "thread_pool.h"
+#include "verify.h"
+#include "../failing_executor.h"
+#include "../generate.h"
+
+
+namespace {
+
+    pgp::signature_subpacket_set subpackets()
+    {
+        return pgp::signature_subpacket_set{{
+            pgp::signature_subpacket::signature_creation_time{ 1554106568 },
+            pgp::signature_subpacket::key_flags{ 0x03 }
+        }};
+    }
+
+    void certification_test(const pgp::secret_key &key)
+    {
+        using namespace std::literals;
+
+        pgp::user_id user{ "Alice <alice@example.com>"s };
+        pgp::user_id other{ "Mallory <mallory@example.com>"s };
+        pgp::signature sig{ key, user, subpackets(), {} };
+
+        // the signature certifies the user id, and nothing else
+        ASSERT_TRUE(pgp::verify(sig, key, pgp::user_id_certification{ key, user }));
+        ASSERT_FALSE(pgp::verify(sig, key, pgp::user_id_certification{ key, other }));
+    }
+
+    void binding_test(const pgp::secret_key &primary, const pgp::secret_subkey &subkey)
+    {
+        pgp::signature subkey_binding{ primary, subkey, subpackets(), {} };
+        pgp::signature primary_binding{ subkey, primary, subpackets(), {} };
+
+        // both are made over the same data, but by a different key
+        ASSERT_TRUE(pgp::verify(subkey_binding, primary, pgp::key_binding{ primary, subkey }));
+        ASSERT_TRUE(pgp::verify(primary_binding, subkey, pgp::key_binding{ primary, subkey }));
+
+        // the keys must be hashed in the right order
+        ASSERT_FALSE(pgp::verify(subkey_binding, primary, pgp::key_binding{ subkey, primary }));
+
+        // a binding is not a certification
+        pgp::user_id user{ std::string{ "Alice <alice@example.com>" } };
+        ASSERT_FALSE(pgp::verify(subkey_binding, primary, pgp::user_id_certification{ primary, user }));
+    }
+
+    // signed data that fails to hash, for a reason other than an unsupported algorithm
+    struct failing_context
+    {
+        static constexpr bool accepts(pgp::signature_type) noexcept { return true; }
+
+        template <class encoder_t>
+        void hash(encoder_t &) const { throw std::range_error{ "Signed data cannot be hashed" }; }
+    };
+}
+
+TEST(verify, certification)
+{
+    certification_test(tests::generate::eddsa_key());
+    certification_test(tests::generate::ecdsa_key());
+    certification_test(tests::generate::rsa_key());
+}
+
+TEST(verify, key_binding)
+{
+    binding_test(tests::generate::eddsa_key(), tests::generate::ecdsa_key<pgp::secret_subkey>());
+    binding_test(tests::generate::ecdsa_key(), tests::generate::rsa_key<pgp::secret_subkey>());
+    binding_test(tests::generate::rsa_key(), tests::generate::eddsa_key<pgp::secret_subkey>());
+}
+
+TEST(verify, public_key)
+{
+    using namespace std::literals;
+
+    // sign with the secret key
+    auto secret = tests::generate::rsa_key();
+    pgp::user_id user{ "Alice <alice@example.com>"s };
+    pgp::signature sig{ secret, user, subpackets(), {} };
+
+    // construct the public key from the same parameters
+    const auto &rsa = pgp::get<pgp::secret_key::rsa_key_t>(secret.key());
+    pgp::public_key key{
+        secret.creation_time(),
+        secret.algorithm(),
+        pgp::in_place_type_t<pgp::public_key::rsa_key_t>(),
+        rsa.n(), rsa.e()
+    };
+
+    // the signature also verifies with just the public key
+    ASSERT_TRUE(pgp::verify(sig, key, pgp::user_id_certification{ key, user }));
+}
+
+TEST(verify, wrong_key)
+{
+    using namespace std::literals;
+
+    auto key = tests::generate::eddsa_key();
+    auto other = tests::generate::eddsa_key();
+    pgp::user_id user{ "Alice <alice@example.com>"s };
+    pgp::signature sig{ key, user, subpackets(), {} };
+
+    // the hash matches, but the signature was made by a different key
+    ASSERT_FALSE(pgp::verify(sig, other, pgp::user_id_certification{ key, user }));
+
+    // a key of a different algorithm is rejected outright
+    auto rsa = tests::generate::rsa_key();
+    ASSERT_FALSE(pgp::verify(sig, rsa, pgp::user_id_certification{ key, user }));
+}
+
+TEST(verify, hash_prefix)
+{
+    using namespace std::literals;
+
+    auto key = tests::generate::ecdsa_key();
+    pgp::user_id user{ "Alice <alice@example.com>"s };
+    pgp::signature sig{ key, user, subpackets(), {} };
+
+    // copy the signature with a damaged hash prefix
+    pgp::signature damaged{
+        sig.type(),
+        sig.public_key_algorithm(),
+        sig.hashing_algorithm(),
+        sig.hashed_subpackets(),
+        sig.unhashed_subpackets(),
+        static_cast<uint16_t>(sig.hash_prefix() ^ 0x0101),
+        pgp::in_place_type_t<pgp::ecdsa_signature>(),
+        pgp::get<pgp::ecdsa_signature>(sig.data())
+    };
+
+    // the signature itself is still fine, but the prefix is not
+    ASSERT_TRUE(pgp::verify(sig, key, pgp::user_id_certification{ key, user }));
+    ASSERT_FALSE(pgp::verify(damaged, key, pgp::user_id_certification{ key, user }));
+}
+
+TEST(verify, unsupported)
+{
+    using namespace std::literals;
+
+    auto key = tests::generate::ecdsa_key();
+    pgp::user_id user{ "Alice <alice@example.com>"s };
+    pgp::signature sig{ key, user, subpackets(), {} };
+
+    // the same signature, claiming to use an unsupported hash
+    pgp::signature md5{
+        sig.type(),
+        sig.public_key_algorithm(),
+        pgp::hash_algorithm::md5,
+        sig.hashed_subpackets(),
+        sig.unhashed_subpackets(),
+        sig.hash_prefix(),
+        pgp::in_place_type_t<pgp::ecdsa_signature>(),
+        pgp::get<pgp::ecdsa_signature>(sig.data())
+    };
+
+    ASSERT_THROW(pgp::verify(md5, key, pgp::user_id_certification{ key, user }), pgp::unsupported_algorithm);
+}
+
+TEST(verify, batch)
+{
+    using namespace std::literals;
+
+    pgp::thread_pool pool{ 4 };
+
+    // a few keys, with a number of user ids each
+    std::vector<pgp::secret_key> keys;
+    keys.push_back(tests::generate::eddsa_key());
+    keys.push_back(tests::generate::ecdsa_key());
+    keys.push_back(tests::generate::rsa_key());
+
+    std::vector<pgp::user_id> users;
+    for (size_t i = 0; i < 10; ++i) {
+        users.emplace_back("User " + std::to_string(i) + " <user@example.com>");
+    }
+
+    // every key certifies every user id
+    std::vector<pgp::signature> signatures;
+    for (auto &key : keys) {
+        for (auto &user : users) {
+            signatures.emplace_back(key, user, subpackets(), pgp::signature_subpacket_set{});
+        }
+    }
+
+    // verify the signatures in an interleaved order, using the wrong
+    // user id for every third signature
+    using job_t = pgp::verification_job<pgp::secret_key_traits<pgp::packet_tag::secret_key>, pgp::user_id_certification<pgp::secret_key_traits<pgp::packet_tag::secret_key>>>;
+    std::vector<job_t> jobs;
+    std::vector<pgp::verification_result> expected;
+    for (size_t i = 0; i < users.size(); ++i) {
+        for (size_t k = 0; k < keys.size(); ++k) {
+            // take a different user id every now and then
+            bool valid = jobs.size() % 3 != 0;
+            auto &user = valid ? users[i] : users[(i + 1) % users.size()];
+
+            jobs.push_back(job_t{ signatures[k * users.size() + i], keys[k], pgp::user_id_certification{ keys[k], user } });
+            expected.push_back(valid ? pgp::verification_result::valid : pgp::verification_result::invalid);
+        }
+    }
+
+    // the results come back in order, also when split in many batches
+    ASSERT_EQ(pgp::verify_batch(jobs, pool), expected);
+    ASSERT_EQ(pgp::verify_batch(jobs, pool, 3), expected);
+
+    // and they are the same as verifying them one by one
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        ASSERT_EQ(pgp::verify(jobs[i].sig, jobs[i].signer, jobs[i].context), expected[i] == pgp::verification_result::valid);
+    }
+
+    // an empty batch is fine too
+    ASSERT_TRUE(pgp::verify_batch(std::vector<job_t>{}, pool).empty());
+}
+
+TEST(verify, batch_unsupported)
+{
+    using namespace std::literals;
+
+    pgp::thread_pool pool{ 2 };
+
+    auto key = tests::generate::ecdsa_key();
+    pgp::user_id user{ "Alice <alice@example.com>"s };
+    pgp::signature sig{ key, user, subpackets(), {} };
+
+    // the same signature, claiming to use an unsupported hash
+    pgp::signature md5{
+        sig.type(),
+        sig.public_key_algorithm(),
+        pgp::hash_algorithm::md5,
+        sig.hashed_subpackets(),
+        sig.unhashed_subpackets(),
+        sig.hash_prefix(),
+        pgp::in_place_type_t<pgp::ecdsa_signature>(),
+        pgp::get<pgp::ecdsa_signature>(sig.data())
+    };
+
+    // a key type we cannot verify signatures for at all
+    pgp::secret_key dsa{
+        1554106568,
+        pgp::key_algorithm::dsa,
+        pgp::in_place_type_t<pgp::secret_key::dsa_key_t>(),
+        std::make_tuple(
+            pgp::multiprecision_integer{ std::array<uint8_t, 3>{ 1, 2, 3 } },
+            pgp::multiprecision_integer{ std::array<uint8_t, 3>{ 4, 5, 6 } },
+            pgp::multiprecision_integer{ std::array<uint8_t, 3>{ 7, 8, 9 } },
+            pgp::multiprecision_integer{ std::array<uint8_t, 3>{ 1, 2, 3 } }
+        ),
+        std::make_tuple(pgp::secret_multiprecision_integer{ std::array<uint8_t, 3>{ 4, 5, 6 } })
+    };
+    pgp::signature dsa_sig{
+        sig.type(),
+        pgp::key_algorithm::dsa,
+        pgp::hash_algorithm::sha256,
+        sig.hashed_subpackets(),
+        sig.unhashed_subpackets(),
+        sig.hash_prefix(),
+        pgp::in_place_type_t<pgp::dsa_signature>(),
+        pgp::multiprecision_integer{ std::array<uint8_t, 3>{ 1, 2, 3 } },
+        pgp::multiprecision_integer{ std::array<uint8_t, 3>{ 4, 5, 6 } }
+    };
+
+    // only the jobs we cannot verify are reported as such
+    std::vector jobs{
+        pgp::verification_job{ sig, key, pgp::user_id_certification{ key, user } },
+        pgp::verification_job{ md5, key, pgp::user_id_certification{ key, user } },
+        pgp::verification_job{ dsa_sig, dsa, pgp::user_id_certification{ dsa, user } },
+        pgp::verification_job{ sig, key, pgp::user_id_certification{ key, user } }
+    };
+    std::vector<pgp::verification_result> expected{
+        pgp::verification_result::valid,
+        pgp::verification_result::unsupported,
+        pgp::verification_result::unsupported,
+        pgp::verification_result::valid
+    };
+    ASSERT_EQ(pgp::verify_batch(jobs, pool, 1), expected);
+    ASSERT_EQ(pgp::verify_batch(jobs, pool), expected);
+}
+
+TEST(verify, batch_executor_error)
+{
+    using namespace std::literals;
+
+    auto key = tests::generate::eddsa_key();
+    pgp::user_id user{ "Alice <alice@example.com>"s };
+    pgp::signature sig{ key, user, subpackets(), {} };
+
+    // the executor fails after accepting a few batches
+    std::vector jobs(5, pgp::verification_job{ sig, key, pgp::user_id_certification{ key, user } });
+    tests::failing_executor executor{ 2 };
+    ASSERT_THROW(pgp::verify_batch(jobs, executor, 1), std::runtime_error);
+
+    // the accepted batches were run before the error was raised
+    ASSERT_EQ(executor.accepted, 2);
+    ASSERT_EQ(executor.started, 2);
+}
+
+TEST(verify, batch_error)
+{
+    using namespace std::literals;
+
+    pgp::thread_pool pool{ 2 };
+    auto key = tests::generate::eddsa_key();
+    pgp::user_id user{ "Alice <alice@example.com>"s };
+    pgp::signature sig{ key, user, subpackets(), {} };
+
+    // an error that is not about an unsupported algorithm is raised, not reported as unsupported
+    std::vector jobs(3, pgp::verification_job{ sig, key, failing_context{} });
+    ASSERT_THROW(pgp::verify_batch(jobs, pool), std::range_error);
+}
+
+TEST(verify, result)
+{
+    // a result that was never set does not pass
+    ASSERT_EQ(pgp::verification_result{}, pgp::verification_result::invalid);
+    ASSERT_EQ(pgp::verification_result_description(pgp::verification_result{}), "invalid");
+}